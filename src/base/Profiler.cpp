@@ -1,7 +1,9 @@
 #include "Profiler.h"
 #include "Platform.h"
+#include "network/Socket.h"
 
 #include <fstream>
+#include <iomanip>
 #include <mutex>
 #include <sstream>
 #include <thread>
@@ -14,6 +16,17 @@ using TIME_RESOLUTION = nanoseconds;
 
 namespace PR {
 namespace Profiler {
+constexpr size_t MAX_TIMELINE_HISTORY		   = 1 << 20; // Maximum amount of timeline events kept per thread for the export
+constexpr milliseconds TIMELINE_DRAIN_INTERVAL = milliseconds(5);
+
+TimelineBuffer::TimelineBuffer()
+	: mHead(0)
+	, mTail(0)
+	, mDropped(0)
+	, mEvents(std::make_unique<TimelineEvent[]>(CAPACITY))
+{
+}
+
 struct CounterEntry {
 	Profiler::InternalCounter* CounterPtr;
 	const EntryDescription* Desc;
@@ -43,19 +56,28 @@ struct TimeCounterEntry {
 struct SignalEntry {
 	std::string Name;
 	high_resolution_clock::time_point TimePoint;
+	uint64 Ticks;
 };
 
 struct ThreadData {
 	uint32 ID;
 	std::string Name;
+	bool NameStreamed;
 	std::vector<CounterEntry> CounterEntries;
 	std::vector<TimeCounterEntry> TimeCounterEntries;
 	std::vector<SignalEntry> SignalEntries;
 	std::vector<std::shared_ptr<Profiler::InternalCounter>> InternalCounters;
 
+	std::unique_ptr<TimelineBuffer> Timeline;
+	std::vector<TimelineEvent> TimelineHistory; // Drained events, only accessed with sThreadMutex locked
+	uint64 TimelineHistoryDropped;
+
 	inline explicit ThreadData(uint32 id, const std::string& name)
 		: ID(id)
 		, Name(name)
+		, NameStreamed(false)
+		, Timeline(std::make_unique<TimelineBuffer>())
+		, TimelineHistoryDropped(0)
 	{
 	}
 };
@@ -89,10 +111,22 @@ void saveDescription(const ThreadData* data, const EntryDescription* desc)
 	}
 }
 
+// Timeline events refer to the description by index, as description pointers might be reused by other threads
+static std::vector<EntryDescription> sTimelineDescriptions;
+uint32 saveTimelineDescription(const ThreadData* data, const EntryDescription* desc)
+{
+	EntryDescription copy = *desc;
+	copy.ThreadID		  = data->ID;
+	sTimelineDescriptions.emplace_back(copy);
+	return static_cast<uint32>(sTimelineDescriptions.size() - 1);
+}
+
 void setThreadName(const std::string& name)
 {
 	std::lock_guard<std::mutex> guard(sThreadMutex);
-	getCurrentThreadData()->Name = name;
+	ThreadData* data   = getCurrentThreadData();
+	data->Name		   = name;
+	data->NameStreamed = false;
 }
 
 void emitSignal(const std::string& name)
@@ -100,6 +134,7 @@ void emitSignal(const std::string& name)
 	SignalEntry entry;
 	entry.Name		= name;
 	entry.TimePoint = high_resolution_clock::now();
+	entry.Ticks		= ticks();
 
 	std::lock_guard<std::mutex> guard(sThreadMutex);
 	getCurrentThreadData()->SignalEntries.emplace_back(entry);
@@ -135,9 +170,164 @@ InternalTimeCounter registerTimeCounter(const EntryDescription* desc)
 
 	data->TimeCounterEntries.emplace_back(totalCounter.get(), timeSpentCounter.get(), desc);
 
-	return InternalTimeCounter{ totalCounter.get(), timeSpentCounter.get() };
+	return InternalTimeCounter{ totalCounter.get(), timeSpentCounter.get(), data->Timeline.get(), saveTimelineDescription(data, desc) };
+}
+
+/////////////////////////////////// Ticks
+static uint64 sStartTicks = 0;
+static steady_clock::time_point sStartClock;
+static double sNanosecondsPerTick = 1;
+
+// Estimate the tick rate by comparing with the steady clock
+static void calibrateTicks()
+{
+	const uint64 endTicks = ticks();
+	const auto endClock	  = steady_clock::now();
+	if (endTicks > sStartTicks)
+		sNanosecondsPerTick = duration_cast<nanoseconds>(endClock - sStartClock).count() / (double)(endTicks - sStartTicks);
+}
+
+inline static uint64 ticksToNS(uint64 t) { return static_cast<uint64>(t * sNanosecondsPerTick); }
+// Relative to the start of the profiler. Events might have been recorded before
+inline static double ticksToUSSinceStart(uint64 t) { return static_cast<int64>(t - sStartTicks) * sNanosecondsPerTick / 1000.0; }
+
+/////////////////////////////////// Timeline
+static void writeEscapedJSON(std::ostream& stream, const std::string& str)
+{
+	for (char c : str) {
+		if (c == '"' || c == '\\')
+			stream << '\\' << c;
+		else if (static_cast<unsigned char>(c) >= 0x20)
+			stream << c;
+	}
+}
+
+static void writeTraceEvent(std::ostream& stream, uint32 threadID, const TimelineEvent& event)
+{
+	const EntryDescription& desc = sTimelineDescriptions[event.DescID];
+
+	stream << "{\"name\":\"";
+	writeEscapedJSON(stream, desc.Name.empty() ? desc.Function : desc.Name);
+	stream << "\",\"cat\":\"";
+	writeEscapedJSON(stream, desc.Category.empty() ? "default" : desc.Category);
+	stream << "\",\"ph\":\"X\",\"ts\":" << ticksToUSSinceStart(event.Start)
+		   << ",\"dur\":" << ticksToNS(event.End - event.Start) / 1000.0
+		   << ",\"pid\":0,\"tid\":" << threadID << "}";
+}
+
+static void writeTraceThreadName(std::ostream& stream, const ThreadData& data)
+{
+	stream << "{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":0,\"tid\":" << data.ID << ",\"args\":{\"name\":\"";
+	writeEscapedJSON(stream, data.Name);
+	stream << "\"}}";
+}
+
+static void writeTraceSignal(std::ostream& stream, const ThreadData& data, const SignalEntry& entry)
+{
+	stream << "{\"name\":\"";
+	writeEscapedJSON(stream, entry.Name);
+	stream << "\",\"ph\":\"i\",\"s\":\"g\",\"ts\":" << ticksToUSSinceStart(entry.Ticks)
+		   << ",\"pid\":0,\"tid\":" << data.ID << "}";
+}
+
+// Has to be called with sThreadMutex locked, as the thread mutex guarantees a single consumer for each buffer
+// Newly drained events are written to the given stream if available
+static void drainTimelines(std::ostream* stream)
+{
+	for (ThreadData& data : sThreadData) {
+		if (stream && !data.NameStreamed) {
+			writeTraceThreadName(*stream, data);
+			*stream << std::endl;
+			data.NameStreamed = true;
+		}
+
+		data.Timeline->drain([&](const TimelineEvent& event) {
+			if (data.TimelineHistory.size() < MAX_TIMELINE_HISTORY)
+				data.TimelineHistory.push_back(event);
+			else
+				++data.TimelineHistoryDropped;
+
+			if (stream) {
+				writeTraceEvent(*stream, data.ID, event);
+				*stream << std::endl;
+			}
+		});
+	}
 }
 
+// Streams newline separated chrome trace events to all connected clients.
+// Data is only sent in small chunks if the client is ready, such that slow clients never block the profiler
+class TimelineStreamer {
+public:
+	inline bool open(uint16 port)
+	{
+		return mServer.bindAndListen(port);
+	}
+
+	// Has to be called with sThreadMutex locked
+	void acceptClients()
+	{
+		while (mServer.hasIncomingConnection(0)) {
+			Socket socket = mServer.accept();
+			if (!socket.isValid() || !socket.isOpen())
+				continue;
+
+			// New clients need all thread names
+			std::stringstream stream;
+			stream << std::fixed << std::setprecision(3);
+			for (const ThreadData& data : sThreadData) {
+				writeTraceThreadName(stream, data);
+				stream << std::endl;
+			}
+
+			mClients.push_back(Client{ std::move(socket), stream.str(), 0 });
+		}
+	}
+
+	void send(const std::string& str)
+	{
+		for (auto it = mClients.begin(); it != mClients.end();) {
+			// Drop clients which are unable to keep up
+			if (it->Pending.size() - it->Sent + str.size() > MAX_PENDING) {
+				it = mClients.erase(it);
+				continue;
+			}
+			it->Pending += str;
+
+			while (it->Sent < it->Pending.size() && it->Socket.canSend(0)) {
+				const size_t len = std::min(CHUNK_SIZE, it->Pending.size() - it->Sent);
+				if (!it->Socket.send(it->Pending.c_str() + it->Sent, len))
+					break;
+				it->Sent += len;
+			}
+
+			if (!it->Socket.isOpen()) {
+				it = mClients.erase(it);
+				continue;
+			}
+
+			if (it->Sent == it->Pending.size()) {
+				it->Pending.clear();
+				it->Sent = 0;
+			}
+			++it;
+		}
+	}
+
+private:
+	static constexpr size_t CHUNK_SIZE	= 4096;
+	static constexpr size_t MAX_PENDING = 64 * 1024 * 1024;
+
+	struct Client {
+		::PR::Socket Socket;
+		std::string Pending;
+		size_t Sent;
+	};
+
+	Socket mServer;
+	std::vector<Client> mClients;
+};
+
 struct ProfileCounterSample {
 	const EntryDescription* Desc;
 	uint64 Value;
@@ -159,10 +349,14 @@ static std::vector<std::unique_ptr<ProfileSamplePage>> sProfilePages;
 static std::atomic<bool> sProfileRun(false);
 static std::mutex sProfileMutex;
 static high_resolution_clock::time_point sProfileStartTime;
-static void profileThread(uint32 samplesPerSecond)
+static void profileThread(uint32 samplesPerSecond, int32 networkPort)
 {
-	sProfileRun		  = true;
-	sProfileStartTime = high_resolution_clock::now();
+	std::unique_ptr<TimelineStreamer> streamer;
+	if (networkPort >= 0) {
+		streamer = std::make_unique<TimelineStreamer>();
+		if (!streamer->open(static_cast<uint16>(networkPort)))
+			streamer.reset();
+	}
 
 	ProfileSamplePage* lastPage = nullptr;
 	const auto ms				= milliseconds(1000 / samplesPerSecond);
@@ -189,7 +383,7 @@ static void profileThread(uint32 samplesPerSecond)
 			for (const TimeCounterEntry& entry : data.TimeCounterEntries) {
 				ProfileTimeCounterSample sample;
 				sample.ValueTotal	 = *entry.TotalCounterPtr;
-				sample.ValueDuration = *entry.TimeSpentCounterPtr;
+				sample.ValueDuration = ticksToNS(*entry.TimeSpentCounterPtr);
 				sample.Desc			 = entry.Desc;
 				page->TimeCounters.push_back(sample);
 			}
@@ -202,27 +396,57 @@ static void profileThread(uint32 samplesPerSecond)
 		sProfileMutex.unlock();
 	};
 
+	// Move the timeline events out of the ring buffers, such that threads do not drop events
+	auto drain = [&]() {
+		if (!streamer) {
+			std::lock_guard<std::mutex> guard(sThreadMutex);
+			drainTimelines(nullptr);
+			return;
+		}
+
+		std::stringstream stream;
+		stream << std::fixed << std::setprecision(3);
+		sThreadMutex.lock();
+		streamer->acceptClients();
+		drainTimelines(&stream);
+		sThreadMutex.unlock();
+
+		streamer->send(stream.str());
+	};
+
 	while (sProfileRun) {
+		// Drain more often than sampling, as the ring buffers are small
+		std::this_thread::sleep_for(std::min<milliseconds>(ms, TIMELINE_DRAIN_INTERVAL));
+		drain();
+
 		auto now  = high_resolution_clock::now();
 		auto diff = now - start;
-
-		if (duration_cast<milliseconds>(diff) < ms) {
-			std::this_thread::sleep_for(ms);
+		if (duration_cast<milliseconds>(diff) < ms)
 			continue;
-		}
 
 		start = now;
 		generatePage(now);
 	}
 
+	drain();
 	generatePage(high_resolution_clock::now());
 }
 
 static std::unique_ptr<std::thread> sProfileThread;
-void start(uint32 samplesPerSecond, int32 /*networkPort*/)
+void start(uint32 samplesPerSecond, int32 networkPort)
 {
 	setThreadName("Main");
-	sProfileThread = std::make_unique<std::thread>(profileThread, samplesPerSecond);
+
+	sProfileStartTime = high_resolution_clock::now();
+	sStartClock		  = steady_clock::now();
+	sStartTicks		  = ticks();
+
+	// Coarse estimate of the tick rate, refined when stopping
+	std::this_thread::sleep_for(milliseconds(10));
+	calibrateTicks();
+
+	sProfileRun	   = true;
+	sProfileThread = std::make_unique<std::thread>(profileThread, samplesPerSecond, networkPort);
 }
 
 void stop()
@@ -231,6 +455,8 @@ void stop()
 	if (sProfileThread->joinable())
 		sProfileThread->join();
 	sProfileThread.reset();
+
+	calibrateTicks();
 }
 
 /////////////////////////////////// IO
@@ -473,5 +699,49 @@ bool dumpToJSON(const std::filesystem::path& filename)
 	return true;
 }
 
+//////////////////////////////////// Chrome Trace IO
+bool dumpToChromeTrace(const std::filesystem::path& filename)
+{
+	std::lock_guard<std::mutex> guard(sThreadMutex);
+	drainTimelines(nullptr);
+
+	std::ofstream stream(filename.c_str(), std::ios::out);
+	if (!stream)
+		return false;
+
+	stream << std::fixed << std::setprecision(3);
+	stream << "{\"displayTimeUnit\":\"ns\"," << std::endl;
+
+	uint64 dropped = 0;
+	for (const ThreadData& data : sThreadData)
+		dropped += data.Timeline->droppedCount() + data.TimelineHistoryDropped;
+	stream << "\"otherData\":{\"dropped_events\":" << dropped << "}," << std::endl;
+
+	stream << "\"traceEvents\":[" << std::endl;
+	bool first = true;
+	const auto separate = [&]() {
+		if (!first)
+			stream << "," << std::endl;
+		first = false;
+	};
+
+	for (const ThreadData& data : sThreadData) {
+		separate();
+		writeTraceThreadName(stream, data);
+
+		for (const SignalEntry& entry : data.SignalEntries) {
+			separate();
+			writeTraceSignal(stream, data, entry);
+		}
+
+		for (const TimelineEvent& event : data.TimelineHistory) {
+			separate();
+			writeTraceEvent(stream, data.ID, event);
+		}
+	}
+	stream << "]}" << std::endl;
+
+	return true;
+}
 } // namespace Profiler
-} // namespace PR
+} // namespace PR
\ No newline at end of file
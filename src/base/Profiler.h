@@ -6,6 +6,14 @@
 #include <chrono>
 #include <filesystem>
 
+#if defined(PR_USE_HW_FEATURE_SSE2)
+#if defined(PR_CC_MSC)
+#include <intrin.h>
+#else
+#include <x86intrin.h>
+#endif
+#endif
+
 namespace PR {
 namespace Profiler {
 // Structs
@@ -31,9 +39,75 @@ struct PR_LIB_BASE EntryDescription {
 };
 typedef std::atomic<uint64> InternalCounter;
 
+// Cheap timestamp used for all time measurements. Based on the time stamp counter of the cpu if available.
+// Ticks are converted to nanoseconds on export only
+inline uint64 ticks()
+{
+#if defined(PR_USE_HW_FEATURE_SSE2)
+	return __rdtsc();
+#else
+	return (uint64)std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch()).count();
+#endif
+}
+
+// Only the owning thread modifies its counters, therefore no atomic read-modify-write is necessary
+inline void addToCounter(InternalCounter& counter, uint64 value)
+{
+	counter.store(counter.load(std::memory_order_relaxed) + value, std::memory_order_relaxed);
+}
+
+struct PR_LIB_BASE TimelineEvent {
+	uint32 DescID;
+	uint64 Start; // In ticks
+	uint64 End;	  // In ticks
+};
+
+/// Lock free single producer, single consumer ring buffer of the scopes finished by a thread.
+/// The owning thread pushes, the profiler thread drains. Events are dropped if the buffer is full
+class PR_LIB_BASE TimelineBuffer {
+public:
+	static constexpr uint64 CAPACITY = 1 << 15; // Has to be a power of two
+
+	TimelineBuffer();
+
+	inline void push(uint32 descID, uint64 start, uint64 end)
+	{
+		const uint64 head = mHead.load(std::memory_order_relaxed);
+		if (head - mTail.load(std::memory_order_acquire) >= CAPACITY) {
+			addToCounter(mDropped, 1);
+			return;
+		}
+
+		mEvents[head & (CAPACITY - 1)] = TimelineEvent{ descID, start, end };
+		mHead.store(head + 1, std::memory_order_release);
+	}
+
+	/// Consumer side only
+	template <typename Func>
+	inline size_t drain(Func func)
+	{
+		const uint64 tail = mTail.load(std::memory_order_relaxed);
+		const uint64 head = mHead.load(std::memory_order_acquire);
+		for (uint64 i = tail; i < head; ++i)
+			func(mEvents[i & (CAPACITY - 1)]);
+		mTail.store(head, std::memory_order_release);
+		return head - tail;
+	}
+
+	inline uint64 droppedCount() const { return mDropped.load(std::memory_order_relaxed); }
+
+private:
+	alignas(64) std::atomic<uint64> mHead;
+	alignas(64) std::atomic<uint64> mTail;
+	std::atomic<uint64> mDropped;
+	std::unique_ptr<TimelineEvent[]> mEvents;
+};
+
 struct PR_LIB_BASE InternalTimeCounter {
 	InternalCounter* Total;
-	InternalCounter* TimeSpentNS;
+	InternalCounter* TimeSpentTicks;
+	TimelineBuffer* Timeline; // Buffer of the registering thread
+	uint32 DescID;
 };
 
 // Internal interface
@@ -43,31 +117,35 @@ void PR_LIB_BASE emitSignal(const std::string& name);
 PR_LIB_BASE InternalCounter* registerCounter(const EntryDescription* desc);
 PR_LIB_BASE InternalTimeCounter registerTimeCounter(const EntryDescription* desc);
 
+// Timeline events are streamed as newline separated chrome trace events to all clients connected to the given port. Negative disables streaming
 void PR_LIB_BASE start(uint32 samplesPerSecond, int32 networkPort = -1);
 void PR_LIB_BASE stop();
 
 bool PR_LIB_BASE dumpToFile(const std::filesystem::path& filename);
 bool PR_LIB_BASE dumpToJSON(const std::filesystem::path& filename);
+// Timeline of all recorded scopes in the chrome trace event format, viewable with chrome://tracing or https://ui.perfetto.dev
+bool PR_LIB_BASE dumpToChromeTrace(const std::filesystem::path& filename);
 
 // Event structure
 class PR_LIB_BASE EventScope {
 public:
 	inline explicit EventScope(InternalTimeCounter& counter)
 		: mCounter(counter)
-		, mStart(std::chrono::high_resolution_clock::now())
+		, mStart(ticks())
 	{
 	}
 
 	inline ~EventScope()
 	{
-		const auto dur = std::chrono::high_resolution_clock::now() - mStart;
-		++(*mCounter.Total);
-		*mCounter.TimeSpentNS += (uint64)std::chrono::duration_cast<std::chrono::nanoseconds>(dur).count();
+		const uint64 end = ticks();
+		addToCounter(*mCounter.Total, 1);
+		addToCounter(*mCounter.TimeSpentTicks, end - mStart);
+		mCounter.Timeline->push(mCounter.DescID, mStart, end);
 	}
 
 private:
 	InternalTimeCounter& mCounter;
-	std::chrono::high_resolution_clock::time_point mStart;
+	uint64 mStart;
 };
 
 class PR_LIB_BASE Event {
@@ -51,6 +51,75 @@ using snorm16 = int16;
 inline snorm16 to_snorm16(float f) { return to_snorm<snorm16>(f); }
 inline float from_snorm16(snorm16 s) { return from_snorm<snorm16>(s); }
 
+// IEEE 754 binary16 representation. Rounds to nearest even, overflows to infinity and keeps NaN
+using half = uint16;
+inline half to_half(float f)
+{
+	uint32 bits;
+	std::memcpy(&bits, &f, sizeof(bits));
+
+	const uint32 sign = (bits >> 16) & 0x8000;
+	const uint32 absf = bits & 0x7FFFFFFF;
+
+	if (absf >= 0x7F800000) // Inf or NaN
+		return static_cast<half>(sign | 0x7C00 | (absf > 0x7F800000 ? 0x0200 : 0));
+	if (absf >= 0x477FF000) // Rounds to a value above the largest half
+		return static_cast<half>(sign | 0x7C00);
+	if (absf < 0x33000001) // Rounds to zero
+		return static_cast<half>(sign);
+
+	uint32 exp		= absf >> 23;
+	uint32 mantissa = absf & 0x007FFFFF;
+	uint32 shift;
+	if (exp < 113) { // Subnormal half
+		mantissa |= 0x00800000;
+		shift = 126 - exp;
+		exp	  = 0;
+	} else {
+		shift = 13;
+		exp -= 112;
+	}
+
+	const uint32 rounded = mantissa >> shift;
+	const uint32 rest	 = mantissa & ((1u << shift) - 1);
+	const uint32 halfway = 1u << (shift - 1);
+
+	// The mantissa carry propagates into the exponent on purpose
+	uint32 result = (exp << 10) + rounded;
+	if (rest > halfway || (rest == halfway && (rounded & 1)))
+		++result;
+
+	return static_cast<half>(sign | result);
+}
+
+inline float from_half(half h)
+{
+	const uint32 sign	  = static_cast<uint32>(h & 0x8000) << 16;
+	const uint32 exp	  = (h >> 10) & 0x1F;
+	const uint32 mantissa = h & 0x03FF;
+
+	uint32 bits;
+	if (exp == 0x1F) { // Inf or NaN
+		bits = sign | 0x7F800000 | (mantissa << 13);
+	} else if (exp != 0) {
+		bits = sign | ((exp + 112) << 23) | (mantissa << 13);
+	} else if (mantissa != 0) { // Subnormal half, normalized as float
+		uint32 m = mantissa;
+		uint32 e = 113;
+		while (!(m & 0x0400)) {
+			m <<= 1;
+			--e;
+		}
+		bits = sign | (e << 23) | ((m & 0x03FF) << 13);
+	} else {
+		bits = sign;
+	}
+
+	float f;
+	std::memcpy(&f, &bits, sizeof(f));
+	return f;
+}
+
 /* Octahedron Projection method
 * MEYER, Q., SÜSSMUTH, J., SUSSNER, G., STAMMINGER, M., AND GREINER, G. 2010.
 * On floating-point normal vectors.
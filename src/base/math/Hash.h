@@ -18,6 +18,14 @@ inline void hash_combine(size_t& seed, const T& val)
 	seed ^= (std::hash<T>()(val) << 1);
 }
 
+/// Stateless 64bit integer mixer (finalizer of splitmix64)
+inline constexpr uint64 hash_mix(uint64 v)
+{
+	v = (v ^ (v >> 30)) * 0xbf58476d1ce4e5b9ULL;
+	v = (v ^ (v >> 27)) * 0x94d049bb133111ebULL;
+	return v ^ (v >> 31);
+}
+
 template <typename It>
 inline size_t hash_range(It first, It last)
 {
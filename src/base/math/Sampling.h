@@ -50,6 +50,8 @@ inline Vector3f cos_hemi(float u1, float u2)
 	return Vector3f(x, y, cosTheta);
 }
 
+inline Vector3f cos_hemi(const Vector2f& u) { return cos_hemi(u(0), u(1)); }
+
 inline float cos_hemi_pdf(float NdotL)
 {
 	PR_ASSERT(NdotL >= 0, "NdotL must be positive!");
@@ -1,6 +1,9 @@
 #include "Protocol.h"
+#include "math/Compression.h"
 #include "serialization/Serializer.h"
 
+#include <vector>
+
 namespace PR {
 bool Protocol::readHeader(Serializer& in, ProtocolType& type)
 {
@@ -70,4 +73,158 @@ bool Protocol::writeImage(Serializer& in, const ProtocolImage& img, const float*
 	in.writeRaw(reinterpret_cast<const uint8*>(buffer), requiredSize * sizeof(float));
 	return in.isValid();
 }
+
+bool Protocol::readImageUpdateRequest(Serializer& in, ProtocolImageUpdateRequest& request)
+{
+	uint8 encoding;
+	in.read(request.Stamp);
+	in.read(encoding);
+
+	if (encoding >= (uint8)ProtocolImageEncoding::MAX)
+		return false;
+
+	request.Encoding = (ProtocolImageEncoding)encoding;
+	return in.isValid();
+}
+
+bool Protocol::writeImageUpdateRequest(Serializer& in, const ProtocolImageUpdateRequest& request)
+{
+	in.write(request.Stamp);
+	in.write((uint8)request.Encoding);
+	return in.isValid();
+}
+
+bool Protocol::readImageUpdateHeader(Serializer& in, ProtocolImageUpdate& update)
+{
+	uint8 encoding;
+	in.read(update.Width);
+	in.read(update.Height);
+	in.read(encoding);
+	in.read(update.Stamp);
+	in.read(update.TileCount);
+
+	if (encoding >= (uint8)ProtocolImageEncoding::MAX)
+		return false;
+
+	update.Encoding = (ProtocolImageEncoding)encoding;
+	return in.isValid();
+}
+
+bool Protocol::writeImageUpdateHeader(Serializer& in, const ProtocolImageUpdate& update)
+{
+	in.write(update.Width);
+	in.write(update.Height);
+	in.write((uint8)update.Encoding);
+	in.write(update.Stamp);
+	in.write(update.TileCount);
+	return in.isValid();
+}
+
+inline static bool isTileInside(const ProtocolImageUpdate& update, const ProtocolImageTile& tile, size_t bufferSize)
+{
+	return (size_t)update.Width * update.Height * 3 <= bufferSize
+		   && tile.X < update.Width && tile.Y < update.Height
+		   && tile.Width <= update.Width - tile.X && tile.Height <= update.Height - tile.Y;
+}
+
+bool Protocol::readImageTile(Serializer& in, const ProtocolImageUpdate& update, float* buffer, size_t bufferSize)
+{
+	ProtocolImageTile tile;
+	in.read(tile.X);
+	in.read(tile.Y);
+	in.read(tile.Width);
+	in.read(tile.Height);
+
+	if (!in.isValid() || !isTileInside(update, tile, bufferSize))
+		return false;
+
+	const size_t rowSize = (size_t)tile.Width * 3;
+	switch (update.Encoding) {
+	case ProtocolImageEncoding::Float32:
+		for (uint32 y = 0; y < tile.Height; ++y) {
+			float* row = buffer + ((size_t)(tile.Y + y) * update.Width + tile.X) * 3;
+			in.readRaw(reinterpret_cast<uint8*>(row), rowSize * sizeof(float));
+		}
+		break;
+	case ProtocolImageEncoding::Float16: {
+		std::vector<half> data(rowSize);
+		for (uint32 y = 0; y < tile.Height; ++y) {
+			float* row = buffer + ((size_t)(tile.Y + y) * update.Width + tile.X) * 3;
+			in.readRaw(reinterpret_cast<uint8*>(data.data()), rowSize * sizeof(half));
+			for (size_t i = 0; i < rowSize; ++i)
+				row[i] = from_half(data[i]);
+		}
+	} break;
+	case ProtocolImageEncoding::Quantized16: {
+		float scale;
+		in.read(scale);
+
+		std::vector<unorm16> data(rowSize);
+		for (uint32 y = 0; y < tile.Height; ++y) {
+			float* row = buffer + ((size_t)(tile.Y + y) * update.Width + tile.X) * 3;
+			in.readRaw(reinterpret_cast<uint8*>(data.data()), rowSize * sizeof(unorm16));
+			for (size_t i = 0; i < rowSize; ++i)
+				row[i] = from_unorm16(data[i]) * scale;
+		}
+	} break;
+	default:
+		return false;
+	}
+
+	return in.isValid();
+}
+
+bool Protocol::writeImageTile(Serializer& in, const ProtocolImageUpdate& update, const ProtocolImageTile& tile, const float* buffer, size_t bufferSize)
+{
+	if (!isTileInside(update, tile, bufferSize))
+		return false;
+
+	in.write(tile.X);
+	in.write(tile.Y);
+	in.write(tile.Width);
+	in.write(tile.Height);
+
+	const size_t rowSize = (size_t)tile.Width * 3;
+	switch (update.Encoding) {
+	case ProtocolImageEncoding::Float32:
+		for (uint32 y = 0; y < tile.Height; ++y) {
+			const float* row = buffer + ((size_t)(tile.Y + y) * update.Width + tile.X) * 3;
+			in.writeRaw(reinterpret_cast<const uint8*>(row), rowSize * sizeof(float));
+		}
+		break;
+	case ProtocolImageEncoding::Float16: {
+		std::vector<half> data(rowSize);
+		for (uint32 y = 0; y < tile.Height; ++y) {
+			const float* row = buffer + ((size_t)(tile.Y + y) * update.Width + tile.X) * 3;
+			for (size_t i = 0; i < rowSize; ++i)
+				data[i] = to_half(row[i]);
+			in.writeRaw(reinterpret_cast<const uint8*>(data.data()), rowSize * sizeof(half));
+		}
+	} break;
+	case ProtocolImageEncoding::Quantized16: {
+		float scale = 0;
+		for (uint32 y = 0; y < tile.Height; ++y) {
+			const float* row = buffer + ((size_t)(tile.Y + y) * update.Width + tile.X) * 3;
+			for (size_t i = 0; i < rowSize; ++i) {
+				if (std::isfinite(row[i]))
+					scale = std::max(scale, row[i]);
+			}
+		}
+		in.write(scale);
+
+		const float invScale = scale > 0 ? 1 / scale : 0;
+		std::vector<unorm16> data(rowSize);
+		for (uint32 y = 0; y < tile.Height; ++y) {
+			const float* row = buffer + ((size_t)(tile.Y + y) * update.Width + tile.X) * 3;
+			for (size_t i = 0; i < rowSize; ++i)
+				data[i] = std::isfinite(row[i]) ? to_unorm16(row[i] * invScale) : 0;
+			in.writeRaw(reinterpret_cast<const uint8*>(data.data()), rowSize * sizeof(unorm16));
+		}
+	} break;
+	default:
+		return false;
+	}
+
+	return in.isValid();
+}
 } // namespace PR
\ No newline at end of file
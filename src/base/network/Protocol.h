@@ -20,18 +20,41 @@ namespace PR {
  * [uint32] Height
  * [uint32] Format {0-> CIE XYZ, 1-> RGB} (Always triplet)
  * [float*Width*Height*3] Data
+ *
+ * <ImageUpdateRequest>
+ * [uint64] Stamp (Stamp of the last update received or zero. Tiles never changed are zero)
+ * [uint8] Encoding {0-> Float32, 1-> Float16, 2-> Quantized16}
+ *
+ * <ImageUpdate>
+ * [uint32] Width
+ * [uint32] Height
+ * [uint8] Encoding
+ * [uint64] Stamp (Has to be sent with the next request to only get tiles changed since this update)
+ * [uint32] TileCount
+ * TileCount*<ImageTile>
+ *
+ * <ImageTile>
+ * [uint32] X
+ * [uint32] Y
+ * [uint32] Width
+ * [uint32] Height
+ * Float32:     [float*Width*Height*3] Data
+ * Float16:     [half*Width*Height*3] Data
+ * Quantized16: [float] Scale, [unorm16*Width*Height*3] Data/Scale
  */
 
 enum class ProtocolType : uint8 {
-	PingRequest	   = 0x0,  // Dataless
-	PingResponse   = 0x1,  // Dataless
-	InfoRequest	   = 0x2,  // TODO
-	InfoResponse   = 0x3,  // TODO
-	StopRequest	   = 0x4,  // Dataless
-	StatusRequest  = 0x10, // Dataless
-	StatusResponse = 0x11,
-	ImageRequest   = 0x12, // Dataless
-	ImageResponse  = 0x13,
+	PingRequest			= 0x0,  // Dataless
+	PingResponse		= 0x1,  // Dataless
+	InfoRequest			= 0x2,  // TODO
+	InfoResponse		= 0x3,  // TODO
+	StopRequest			= 0x4,  // Dataless
+	StatusRequest		= 0x10, // Dataless
+	StatusResponse		= 0x11,
+	ImageRequest		= 0x12, // Dataless
+	ImageResponse		= 0x13,
+	ImageUpdateRequest	= 0x14,
+	ImageUpdateResponse = 0x15,
 
 	MAX,
 	Invalid = 0xFF
@@ -49,6 +72,34 @@ struct PR_LIB_BASE ProtocolImage {
 	//Float* Ptr!
 };
 
+enum class ProtocolImageEncoding : uint8 {
+	Float32		= 0x0,
+	Float16		= 0x1,
+	Quantized16 = 0x2, // Linear quantization relative to the maximum value of the tile. Negative values are clamped to zero
+
+	MAX
+};
+
+struct PR_LIB_BASE ProtocolImageUpdateRequest {
+	uint64 Stamp;
+	ProtocolImageEncoding Encoding;
+};
+
+struct PR_LIB_BASE ProtocolImageUpdate {
+	uint32 Width;
+	uint32 Height;
+	ProtocolImageEncoding Encoding;
+	uint64 Stamp;
+	uint32 TileCount;
+};
+
+struct PR_LIB_BASE ProtocolImageTile {
+	uint32 X;
+	uint32 Y;
+	uint32 Width;
+	uint32 Height;
+};
+
 class Serializer;
 class PR_LIB_BASE Protocol {
 public:
@@ -62,5 +113,14 @@ public:
 	static bool readImageHeader(Serializer& in, ProtocolImage& img);
 	static bool readImageData(Serializer& in, const ProtocolImage& img, float* buffer, size_t bufferSize);
 	static bool writeImage(Serializer& in, const ProtocolImage& img, const float* buffer, size_t bufferSize);
+
+	static bool readImageUpdateRequest(Serializer& in, ProtocolImageUpdateRequest& request);
+	static bool writeImageUpdateRequest(Serializer& in, const ProtocolImageUpdateRequest& request);
+
+	// Update header followed by TileCount tiles. Tiles are read from and written into a full image with given width and height
+	static bool readImageUpdateHeader(Serializer& in, ProtocolImageUpdate& update);
+	static bool writeImageUpdateHeader(Serializer& in, const ProtocolImageUpdate& update);
+	static bool readImageTile(Serializer& in, const ProtocolImageUpdate& update, float* buffer, size_t bufferSize);
+	static bool writeImageTile(Serializer& in, const ProtocolImageUpdate& update, const ProtocolImageTile& tile, const float* buffer, size_t bufferSize);
 };
 } // namespace PR
\ No newline at end of file
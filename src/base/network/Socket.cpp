@@ -282,6 +282,24 @@ bool Socket::hasData(float timeout_s) const
 	return error > 0 && FD_ISSET(mInternal->Socket, &readableSet);
 }
 
+bool Socket::canSend(float timeout_s) const
+{
+	fd_set writableSet;
+	FD_ZERO(&writableSet);
+	FD_SET(mInternal->Socket, &writableSet);
+
+	timeval tout;
+	tout.tv_sec	 = (int)timeout_s;
+	tout.tv_usec = (timeout_s - (int)timeout_s) * 1000000;
+
+	int error = ::select(mInternal->Socket + 1, nullptr, &writableSet, nullptr, &tout);
+
+	if (isSocketError(error))
+		return false;
+
+	return error > 0 && FD_ISSET(mInternal->Socket, &writableSet);
+}
+
 bool Socket::send(const char* data, size_t len)
 {
 	size_t total = 0;
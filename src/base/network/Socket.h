@@ -21,6 +21,8 @@ public:
 	bool hasData() const;
 	bool hasData(float timeout_s) const;
 	inline bool hasIncomingConnection(float timeout_s) const { return hasData(timeout_s); }
+	// True if at least a small amount of data can be sent without blocking
+	bool canSend(float timeout_s) const;
 
 	// IO
 	bool send(const char* data, size_t len);
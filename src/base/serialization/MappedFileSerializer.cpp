@@ -0,0 +1,180 @@
+#include "MappedFileSerializer.h"
+#include "Platform.h"
+
+#include <cstring>
+
+#ifndef PR_OS_WINDOWS
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <sys/types.h>
+#include <unistd.h>
+#else
+#ifndef WIN32_LEAN_AND_MEAN
+#define WIN32_LEAN_AND_MEAN
+#endif
+#include <Windows.h>
+#endif
+
+namespace PR {
+struct MappedFileSerializerInternal {
+	const uint8* Data = nullptr;
+	size_t Size		  = 0;
+	size_t Position	  = 0;
+	bool Truncated	  = false;
+
+#ifndef PR_OS_WINDOWS
+	int Handle = -1;
+#else
+	HANDLE Handle  = INVALID_HANDLE_VALUE;
+	HANDLE Mapping = NULL;
+#endif
+};
+
+MappedFileSerializer::MappedFileSerializer()
+	: Serializer(true)
+	, mInternal(std::make_unique<MappedFileSerializerInternal>())
+{
+}
+
+MappedFileSerializer::MappedFileSerializer(const std::filesystem::path& path)
+	: Serializer(true)
+	, mInternal(std::make_unique<MappedFileSerializerInternal>())
+{
+	open(path);
+}
+
+MappedFileSerializer::~MappedFileSerializer()
+{
+	close();
+}
+
+bool MappedFileSerializer::open(const std::filesystem::path& path)
+{
+	if (isValid())
+		return false;
+
+#ifndef PR_OS_WINDOWS
+	mInternal->Handle = ::open(path.c_str(), O_RDONLY);
+	if (mInternal->Handle < 0)
+		return false;
+
+	struct stat info;
+	if (fstat(mInternal->Handle, &info) < 0 || info.st_size <= 0) {
+		close();
+		return false;
+	}
+
+	void* ptr = mmap(nullptr, (size_t)info.st_size, PROT_READ, MAP_PRIVATE, mInternal->Handle, 0);
+	if (ptr == MAP_FAILED) {
+		close();
+		return false;
+	}
+
+	// Content is consumed front to back
+	madvise(ptr, (size_t)info.st_size, MADV_SEQUENTIAL);
+
+	mInternal->Data = reinterpret_cast<const uint8*>(ptr);
+	mInternal->Size = (size_t)info.st_size;
+#else
+	mInternal->Handle = CreateFileW(path.c_str(), GENERIC_READ, FILE_SHARE_READ, NULL, OPEN_EXISTING, FILE_FLAG_SEQUENTIAL_SCAN, NULL);
+	if (mInternal->Handle == INVALID_HANDLE_VALUE)
+		return false;
+
+	LARGE_INTEGER size;
+	if (!GetFileSizeEx(mInternal->Handle, &size) || size.QuadPart <= 0) {
+		close();
+		return false;
+	}
+
+	mInternal->Mapping = CreateFileMappingW(mInternal->Handle, NULL, PAGE_READONLY, 0, 0, NULL);
+	if (mInternal->Mapping == NULL) {
+		close();
+		return false;
+	}
+
+	const void* ptr = MapViewOfFile(mInternal->Mapping, FILE_MAP_READ, 0, 0, 0);
+	if (!ptr) {
+		close();
+		return false;
+	}
+
+	mInternal->Data = reinterpret_cast<const uint8*>(ptr);
+	mInternal->Size = (size_t)size.QuadPart;
+#endif
+
+	mInternal->Position	 = 0;
+	mInternal->Truncated = false;
+	return true;
+}
+
+void MappedFileSerializer::close()
+{
+#ifndef PR_OS_WINDOWS
+	if (mInternal->Data)
+		munmap(const_cast<uint8*>(mInternal->Data), mInternal->Size);
+	if (mInternal->Handle >= 0)
+		::close(mInternal->Handle);
+	mInternal->Handle = -1;
+#else
+	if (mInternal->Data)
+		UnmapViewOfFile(mInternal->Data);
+	if (mInternal->Mapping != NULL)
+		CloseHandle(mInternal->Mapping);
+	if (mInternal->Handle != INVALID_HANDLE_VALUE)
+		CloseHandle(mInternal->Handle);
+	mInternal->Mapping = NULL;
+	mInternal->Handle  = INVALID_HANDLE_VALUE;
+#endif
+
+	mInternal->Data		 = nullptr;
+	mInternal->Size		 = 0;
+	mInternal->Position	 = 0;
+	mInternal->Truncated = false;
+}
+
+size_t MappedFileSerializer::size() const
+{
+	return mInternal->Size;
+}
+
+size_t MappedFileSerializer::position() const
+{
+	return mInternal->Position;
+}
+
+bool MappedFileSerializer::isTruncated() const
+{
+	return mInternal->Truncated;
+}
+
+const uint8* MappedFileSerializer::data() const
+{
+	return mInternal->Data;
+}
+
+bool MappedFileSerializer::isValid() const
+{
+	return mInternal && mInternal->Data;
+}
+
+size_t MappedFileSerializer::writeRaw(const uint8*, size_t)
+{
+	PR_ASSERT(false, "Trying to write into a read only serializer!");
+	return 0;
+}
+
+size_t MappedFileSerializer::readRaw(uint8* data, size_t size)
+{
+	PR_ASSERT(isValid(), "Trying to read from a close buffer!");
+
+	const size_t rem = std::min(size, remaining());
+	std::memcpy(data, mInternal->Data + mInternal->Position, rem);
+	mInternal->Position += rem;
+	if (rem < size)
+		mInternal->Truncated = true;
+
+	return rem;
+}
+
+} // namespace PR
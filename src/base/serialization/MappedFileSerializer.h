@@ -0,0 +1,39 @@
+#pragma once
+
+#include "Serializer.h"
+
+#include <filesystem>
+
+namespace PR {
+/// Read only serializer backed by a memory mapped file.
+/// Reads are plain copies out of the mapping, no stream buffering or parsing involved
+class PR_LIB_BASE MappedFileSerializer : public Serializer {
+	PR_CLASS_NON_COPYABLE(MappedFileSerializer);
+
+public:
+	MappedFileSerializer();
+	explicit MappedFileSerializer(const std::filesystem::path& path);
+	virtual ~MappedFileSerializer();
+
+	bool open(const std::filesystem::path& path);
+	void close();
+
+	size_t size() const;
+	size_t position() const;
+	inline size_t remaining() const { return size() - position(); }
+	/// True if a read requested more data than available since the file was opened
+	bool isTruncated() const;
+
+	/// Direct access to the mapped memory. Only valid as long as the serializer is open
+	const uint8* data() const;
+
+	// Interface
+	virtual bool isValid() const override;
+	virtual size_t writeRaw(const uint8* data, size_t size) override;
+	virtual size_t readRaw(uint8* data, size_t size) override;
+	virtual size_t readLimit() const override { return remaining(); }
+
+private:
+	std::unique_ptr<struct MappedFileSerializerInternal> mInternal;
+};
+} // namespace PR
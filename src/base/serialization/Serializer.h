@@ -2,6 +2,8 @@
 
 #include "ISerializable.h"
 
+#include <limits>
+#include <stdexcept>
 #include <unordered_map>
 #include <vector>
 
@@ -83,11 +85,14 @@ public:
 	virtual bool isValid() const							= 0;
 	virtual size_t writeRaw(const uint8* data, size_t size) = 0;
 	virtual size_t readRaw(uint8* data, size_t size)		= 0;
+	/// Upper bound of bytes left to read. Length prefixes exceeding it are rejected with a std::length_error before allocating
+	virtual size_t readLimit() const { return std::numeric_limits<size_t>::max(); }
 
 protected:
 	inline void setReadMode(bool b) { mReadMode = b; };
 	inline void writeRawLooped(const uint8* data, size_t size);
 	inline void readRawLooped(uint8* data, size_t size);
+	inline void checkReadSize(uint64 count, size_t elementSize) const;
 
 private:
 	bool mReadMode;
@@ -131,6 +131,12 @@ inline void Serializer::readRawLooped(uint8* data, size_t size)
 	}
 }
 
+inline void Serializer::checkReadSize(uint64 count, size_t elementSize) const
+{
+	if (count > readLimit() / elementSize)
+		throw std::length_error("Serialized length exceeds the remaining data");
+}
+
 inline void Serializer::read(bool& v)
 {
 	uint8 tmp;
@@ -154,7 +160,7 @@ inline void Serializer::read(int16& v)
 {
 	uint16 tmp;
 	read(tmp);
-	v = static_cast<int8>(tmp);
+	v = static_cast<int16>(tmp);
 }
 
 inline void Serializer::read(uint16& v)
@@ -166,7 +172,7 @@ inline void Serializer::read(int32& v)
 {
 	uint32 tmp;
 	read(tmp);
-	v = static_cast<int8>(tmp);
+	v = static_cast<int32>(tmp);
 }
 
 inline void Serializer::read(uint32& v)
@@ -178,7 +184,7 @@ inline void Serializer::read(int64& v)
 {
 	uint64 tmp;
 	read(tmp);
-	v = static_cast<int8>(tmp);
+	v = static_cast<int64>(tmp);
 }
 
 inline void Serializer::read(uint64& v)
@@ -200,9 +206,11 @@ inline void Serializer::read(std::string& v)
 {
 	v.clear();
 
-	uint8 c;
-	read(c);
-	for (; c != 0; read(c)) {
+	for (;;) {
+		uint8 c = 0; // Stays zero if no data is left, which ends truncated strings
+		read(c);
+		if (c == 0)
+			break;
 		v += static_cast<uint8>(c);
 	}
 }
@@ -211,9 +219,11 @@ inline void Serializer::read(std::wstring& v)
 {
 	v.clear();
 
-	uint32 c;
-	read(c);
-	for (; c != 0; read(c)) {
+	for (;;) {
+		uint32 c = 0; // Stays zero if no data is left, which ends truncated strings
+		read(c);
+		if (c == 0)
+			break;
 		v += static_cast<wchar_t>(c);
 	}
 }
@@ -227,8 +237,9 @@ template <typename T, typename Alloc>
 inline std::enable_if_t<is_trivial_serializable<T>::value, void>
 Serializer::read(std::vector<T, Alloc>& vec)
 {
-	uint64 size;
+	uint64 size = 0;
 	read(size);
+	checkReadSize(size, sizeof(T));
 	vec.resize(size);
 	readRawLooped(reinterpret_cast<uint8*>(vec.data()), vec.size() * sizeof(T));
 }
@@ -237,8 +248,9 @@ template <typename T, typename Alloc>
 inline std::enable_if_t<!is_trivial_serializable<T>::value, void>
 Serializer::read(std::vector<T, Alloc>& vec)
 {
-	uint64 size;
+	uint64 size = 0;
 	read(size);
+	checkReadSize(size, 1);
 	vec.resize(size);
 
 	T tmp;
@@ -253,8 +265,9 @@ inline void Serializer::read(std::unordered_map<T1, T2>& map)
 {
 	map.clear();
 
-	uint64 size;
+	uint64 size = 0;
 	read(size);
+	checkReadSize(size, 1);
 
 	T1 t1;
 	T2 t2;
@@ -1,6 +1,8 @@
 #include "ImageUpdateObserver.h"
 #include "Environment.h"
+#include "Logger.h"
 #include "ProgramSettings.h"
+#include "output/io/SnapshotWriter.h"
 #include "renderer/RenderContext.h"
 
 namespace PR {
@@ -12,6 +14,7 @@ ImageUpdateObserver::ImageUpdateObserver(Environment* environment)
 	, mIterationCycleCount(0)
 	, mUpdateCycleSeconds(0)
 	, mUseTags(false)
+	, mOnlyChanged(false)
 {
 	PR_ASSERT(mEnvironment, "Invalid environment");
 }
@@ -26,16 +29,24 @@ void ImageUpdateObserver::begin(RenderContext* renderContext, FrameOutputDevice*
 	mRenderContext		 = renderContext;
 	mFrameOutputDevice	 = outputDevice;
 	mUseTags			 = settings.ImgUseTags;
+	mOnlyChanged		 = settings.ImgOnlyChanged;
 	mIterationCount		 = 0;
 	mIterationCycleCount = settings.ImgUpdateIteration;
 	mUpdateCycleSeconds	 = settings.ImgUpdate;
 
-	mLastUpdate = std::chrono::high_resolution_clock::now();
+	mLastUpdate		= std::chrono::high_resolution_clock::now();
+	mSnapshotWriter = std::make_unique<SnapshotWriter>(&mEnvironment->outputSpecification());
 }
 
 void ImageUpdateObserver::end()
 {
-	// Nothing
+	// Make sure no snapshot is written while the final images are saved
+	if (mSnapshotWriter) {
+		mSnapshotWriter->wait();
+		if (mSnapshotWriter->droppedCount() > 0)
+			PR_LOG(L_DEBUG) << "Dropped " << mSnapshotWriter->droppedCount() << " image updates, as writing took longer than the update interval" << std::endl;
+		mSnapshotWriter.reset();
+	}
 }
 
 void ImageUpdateObserver::update(const UpdateInfo& info)
@@ -73,6 +84,7 @@ void ImageUpdateObserver::save(const UpdateInfo& info)
 	output_options.Image.IterationMeta = info.CurrentIteration;
 	output_options.Image.TimeMeta	   = std::chrono::duration_cast<std::chrono::seconds>(std::chrono::high_resolution_clock::now() - info.Start).count();
 	output_options.Image.WriteMeta	   = true;
+	output_options.OnlyChanged		   = mOnlyChanged;
 
 	if (mUseTags) {
 		std::stringstream stream;
@@ -80,7 +92,7 @@ void ImageUpdateObserver::save(const UpdateInfo& info)
 		output_options.NameSuffix = stream.str();
 	}
 
-	mEnvironment->save(mRenderContext, mFrameOutputDevice, mToneMapper, output_options);
+	mSnapshotWriter->save(mRenderContext, mFrameOutputDevice, mToneMapper, output_options);
 }
 
 } // namespace PR
\ No newline at end of file
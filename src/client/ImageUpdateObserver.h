@@ -5,6 +5,7 @@
 
 namespace PR {
 class Environment;
+class SnapshotWriter;
 class ImageUpdateObserver : public IProgressObserver {
 public:
 	ImageUpdateObserver(Environment* environment);
@@ -22,6 +23,7 @@ private:
 	FrameOutputDevice* mFrameOutputDevice;
 	Environment* mEnvironment;
 	ToneMapper mToneMapper;
+	std::unique_ptr<SnapshotWriter> mSnapshotWriter; // Periodic updates are written in the background
 
 	uint32 mIterationCount;
 
@@ -31,5 +33,6 @@ private:
 	time_point_t mLastUpdate;
 
 	bool mUseTags;
+	bool mOnlyChanged;
 };
 } // namespace PR
\ No newline at end of file
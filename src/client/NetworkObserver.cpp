@@ -17,6 +17,7 @@ bool handle_ping(Serializer& out)
 
 bool handle_status(NetworkObserver* observer, Serializer& out);
 bool handle_image(NetworkObserver* observer, Serializer& out);
+bool handle_image_update(NetworkObserver* observer, Serializer& in, Serializer& out);
 bool handle_protocol(NetworkObserver* observer, BufferedNetworkSerializer& in, BufferedNetworkSerializer& out)
 {
 	ProtocolType in_type;
@@ -36,6 +37,9 @@ bool handle_protocol(NetworkObserver* observer, BufferedNetworkSerializer& in, B
 	case ProtocolType::ImageRequest:
 		good = handle_image(observer, out);
 		break;
+	case ProtocolType::ImageUpdateRequest:
+		good = handle_image_update(observer, in, out);
+		break;
 	case ProtocolType::StopRequest:
 		PR_LOG(L_INFO) << "Stop request by client" << std::endl;
 		observer->context()->requestStop();
@@ -85,6 +89,50 @@ bool handle_image(NetworkObserver* observer, Serializer& out)
 		return false;
 }
 
+// Only send the tiles changed since the last update of the client
+bool handle_image_update(NetworkObserver* observer, Serializer& in, Serializer& out)
+{
+	ProtocolImageUpdateRequest request;
+	if (!Protocol::readImageUpdateRequest(in, request))
+		return false;
+
+	FrameOutputDevice* device = observer->outputDevice();
+	auto channel			  = device->data().getInternalChannel_Spectral(AOV_Output);
+
+	PR_ASSERT(channel->channels() == 3, "Expect spectral channel to have 3 channels");
+
+	std::vector<Point2i> blocks;
+	const uint64 stamp = device->dirtyBlocks(request.Stamp, blocks);
+
+	ProtocolImageUpdate update;
+	update.Width	 = channel->width();
+	update.Height	 = channel->height();
+	update.Encoding	 = request.Encoding;
+	update.Stamp	 = stamp;
+	update.TileCount = (uint32)blocks.size();
+
+	if (!Protocol::writeHeader(out, ProtocolType::ImageUpdateResponse)
+		|| !Protocol::writeImageUpdateHeader(out, update))
+		return false;
+
+	const size_t size = channel->size().area() * 3;
+	for (const Point2i& block : blocks) {
+		const Point2i start = block * FrameOutputDevice::MERGE_BLOCK_SIZE;
+		const Point2i end	= (start + Point2i::Constant(FrameOutputDevice::MERGE_BLOCK_SIZE)).cwiseMin(channel->size().asArray());
+
+		ProtocolImageTile tile;
+		tile.X		= start.x();
+		tile.Y		= start.y();
+		tile.Width	= end.x() - start.x();
+		tile.Height = end.y() - start.y();
+
+		if (!Protocol::writeImageTile(out, update, tile, channel->ptr(), size))
+			return false;
+	}
+
+	return true;
+}
+
 // Server - Client
 constexpr float TimeOut = 0.5f; //500ms
 class NetworkServer;
@@ -1,5 +1,6 @@
 #include "ProgramSettings.h"
 #include "EnumOption.h"
+#include "Logger.h"
 #include "config/Build.h"
 
 #include <cxxopts.hpp>
@@ -25,6 +26,7 @@ bool ProgramSettings::parse(int argc, char** argv)
 			("version", "Show version and exit")
 			("v,verbose", "Print detailed information into log file (and perhabs into console)")
 			("P,profile", "Profile execution and dump results into a file")
+			("profile-port", "Profile execution and stream the timeline to clients connecting to the given port", cxxopts::value<uint16>())
 			("progress", "Show progress if not quiet", cxxopts::value<uint32>()->default_value("1"))
 			("I,information", "Print additional scene information into log file (and perhabs into console)")
 			("p,progressive", "Start a progressive rendering. Some integrators may not support this")
@@ -39,6 +41,7 @@ bool ProgramSettings::parse(int argc, char** argv)
 			("img-update", "Update interval in seconds where image will be periodically saved. 0 disables it.", cxxopts::value<uint32>()->default_value("0"))
 			("img-iteration-update", "Update interval in iterations where image will be periodically saved. 0 disables it.", cxxopts::value<uint32>()->default_value("0"))
 			("img-use-tags", "Use tags _n to make sure no image produced in the session is replaced by the following one.")
+			("img-only-changed", "Only write image files whose content changed since the last periodic update.")
 
 			("no-network", "Disable network support for clients")
 			("network-port", "Set port to listen on", cxxopts::value<uint16>()->default_value("4217"))
@@ -56,6 +59,12 @@ bool ProgramSettings::parse(int argc, char** argv)
 			("rty", "Amount of vertical tiles used in threading", cxxopts::value<uint32>())
 			("no-adaptive-tiling", "Disable adaptive tiling used for better thread workload balance. Disabling will decrease performance of complex scenes but makes reproducibility of results possible")
 			("no-hit-sorting", "Disable sorting of hits to improve cache coherence")
+			("reorder-rays", "Reorder secondary rays by direction and origin before traversal to improve coherence")
+			("stateless-random", "Seed the random generators of each pixel sample by a hash instead of keeping a generator for each pixel of the film. Reduces memory for large films")
+			("async-iterations", "Let each tile advance to the next iteration without waiting for all other tiles. Only applies to single pass integrators and disables adaptive tiling")
+			("adaptive-threshold", "Enable adaptive sampling. Pixel blocks with a relative standard error below the given threshold get no further samples. Only applies to synchronized iterations", cxxopts::value<float>())
+			("adaptive-min-samples", "Samples each pixel gets before adaptive sampling may stop it", cxxopts::value<uint32>()->default_value("16"))
+			("hit-sort-keys", "Comma separated list of additional keys used to sort hits of the same entity. Available are 'material', 'direction' and 'primitive'", cxxopts::value<std::vector<std::string>>()->default_value("material,direction"))
 
 			("itx", "Amount of horizontal image tiles used in rendering", cxxopts::value<uint32>())
 			("ity", "Amount of vertical image tiles used in rendering", cxxopts::value<uint32>())
@@ -130,9 +139,11 @@ bool ProgramSettings::parse(int argc, char** argv)
 		ShowInformation = (vm.count("information") != 0);
 
 #ifdef PR_WITH_PROFILER
-		Profile = (vm.count("profile") != 0);
+		Profile		= (vm.count("profile") != 0) || (vm.count("profile-port") != 0);
+		ProfilePort = vm.count("profile-port") ? vm["profile-port"].as<uint16>() : -1;
 #else
-		Profile = false;
+		Profile		= false;
+		ProfilePort = -1;
 #endif
 
 		// Timing
@@ -143,6 +154,7 @@ bool ProgramSettings::parse(int argc, char** argv)
 		ImgUpdate		   = vm["img-update"].as<uint32>();
 		ImgUpdateIteration = vm["img-iteration-update"].as<uint32>();
 		ImgUseTags		   = (vm.count("img-use-tags") != 0);
+		ImgOnlyChanged	   = (vm.count("img-only-changed") != 0);
 
 		// Tev Image
 		TevVariance = vm.count("tev-var") != 0;
@@ -180,8 +192,29 @@ bool ProgramSettings::parse(int argc, char** argv)
 		else if (!vm.count("config"))
 			ThreadCount = DEF_THREAD_COUNT;
 
-		AdaptiveTiling = (vm.count("no-adaptive-tiling") == 0);
-		SortHits	   = (vm.count("no-hit-sorting") == 0);
+		AdaptiveTiling	= (vm.count("no-adaptive-tiling") == 0);
+		SortHits		= (vm.count("no-hit-sorting") == 0);
+		ReorderRays		= (vm.count("reorder-rays") != 0);
+		StatelessRandom = (vm.count("stateless-random") != 0);
+		AsyncIterations = (vm.count("async-iterations") != 0);
+
+		AdaptiveSampling	   = (vm.count("adaptive-threshold") != 0);
+		AdaptiveErrorThreshold = AdaptiveSampling ? vm["adaptive-threshold"].as<float>() : 0.01f;
+		AdaptiveMinSampleCount = vm["adaptive-min-samples"].as<uint32>();
+
+		SortKeys = 0;
+		for (const auto& key : vm["hit-sort-keys"].as<std::vector<std::string>>()) {
+			if (key == "material")
+				SortKeys |= HitSortKey::Material;
+			else if (key == "direction")
+				SortKeys |= HitSortKey::Direction;
+			else if (key == "primitive")
+				SortKeys |= HitSortKey::Primitive;
+			else {
+				PR_LOG(L_ERROR) << "Unknown hit sort key '" << key << "' given" << std::endl;
+				return false;
+			}
+		}
 
 		if (vm.count("itx"))
 			ImageTileXCount = std::max<uint32>(1, vm["itx"].as<uint32>());
@@ -1,6 +1,7 @@
 #pragma once
 
 #include "PR_Config.h"
+#include "renderer/RenderEnums.h"
 
 #include <filesystem>
 
@@ -18,6 +19,7 @@ public:
 	bool ShowInformation;
 
 	bool Profile;
+	int32 ProfilePort; // Port to stream the profile timeline, -1 no streaming
 
 	// Timing
 	uint32 MaxTime;	   // In seconds for equal time measurements
@@ -27,6 +29,7 @@ public:
 	uint32 ImgUpdate; // In seconds
 	uint32 ImgUpdateIteration;
 	bool ImgUseTags;
+	bool ImgOnlyChanged;
 
 	// Tev Image
 	uint32 TevUpdate; // In seconds
@@ -42,6 +45,13 @@ public:
 	uint32 ThreadCount;
 	bool AdaptiveTiling;
 	bool SortHits;
+	HitSortKeys SortKeys;
+	bool ReorderRays;
+	bool StatelessRandom;
+	bool AsyncIterations;
+	bool AdaptiveSampling;
+	float AdaptiveErrorThreshold;
+	uint32 AdaptiveMinSampleCount;
 	uint32 RenderTileXCount;
 	uint32 RenderTileYCount;
 	uint32 ImageTileXCount;
@@ -22,7 +22,7 @@ static const char* CHANNEL_NAMES_FDB[MAX_CHANNEL_COUNT_RGB] = { "Feedback.R", "F
 static const uint32 CREATE_MESSAGE_HEADER_SIZE				= 4 + 1 + IMAGE_NAME_SIZE + 1 + 4 + 4 + 4;
 static const uint32 CLOSE_MESSAGE_SIZE						= 4 + 1 + IMAGE_NAME_SIZE;
 static const uint32 UPDATE_MESSAGE_HEADER_SIZE				= 4 + 1 + IMAGE_NAME_SIZE + 1 + 4 + 4 + 4 + 4;
-constexpr uint32 UPDATE_TILE_SIZE							= 64;
+constexpr uint32 UPDATE_TILE_SIZE							= FrameOutputDevice::MERGE_BLOCK_SIZE; // Tiles are the dirty tracked merge blocks
 
 struct TevChannelInfo {
 	const char* Name		 = nullptr;
@@ -54,6 +54,7 @@ TevObserver::TevObserver()
 	, mUpdateCycleSeconds(0)
 	, mDisplayVariance(false)
 	, mDisplayFeedback(false)
+	, mLastStamp(0)
 {
 }
 
@@ -71,6 +72,7 @@ void TevObserver::begin(RenderContext* renderContext, FrameOutputDevice* outputD
 	mUpdateCycleSeconds = settings.TevUpdate;
 	mDisplayVariance	= settings.TevVariance;
 	mDisplayFeedback	= settings.TevFeedback;
+	mLastStamp			= 0;
 	mLastUpdate			= std::chrono::high_resolution_clock::now();
 
 	// Enable variance estimation if requested
@@ -215,124 +217,115 @@ void TevObserver::updateImageProtocol()
 
 	PR_ASSERT(channel->channels() == 3, "Expect spectral channel to have 3 channels");
 
-	const size_t tx = channel->width() / UPDATE_TILE_SIZE + 1;
-	const size_t ty = channel->height() / UPDATE_TILE_SIZE + 1;
-
 	const bool monotonic = mRenderContext->settings().spectralMono;
 
-	// TODO: Better way?
-	for (size_t i = 0; i < ty; ++i) {
-		size_t sy = i * UPDATE_TILE_SIZE;
-		size_t ey = std::min<size_t>(channel->height(), (i + 1) * UPDATE_TILE_SIZE);
-		size_t h  = ey - sy;
-
-		if (ey <= sy)
-			continue;
-
-		for (uint32 j = 0; j < tx; ++j) {
-			size_t sx = j * UPDATE_TILE_SIZE;
-			size_t ex = std::min<size_t>(channel->width(), (j + 1) * UPDATE_TILE_SIZE);
-			size_t w  = ex - sx;
-
-			if (ex <= sx)
-				continue;
-
-			// Copy to seperate channels and map to sRGB
-			if (!monotonic) {
-				PR_OPT_LOOP
-				for (size_t iy = 0; iy < h; ++iy) {
-					for (size_t ix = 0; ix < w; ++ix) {
-						const auto p = Point2i(sx + ix, sy + iy);
-
-						const float x = channel->getFragment(p, 0);
-						const float y = channel->getFragment(p, 1);
-						const float z = channel->getFragment(p, 2);
-
-						float r, g, b;
-						RGBConverter::fromXYZ(x, y, z, r, g, b);
-						mConnection->Data[UPDATE_TILE_SIZE * UPDATE_TILE_SIZE * 0 + iy * w + ix] = r;
-						mConnection->Data[UPDATE_TILE_SIZE * UPDATE_TILE_SIZE * 1 + iy * w + ix] = g;
-						mConnection->Data[UPDATE_TILE_SIZE * UPDATE_TILE_SIZE * 2 + iy * w + ix] = b;
-					}
+	// Only send tiles changed since the last update. The image in tev keeps the previous content otherwise
+	mDirtyBlocks.clear();
+	const uint64 stamp = mFrameOutputDevice->dirtyBlocks(mLastStamp, mDirtyBlocks);
+
+	for (const Point2i& block : mDirtyBlocks) {
+		const size_t sx = block.x() * UPDATE_TILE_SIZE;
+		const size_t sy = block.y() * UPDATE_TILE_SIZE;
+		const size_t w	= std::min<size_t>(channel->width(), sx + UPDATE_TILE_SIZE) - sx;
+		const size_t h	= std::min<size_t>(channel->height(), sy + UPDATE_TILE_SIZE) - sy;
+
+		// Copy to seperate channels and map to sRGB
+		if (!monotonic) {
+			PR_OPT_LOOP
+			for (size_t iy = 0; iy < h; ++iy) {
+				for (size_t ix = 0; ix < w; ++ix) {
+					const auto p = Point2i(sx + ix, sy + iy);
+
+					const float x = channel->getFragment(p, 0);
+					const float y = channel->getFragment(p, 1);
+					const float z = channel->getFragment(p, 2);
+
+					float r, g, b;
+					RGBConverter::fromXYZ(x, y, z, r, g, b);
+					mConnection->Data[UPDATE_TILE_SIZE * UPDATE_TILE_SIZE * 0 + iy * w + ix] = r;
+					mConnection->Data[UPDATE_TILE_SIZE * UPDATE_TILE_SIZE * 1 + iy * w + ix] = g;
+					mConnection->Data[UPDATE_TILE_SIZE * UPDATE_TILE_SIZE * 2 + iy * w + ix] = b;
 				}
-			} else {
-				PR_OPT_LOOP
-				for (size_t iy = 0; iy < h; ++iy) {
-					for (size_t ix = 0; ix < w; ++ix) {
-						const auto p = Point2i(sx + ix, sy + iy);
-						for (size_t k = 0; k < 3; ++k)
-							mConnection->Data[UPDATE_TILE_SIZE * UPDATE_TILE_SIZE * k + iy * w + ix] = channel->getFragment(p, k);
-					}
+			}
+		} else {
+			PR_OPT_LOOP
+			for (size_t iy = 0; iy < h; ++iy) {
+				for (size_t ix = 0; ix < w; ++ix) {
+					const auto p = Point2i(sx + ix, sy + iy);
+					for (size_t k = 0; k < 3; ++k)
+						mConnection->Data[UPDATE_TILE_SIZE * UPDATE_TILE_SIZE * k + iy * w + ix] = channel->getFragment(p, k);
 				}
 			}
+		}
 
-			size_t delta = 3;
-			if (mDisplayVariance) {
-				PR_OPT_LOOP
-				for (size_t iy = 0; iy < h; ++iy) {
-					for (size_t ix = 0; ix < w; ++ix) {
-						const auto p = Point2i(sx + ix, sy + iy);
-						for (size_t k = 0; k < 3; ++k)
-							mConnection->Data[UPDATE_TILE_SIZE * UPDATE_TILE_SIZE * (k + delta) + iy * w + ix] = var_channel->getFragment(p, k);
-					}
+		size_t delta = 3;
+		if (mDisplayVariance) {
+			PR_OPT_LOOP
+			for (size_t iy = 0; iy < h; ++iy) {
+				for (size_t ix = 0; ix < w; ++ix) {
+					const auto p = Point2i(sx + ix, sy + iy);
+					for (size_t k = 0; k < 3; ++k)
+						mConnection->Data[UPDATE_TILE_SIZE * UPDATE_TILE_SIZE * (k + delta) + iy * w + ix] = var_channel->getFragment(p, k);
 				}
-				delta += 3;
 			}
+			delta += 3;
+		}
 
-			if (mDisplayFeedback) {
-				PR_OPT_LOOP
-				for (size_t iy = 0; iy < h; ++iy) {
-					for (size_t ix = 0; ix < w; ++ix) {
-						const auto p				  = Point2i(sx + ix, sy + iy);
-						const OutputFeedbackFlags fdb = fdb_channel->getFragment(p, 0);
-
-						float r = 0;
-						if (fdb & OutputFeedback::NaN)
-							r = 1.0f;
-						else if (fdb & OutputFeedback::Infinite)
-							r = 0.5f;
-						else if (fdb & OutputFeedback::Negative)
-							r = 0.25f;
-
-						float g = 0;
-						if (fdb & OutputFeedback::MissingMaterial)
-							g = 1.0f;
-
-						float b = 0;
-						if (fdb & OutputFeedback::MissingEmission)
-							b = 1.0f;
-
-						mConnection->Data[UPDATE_TILE_SIZE * UPDATE_TILE_SIZE * (0 + delta) + iy * w + ix] = r;
-						mConnection->Data[UPDATE_TILE_SIZE * UPDATE_TILE_SIZE * (1 + delta) + iy * w + ix] = g;
-						mConnection->Data[UPDATE_TILE_SIZE * UPDATE_TILE_SIZE * (2 + delta) + iy * w + ix] = b;
-					}
+		if (mDisplayFeedback) {
+			PR_OPT_LOOP
+			for (size_t iy = 0; iy < h; ++iy) {
+				for (size_t ix = 0; ix < w; ++ix) {
+					const auto p				  = Point2i(sx + ix, sy + iy);
+					const OutputFeedbackFlags fdb = fdb_channel->getFragment(p, 0);
+
+					float r = 0;
+					if (fdb & OutputFeedback::NaN)
+						r = 1.0f;
+					else if (fdb & OutputFeedback::Infinite)
+						r = 0.5f;
+					else if (fdb & OutputFeedback::Negative)
+						r = 0.25f;
+
+					float g = 0;
+					if (fdb & OutputFeedback::MissingMaterial)
+						g = 1.0f;
+
+					float b = 0;
+					if (fdb & OutputFeedback::MissingEmission)
+						b = 1.0f;
+
+					mConnection->Data[UPDATE_TILE_SIZE * UPDATE_TILE_SIZE * (0 + delta) + iy * w + ix] = r;
+					mConnection->Data[UPDATE_TILE_SIZE * UPDATE_TILE_SIZE * (1 + delta) + iy * w + ix] = g;
+					mConnection->Data[UPDATE_TILE_SIZE * UPDATE_TILE_SIZE * (2 + delta) + iy * w + ix] = b;
 				}
-				delta += 3;
 			}
+			delta += 3;
+		}
 
-			for (size_t c = 0; c < mConnection->ChannelInfo.size(); ++c) {
-				const float* data		 = mConnection->Data.data() + UPDATE_TILE_SIZE * UPDATE_TILE_SIZE * c;
-				const uint32 messageSize = mConnection->ChannelInfo[c].UpdateMessageSize + sizeof(float) * h * w;
-
-				mConnection->Out.write((uint32)messageSize);
-				mConnection->Out.write((uint8)3);
-				mConnection->Out.write((uint8)0);
-				mConnection->Out.write(IMAGE_NAME);
-				mConnection->Out.write(mConnection->ChannelInfo[c].Name);
-				mConnection->Out.write((uint32)sx);
-				mConnection->Out.write((uint32)sy);
-				mConnection->Out.write((uint32)w);
-				mConnection->Out.write((uint32)h);
-				mConnection->Out.writeRaw(reinterpret_cast<const uint8*>(data), h * w * sizeof(float));
-
-				if (mConnection->Con.isOpen()) {
-					//PR_ASSERT(mConnection->Out.currentUsed() == messageSize, "Invalid package size");
-					mConnection->Out.flush();
-				} else {
-					return;
-				}
+		for (size_t c = 0; c < mConnection->ChannelInfo.size(); ++c) {
+			const float* data		 = mConnection->Data.data() + UPDATE_TILE_SIZE * UPDATE_TILE_SIZE * c;
+			const uint32 messageSize = mConnection->ChannelInfo[c].UpdateMessageSize + sizeof(float) * h * w;
+
+			mConnection->Out.write((uint32)messageSize);
+			mConnection->Out.write((uint8)3);
+			mConnection->Out.write((uint8)0);
+			mConnection->Out.write(IMAGE_NAME);
+			mConnection->Out.write(mConnection->ChannelInfo[c].Name);
+			mConnection->Out.write((uint32)sx);
+			mConnection->Out.write((uint32)sy);
+			mConnection->Out.write((uint32)w);
+			mConnection->Out.write((uint32)h);
+			mConnection->Out.writeRaw(reinterpret_cast<const uint8*>(data), h * w * sizeof(float));
+
+			if (mConnection->Con.isOpen()) {
+				//PR_ASSERT(mConnection->Out.currentUsed() == messageSize, "Invalid package size");
+				mConnection->Out.flush();
+			} else {
+				return; // Keep the old stamp, as the remaining blocks were not sent
 			}
 		}
 	}
+
+	mLastStamp = stamp;
 }
 } // namespace PR
\ No newline at end of file
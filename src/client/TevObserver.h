@@ -26,6 +26,8 @@ private:
 	uint64 mUpdateCycleSeconds;
 	bool mDisplayVariance;
 	bool mDisplayFeedback;
+	uint64 mLastStamp; // Change stamp of the frame at the last update
+	std::vector<Point2i> mDirtyBlocks;
 
 	time_point_t mLastUpdate;
 };
@@ -38,6 +38,7 @@ void printStatistics(const RenderStatus& status)
 
 	const auto raycount	  = std::get<uint64>(status.getField("global.ray_count"));
 	const auto pixelcount = std::get<uint64>(status.getField("global.pixel_sample_count"));
+	const auto groupcount = std::get<uint64>(status.getField("global.shading_group_count"));
 
 	out << "  Ray Count:         " << std::setw(OUTPUT_FIELD_SIZE) << raycount << std::endl
 		<< "  │ Sources:" << std::endl
@@ -54,6 +55,8 @@ void printStatistics(const RenderStatus& status)
 		<< "  Mean Ray Depth:    " << std::setw(OUTPUT_FIELD_SIZE) << std::get<uint64>(status.getField("global.depth_count")) / (double)pixelcount << std::endl
 		<< "  ├ Camera:          " << std::setw(OUTPUT_FIELD_SIZE) << std::get<uint64>(status.getField("global.camera_depth_count")) / (double)pixelcount << std::endl
 		<< "  └ Light:           " << std::setw(OUTPUT_FIELD_SIZE) << std::get<uint64>(status.getField("global.light_depth_count")) / (double)pixelcount << std::endl
+		<< "  Shading Groups:    " << std::setw(OUTPUT_FIELD_SIZE) << groupcount << std::endl
+		<< "  └ Mean Size:       " << std::setw(OUTPUT_FIELD_SIZE) << (groupcount > 0 ? std::get<uint64>(status.getField("global.shading_group_hit_count")) / (double)groupcount : 0.0) << std::endl
 		<< "  Iterations:        " << std::setw(OUTPUT_FIELD_SIZE) << std::get<uint64>(status.getField("global.iteration_count")) << std::endl;
 }
 
@@ -96,7 +99,7 @@ int main(int argc, char** argv)
 		std::cout << "Error while setting signal handler. Stopping progressive rendering through console might not be possible" << std::endl;
 
 	if (options.Profile)
-		Profiler::start(PROFILE_SAMPLE_RATE);
+		Profiler::start(PROFILE_SAMPLE_RATE, options.ProfilePort);
 
 	time_t t = time(NULL);
 	std::stringstream sstream;
@@ -146,6 +149,14 @@ int main(int argc, char** argv)
 
 	env->renderSettings().useAdaptiveTiling = options.AdaptiveTiling;
 	env->renderSettings().sortHits			= options.SortHits;
+	env->renderSettings().hitSortKeys		= options.SortKeys;
+	env->renderSettings().reorderRays		= options.ReorderRays;
+	env->renderSettings().pixelRandomMode	= options.StatelessRandom ? PixelRandomMode::Hash : PixelRandomMode::Map;
+	env->renderSettings().asyncIterations	= options.AsyncIterations;
+
+	env->renderSettings().adaptiveSampling		 = options.AdaptiveSampling;
+	env->renderSettings().adaptiveErrorThreshold = options.AdaptiveErrorThreshold;
+	env->renderSettings().adaptiveMinSampleCount = options.AdaptiveMinSampleCount;
 
 	// Initialize observers
 	std::vector<std::unique_ptr<IProgressObserver>> observers;
@@ -272,6 +283,9 @@ int main(int argc, char** argv)
 		const sf::path profFile = options.OutputDir / "pr_profile.prof";
 		if (!Profiler::dumpToFile(profFile.generic_wstring()))
 			PR_LOG(L_ERROR) << "Could not write profile data to " << profFile << std::endl;
+		const sf::path traceFile = options.OutputDir / "pr_profile_trace.json";
+		if (!Profiler::dumpToChromeTrace(traceFile.generic_wstring()))
+			PR_LOG(L_ERROR) << "Could not write profile timeline to " << traceFile << std::endl;
 	}
 
 	return EXIT_SUCCESS;
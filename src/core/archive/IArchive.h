@@ -2,6 +2,8 @@
 
 #include "PR_Config.h"
 
+#include <vector>
+
 namespace PR {
 class RayStream;
 class HitStream;
@@ -19,6 +21,8 @@ public:
 	virtual bool traceSingleRay(const Ray& ray, HitEntry& entry) const = 0;
 	/// Traces a single ray and returns true if something lays within the given distance
 	virtual bool traceShadowRay(const Ray& ray, float distance = PR_INF) const = 0;
+	/// Traces a stream of shadow rays and marks each ray as occluded if something lays within its maximum distance
+	virtual void traceShadowRays(RayStream& rays, std::vector<bool>& occluded) const = 0;
 
 	/// Bounding box containing all elements inside in world coordinates.
 	virtual BoundingBox boundingBox() const = 0;
@@ -219,7 +219,7 @@ public:
 
 	inline void copyFrom(const FrameBuffer<T>& other)
 	{
-		PR_ASSERT(!isSameSizeAs(other), "Expected other to be of the same size!");
+		PR_ASSERT(isSameSizeAs(other), "Expected other to be of the same size!");
 		std::copy(other.mData.begin(), other.mData.end(), mData.begin());
 	}
 
@@ -0,0 +1,84 @@
+#pragma once
+
+#include "geometry/BoundingBox.h"
+
+#include "PositionGetter.h"
+
+#include <atomic>
+#include <tbb/concurrent_vector.h>
+#include <vector>
+
+namespace PR {
+
+/// Memory compact spatial hashmap.
+/// Elements are gathered concurrently with store() and sorted into one contiguous array by build().
+/// The cells of the grid are mapped by a spatial hash to a table of bounded size, therefore the memory used only depends on the amount of elements.
+/// Searches are only valid after build() and before the next store() or reset()
+template <typename T, template <typename> typename PositionGetter = position_getter>
+class SortedHashGrid {
+	PR_CLASS_NON_COPYABLE(SortedHashGrid);
+
+public:
+	static constexpr size_t DEFAULT_MAX_TABLE_SIZE = 1 << 24;
+
+	template <typename U = T>
+	inline SortedHashGrid(const BoundingBox& bbox, float gridDelta, size_t maxTableSize = DEFAULT_MAX_TABLE_SIZE,
+						  typename std::enable_if<std::is_default_constructible<PositionGetter<U>>::value>::type* = 0)
+		: SortedHashGrid(bbox, gridDelta, PositionGetter<U>(), maxTableSize)
+	{
+	}
+
+	inline SortedHashGrid(const BoundingBox& bbox, float gridDelta, const PositionGetter<T>& getter, size_t maxTableSize = DEFAULT_MAX_TABLE_SIZE);
+	inline virtual ~SortedHashGrid();
+
+	/// Remove all elements, but keep the memory for the next round
+	inline void reset();
+
+	inline bool isEmpty() const { return mStoredElements == 0; }
+	inline uint64 storedElements() const { return mStoredElements; }
+	inline float gridDelta() const { return mGridDelta; }
+
+	/// Thread safe
+	inline void store(const T& point);
+	inline void storeUnsafe(const T& point); // Do not check for the boundary
+	/// Thread safe, appends a whole batch at once to reduce contention. Do not check for the boundary
+	template <typename Iterator>
+	inline void storeUnsafe(Iterator begin, Iterator end);
+
+	/// Sort all stored elements into their cells. Internally parallelized.
+	/// The staged elements are released afterwards, therefore only build once after each reset()
+	inline void build();
+
+	// Set RadiusSmall = true if given radius is smaller than gridDelta
+	template <bool RadiusSmall, typename Function>
+	inline void search(const Vector3f& center, float radius2, const Function& func) const;
+
+private:
+	struct KeyCoord {
+		int32 X, Y, Z;
+
+		inline bool operator==(const KeyCoord& other) const;
+	};
+
+	inline KeyCoord toCoords(const Vector3f& pos) const;
+	inline uint32 toHash(const KeyCoord& coords) const;
+	template <typename Function>
+	inline void searchCell(const KeyCoord& coords, const Function& func) const;
+
+	tbb::concurrent_vector<T> mStaged; // Elements not yet sorted into the grid
+	std::atomic<uint64> mStoredElements;
+
+	std::vector<T> mElements;	   // Sorted by hash of the cell
+	std::vector<uint32> mCellStart; // Start of the elements for each hash in mElements. Has one more entry marking the end
+	std::vector<uint32> mHashes;	   // Hash of the staged elements, only used while building
+	uint32 mHashMask;
+
+	const float mGridDelta;
+	const float mInvGridDelta;
+	const BoundingBox mBoundingBox;
+	const size_t mMaxTableSize;
+	const PositionGetter<T> mPositionGetter;
+};
+} // namespace PR
+
+#include "SortedHashGrid.inl"
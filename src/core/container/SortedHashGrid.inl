@@ -0,0 +1,230 @@
+// IWYU pragma: private, include "container/SortedHashGrid.h"
+#include <tbb/parallel_for.h>
+#include <tbb/parallel_scan.h>
+
+namespace PR {
+template <typename T, template <typename> typename PositionGetter>
+SortedHashGrid<T, PositionGetter>::SortedHashGrid(const BoundingBox& bbox, float gridDelta, const PositionGetter<T>& getter, size_t maxTableSize)
+	: mStaged()
+	, mStoredElements(0)
+	, mHashMask(0)
+	, mGridDelta(gridDelta)
+	, mInvGridDelta(1.0f / gridDelta)
+	, mBoundingBox(bbox.expanded(0.001f))
+	, mMaxTableSize(std::max<size_t>(1, maxTableSize))
+	, mPositionGetter(getter)
+{
+	PR_ASSERT(mGridDelta > PR_EPSILON, "Grid delta has to greater 0");
+	PR_ASSERT(std::isfinite(mInvGridDelta), "Inverse of grid delta has to be valid");
+
+	mCellStart.resize(2, 0);
+}
+
+template <typename T, template <typename> typename PositionGetter>
+SortedHashGrid<T, PositionGetter>::~SortedHashGrid()
+{
+}
+
+template <typename T, template <typename> typename PositionGetter>
+void SortedHashGrid<T, PositionGetter>::reset()
+{
+	mStoredElements = 0;
+	mStaged.clear();
+	mElements.clear();
+
+	mHashMask = 0;
+	mCellStart.assign(2, 0);
+}
+
+template <typename T, template <typename> typename PositionGetter>
+void SortedHashGrid<T, PositionGetter>::store(const T& el)
+{
+	const Vector3f pos = mPositionGetter(el);
+	if (!mBoundingBox.contains(pos))
+		return;
+
+	storeUnsafe(el);
+}
+
+template <typename T, template <typename> typename PositionGetter>
+void SortedHashGrid<T, PositionGetter>::storeUnsafe(const T& el)
+{
+	mStoredElements++;
+	mStaged.push_back(el);
+}
+
+template <typename T, template <typename> typename PositionGetter>
+template <typename Iterator>
+void SortedHashGrid<T, PositionGetter>::storeUnsafe(Iterator begin, Iterator end)
+{
+	if (begin == end)
+		return;
+
+	mStoredElements += std::distance(begin, end);
+	mStaged.grow_by(begin, end);
+}
+
+template <typename T, template <typename> typename PositionGetter>
+void SortedHashGrid<T, PositionGetter>::build()
+{
+	const size_t count = mStaged.size();
+	PR_ASSERT(count < std::numeric_limits<uint32>::max(), "Too many elements in grid");
+
+	// The table grows with the amount of elements, but never above the given maximum
+	size_t tableSize = 1;
+	while (tableSize < count && tableSize < mMaxTableSize)
+		tableSize <<= 1;
+	mHashMask = static_cast<uint32>(tableSize - 1);
+
+	mHashes.resize(count);
+	mElements.resize(count);
+	mCellStart.resize(tableSize + 1);
+
+	std::unique_ptr<std::atomic<uint32>[]> counters(new std::atomic<uint32>[tableSize]);
+	tbb::parallel_for(tbb::blocked_range<size_t>(0, tableSize),
+					  [&](const tbb::blocked_range<size_t>& r) {
+						  for (size_t i = r.begin(); i != r.end(); ++i)
+							  counters[i].store(0, std::memory_order_relaxed);
+					  });
+
+	// Count elements per cell
+	tbb::parallel_for(tbb::blocked_range<size_t>(0, count),
+					  [&](const tbb::blocked_range<size_t>& r) {
+						  for (size_t i = r.begin(); i != r.end(); ++i) {
+							  const uint32 hash = toHash(toCoords(mPositionGetter(mStaged[i])));
+							  mHashes[i]		= hash;
+							  counters[hash].fetch_add(1, std::memory_order_relaxed);
+						  }
+					  });
+
+	// Exclusive prefix sum to get the start of each cell
+	tbb::parallel_scan(
+		tbb::blocked_range<size_t>(0, tableSize), uint32(0),
+		[&](const tbb::blocked_range<size_t>& r, uint32 sum, bool isFinal) {
+			for (size_t i = r.begin(); i != r.end(); ++i) {
+				if (isFinal)
+					mCellStart[i] = sum;
+				sum += counters[i].load(std::memory_order_relaxed);
+			}
+			return sum;
+		},
+		[](uint32 a, uint32 b) { return a + b; });
+	mCellStart[tableSize] = static_cast<uint32>(count);
+
+	// Scatter elements into their cells, the counters serve as cursors now
+	tbb::parallel_for(tbb::blocked_range<size_t>(0, tableSize),
+					  [&](const tbb::blocked_range<size_t>& r) {
+						  for (size_t i = r.begin(); i != r.end(); ++i)
+							  counters[i].store(mCellStart[i], std::memory_order_relaxed);
+					  });
+
+	tbb::parallel_for(tbb::blocked_range<size_t>(0, count),
+					  [&](const tbb::blocked_range<size_t>& r) {
+						  for (size_t i = r.begin(); i != r.end(); ++i) {
+							  const uint32 pos = counters[mHashes[i]].fetch_add(1, std::memory_order_relaxed);
+							  mElements[pos]   = mStaged[i];
+						  }
+					  });
+
+	// The staging buffers are as large as the grid itself and not required anymore
+	mStaged.clear();
+	mStaged.shrink_to_fit();
+	std::vector<uint32>().swap(mHashes);
+}
+
+template <typename T, template <typename> typename PositionGetter>
+template <typename Function>
+inline void SortedHashGrid<T, PositionGetter>::searchCell(const KeyCoord& coords, const Function& func) const
+{
+	const uint32 hash = toHash(coords);
+	for (uint32 i = mCellStart[hash]; i < mCellStart[hash + 1]; ++i) {
+		// Other cells might share the same hash
+		const T& el = mElements[i];
+		if (toCoords(mPositionGetter(el)) == coords)
+			func(el);
+	}
+}
+
+template <typename T, template <typename> typename PositionGetter>
+template <bool RadiusSmall, typename Function>
+inline void SortedHashGrid<T, PositionGetter>::search(const Vector3f& center, float radius2, const Function& func) const
+{
+	if (mElements.empty())
+		return;
+
+	const Vector3f dp = (center - mBoundingBox.lowerBound()) * mInvGridDelta;
+
+	if constexpr (RadiusSmall) {
+		PR_ASSERT(radius2 <= mGridDelta * mGridDelta, "Expected radius to be smaller than the configured grid delta");
+
+		const KeyCoord centerCoord = toCoords(center);
+		const int32 px2			   = centerCoord.X + (dp(0) - centerCoord.X > 0.5f ? 1 : -1);
+		const int32 py2			   = centerCoord.Y + (dp(1) - centerCoord.Y > 0.5f ? 1 : -1);
+		const int32 pz2			   = centerCoord.Z + (dp(2) - centerCoord.Z > 0.5f ? 1 : -1);
+
+		for (int i = 0; i < 8; i++) {
+			const KeyCoord key = {
+				(i & 1) != 0 ? px2 : centerCoord.X,
+				(i & 2) != 0 ? py2 : centerCoord.Y,
+				(i & 4) != 0 ? pz2 : centerCoord.Z
+			};
+			searchCell(key, func);
+		}
+	} else {
+		const KeyCoord centerCoord = toCoords(center);
+		const Vector3f rel		   = dp - Vector3f(centerCoord.X, centerCoord.Y, centerCoord.Z); // Position inside the center cell
+		const int32 rad			   = (int32)std::ceil(std::sqrt(radius2) * mInvGridDelta);
+		const float gridRadius2	   = radius2 * mInvGridDelta * mInvGridDelta;
+
+		// Squared distance in grid space between the center and the closest point of the cell with given offset
+		const auto cellDist2 = [&](int32 offset, int axis) {
+			const float d = offset > 0 ? (offset - rel(axis)) : (offset < 0 ? (rel(axis) - offset - 1) : 0.0f);
+			return d * d;
+		};
+
+		for (int32 x = -rad; x <= rad; ++x) {
+			const float dx = cellDist2(x, 0);
+			if (dx > gridRadius2)
+				continue;
+
+			for (int32 y = -rad; y <= rad; ++y) {
+				const float dy = dx + cellDist2(y, 1);
+				if (dy > gridRadius2)
+					continue;
+
+				for (int32 z = -rad; z <= rad; ++z) {
+					if (dy + cellDist2(z, 2) > gridRadius2)
+						continue;
+
+					searchCell(KeyCoord{ centerCoord.X + x, centerCoord.Y + y, centerCoord.Z + z }, func);
+				}
+			}
+		}
+	}
+}
+
+template <typename T, template <typename> typename PositionGetter>
+typename SortedHashGrid<T, PositionGetter>::KeyCoord SortedHashGrid<T, PositionGetter>::toCoords(const Vector3f& p) const
+{
+	const Vector3f dp = (p - mBoundingBox.lowerBound()) * mInvGridDelta;
+	return {
+		static_cast<int32>(std::floor(dp(0))),
+		static_cast<int32>(std::floor(dp(1))),
+		static_cast<int32>(std::floor(dp(2)))
+	};
+}
+
+template <typename T, template <typename> typename PositionGetter>
+bool SortedHashGrid<T, PositionGetter>::KeyCoord::operator==(const KeyCoord& other) const
+{
+	return X == other.X && Y == other.Y && Z == other.Z;
+}
+
+template <typename T, template <typename> typename PositionGetter>
+inline uint32 SortedHashGrid<T, PositionGetter>::toHash(const KeyCoord& coords) const
+{
+	// Teschner et al. 2003, Optimized Spatial Hashing for Collision Detection of Deformable Objects
+	return ((static_cast<uint32>(coords.X) * 73856093u) ^ (static_cast<uint32>(coords.Y) * 19349663u) ^ (static_cast<uint32>(coords.Z) * 83492791u)) & mHashMask;
+}
+
+} // namespace PR
@@ -3,6 +3,7 @@
 #include "Enum.h"
 #include "ITransformable.h"
 #include "geometry/BoundingBox.h"
+#include "geometry/NormalCone.h"
 
 namespace PR {
 enum class EntityVisibility : uint8 {
@@ -97,6 +98,17 @@ public:
 
 	virtual void provideGeometryPoint(const EntityGeometryQueryPoint& query, GeometryPoint& pt) const = 0;
 
+	/// Cone bounding all world normals of the entity. Used to guide light selection
+	/// The default implementation bounds all directions
+	virtual NormalCone worldNormalCone() const { return NormalCone(); }
+
+	/// Local material slot of the given primitive. Only used as a hint to sort hits for coherent shading
+	virtual uint32 localMaterialSlot(uint32 primitiveID) const
+	{
+		PR_UNUSED(primitiveID);
+		return 0;
+	}
+
 	// Light
 	inline bool hasEmission() const { return mEmissionID != PR_INVALID_ID; }
 	inline uint32 emissionID() const { return mEmissionID; }
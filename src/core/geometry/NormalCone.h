@@ -0,0 +1,48 @@
+#pragma once
+
+#include "PR_Config.h"
+
+#include <algorithm>
+
+namespace PR {
+/// Cone bounding a set of directions, e.g., the normals of a surface
+struct PR_LIB_CORE NormalCone {
+	Vector3f Axis = Vector3f(0, 0, 1);
+	float Theta	  = PR_PI; // Spread angle around the axis. PR_PI bounds all directions
+
+	inline NormalCone() = default;
+	inline NormalCone(const Vector3f& axis, float theta)
+		: Axis(axis)
+		, Theta(theta)
+	{
+	}
+
+	inline bool isFull() const { return Theta >= PR_PI; }
+
+	/// Smallest cone bounding both cones
+	inline NormalCone combined(const NormalCone& other) const
+	{
+		const NormalCone& a = Theta >= other.Theta ? *this : other;
+		const NormalCone& b = Theta >= other.Theta ? other : *this;
+
+		if (a.isFull())
+			return a;
+
+		const float thetaD = std::acos(std::clamp(a.Axis.dot(b.Axis), -1.0f, 1.0f));
+		if (std::min(thetaD + b.Theta, PR_PI) <= a.Theta)
+			return a;
+
+		const float thetaO = (a.Theta + thetaD + b.Theta) / 2;
+		if (thetaO >= PR_PI)
+			return NormalCone(a.Axis, PR_PI);
+
+		// Rotate the axis of a towards b
+		const Vector3f rotAxis = a.Axis.cross(b.Axis);
+		if (rotAxis.squaredNorm() <= PR_EPSILON) // Opposite axes
+			return NormalCone(a.Axis, PR_PI);
+
+		const Vector3f axis = Eigen::AngleAxisf(thetaO - a.Theta, rotAxis.normalized()) * a.Axis;
+		return NormalCone(axis.normalized(), thetaO);
+	}
+};
+} // namespace PR
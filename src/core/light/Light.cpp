@@ -142,7 +142,7 @@ void Light::sample(const LightSampleInput& in, LightSampleOutput& out, const Ren
 			out.LightPosition		= ilsout.LightPosition;
 		} else {
 			InfiniteLightSampleDirInput ilsin;
-			ilsin.DirectionRND = in.RND.get2D();
+			ilsin.DirectionRND = in.pointSample();
 			ilsin.WavelengthNM = out.WavelengthNM;
 
 			InfiniteLightSampleDirOutput ilsout;
@@ -158,8 +158,8 @@ void Light::sample(const LightSampleInput& in, LightSampleOutput& out, const Ren
 		out.CosLight = 1;
 	} else {
 		IEntity* ent					  = reinterpret_cast<IEntity*>(mEntity);
-		const EntitySamplePoint pp		  = in.SamplingInfo ? ent->sampleParameterPoint(*in.SamplingInfo, in.RND.get2D())
-															: ent->sampleParameterPoint(in.RND.get2D());
+		const EntitySamplePoint pp		  = in.SamplingInfo ? ent->sampleParameterPoint(*in.SamplingInfo, in.pointSample())
+															: ent->sampleParameterPoint(in.pointSample());
 		const EntityGeometryQueryPoint qp = pp.toQueryPoint(Vector3f::Zero());
 
 		GeometryPoint gp;
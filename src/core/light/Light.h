@@ -4,6 +4,8 @@
 #include "spectral/SpectralRange.h"
 #include "trace/IntersectionPoint.h"
 
+#include <optional>
+
 namespace PR {
 struct LightPDF {
 	float Value;
@@ -27,11 +29,16 @@ struct PR_LIB_CORE LightSampleInput {
 	const EntitySamplingInfo* SamplingInfo = nullptr;
 	bool SamplePosition					   = false;
 	bool SampleWavelength				   = false;
+	bool UseHierarchy					   = false; // Select area lights respective to SamplingInfo if available
+	std::optional<Vector3f> Sample; // Optional sample, x selects the light and yz the point on it. RND is used if not given
 
 	inline explicit LightSampleInput(Random& rnd)
 		: RND(rnd)
 	{
 	}
+
+	inline float selectionSample() const { return Sample.has_value() ? Sample.value()(0) : RND.getFloat(); }
+	inline Vector2f pointSample() const { return Sample.has_value() ? Vector2f(Sample.value()(1), Sample.value()(2)) : RND.get2D(); }
 };
 
 struct PR_LIB_CORE LightSampleOutput {
@@ -0,0 +1,162 @@
+#include "LightBVH.h"
+#include "entity/IEntity.h"
+
+#include <algorithm>
+
+namespace PR {
+LightBVH::LightBVH(const std::vector<Primitive>& primitives)
+{
+	if (primitives.empty())
+		return;
+
+	mNodes.reserve(2 * primitives.size() - 1);
+	mLeafNodes.resize(primitives.size(), PR_INVALID_ID);
+
+	std::vector<Primitive> prims = primitives;
+	build(prims, 0, prims.size(), PR_INVALID_ID);
+}
+
+LightBVH::~LightBVH()
+{
+}
+
+uint32 LightBVH::build(std::vector<Primitive>& primitives, size_t start, size_t end, uint32 parent)
+{
+	const uint32 id = (uint32)mNodes.size();
+	mNodes.emplace_back();
+
+	if (end - start == 1) {
+		const Primitive& prim = primitives[start];
+		PR_ASSERT(prim.ID < mLeafNodes.size(), "Invalid primitive id");
+
+		Node& node = mNodes[id];
+		node.Box	= prim.Box;
+		node.Cone	= prim.Cone;
+		node.Power	= prim.Power;
+		node.Parent = parent;
+		node.Left	= prim.ID;
+		node.Right	= PR_INVALID_ID;
+
+		mLeafNodes[prim.ID] = id;
+		return id;
+	}
+
+	// Split at the median of the longest axis of the centroid bounds
+	BoundingBox centroids;
+	for (size_t i = start; i < end; ++i)
+		centroids.combine(primitives[i].Box.center());
+
+	int axis = 0;
+	for (int i = 1; i < 3; ++i) {
+		if (centroids.edge(i) > centroids.edge(axis))
+			axis = i;
+	}
+
+	const size_t mid = (start + end) / 2;
+	std::nth_element(primitives.begin() + start, primitives.begin() + mid, primitives.begin() + end,
+					 [axis](const Primitive& a, const Primitive& b) { return a.Box.center()[axis] < b.Box.center()[axis]; });
+
+	const uint32 left  = build(primitives, start, mid, id);
+	const uint32 right = build(primitives, mid, end, id);
+
+	// Do not keep references into the node vector while building the children
+	Node& node	= mNodes[id];
+	node.Box	= mNodes[left].Box.combined(mNodes[right].Box);
+	node.Cone	= mNodes[left].Cone.combined(mNodes[right].Cone);
+	node.Power	= mNodes[left].Power + mNodes[right].Power;
+	node.Parent = parent;
+	node.Left	= left;
+	node.Right	= right;
+
+	return id;
+}
+
+float LightBVH::importance(const Node& node, const EntitySamplingInfo& info) const
+{
+	Vector3f d			= info.Origin - node.Box.center();
+	const float dist2	= d.squaredNorm();
+	const float radius	= node.Box.diameter() / 2;
+	const float radius2 = radius * radius;
+
+	// Clamp the distance to prevent singularities near or inside the node
+	const float cdist2 = std::max(dist2, radius2);
+	if (node.Cone.isFull() || dist2 <= radius2)
+		return node.Power / cdist2;
+
+	const float dist = std::sqrt(dist2);
+	d /= dist;
+
+	// Minimal angle between the (two-sided) cone and the direction towards the point, respecting the bounds of the node
+	const float theta  = std::acos(std::min(std::abs(node.Cone.Axis.dot(d)), 1.0f));
+	const float thetaU = std::asin(std::min(1.0f, radius / dist));
+	const float thetaP = std::max(0.0f, theta - node.Cone.Theta - thetaU);
+
+	// No emission towards the point is possible
+	if (thetaP >= PR_PI / 2)
+		return 0.0f;
+
+	return node.Power * std::cos(thetaP) / cdist2;
+}
+
+float LightBVH::childProbability(const Node& parent, uint32 child, const EntitySamplingInfo& info) const
+{
+	const float left  = importance(mNodes[parent.Left], info);
+	const float right = importance(mNodes[parent.Right], info);
+	const float sum	  = left + right;
+
+	if (sum <= PR_EPSILON)
+		return 0.0f;
+
+	return (child == parent.Left ? left : right) / sum;
+}
+
+uint32 LightBVH::sample(const EntitySamplingInfo& info, float u, float& pdf) const
+{
+	pdf = 0.0f;
+	if (mNodes.empty())
+		return PR_INVALID_ID;
+
+	pdf		   = 1.0f;
+	uint32 cur = 0;
+	while (!mNodes[cur].isLeaf()) {
+		const Node& node  = mNodes[cur];
+		const float left  = importance(mNodes[node.Left], info);
+		const float right = importance(mNodes[node.Right], info);
+		const float sum	  = left + right;
+
+		if (sum <= PR_EPSILON) {
+			pdf = 0.0f;
+			return PR_INVALID_ID;
+		}
+
+		// Reuse the random number for the next level
+		const float pLeft = left / sum;
+		if (u < pLeft) {
+			u = std::min(u / pLeft, 1.0f - PR_EPSILON);
+			pdf *= pLeft;
+			cur = node.Left;
+		} else {
+			u = std::min((u - pLeft) / (1 - pLeft), 1.0f - PR_EPSILON);
+			pdf *= 1 - pLeft;
+			cur = node.Right;
+		}
+	}
+
+	return mNodes[cur].Left;
+}
+
+float LightBVH::pdf(uint32 id, const EntitySamplingInfo& info) const
+{
+	if (id >= mLeafNodes.size())
+		return 0.0f;
+
+	float pdf	 = 1.0f;
+	uint32 child = mLeafNodes[id];
+	for (uint32 cur = mNodes[child].Parent; cur != PR_INVALID_ID; cur = mNodes[cur].Parent) {
+		pdf *= childProbability(mNodes[cur], child, info);
+		child = cur;
+	}
+
+	return pdf;
+}
+} // namespace PR
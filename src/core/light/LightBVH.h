@@ -0,0 +1,54 @@
+#pragma once
+
+#include "geometry/BoundingBox.h"
+#include "geometry/NormalCone.h"
+
+#include <vector>
+
+namespace PR {
+struct EntitySamplingInfo;
+
+/// Bounding volume hierarchy over area lights to select a light respective to a shading point.
+/// Each node bounds the position, the orientation and the power of its lights.
+/// Like area lights in general, the lights are assumed to emit on both sides of their surfaces.
+/// Based on:
+/// Conty Estevez, A. and Kulla, C. (2018). Importance Sampling of Many Lights with Adaptive Tree Splitting.
+/// Proc. ACM Comput. Graph. Interact. Tech. 1, 2, Article 25
+class PR_LIB_CORE LightBVH {
+public:
+	struct Primitive {
+		BoundingBox Box;
+		NormalCone Cone;
+		float Power;
+		uint32 ID; // Has to be unique and less than the amount of primitives
+	};
+
+	explicit LightBVH(const std::vector<Primitive>& primitives);
+	~LightBVH();
+
+	/// Returns the id of the selected primitive or PR_INVALID_ID if no primitive contributes to the given point
+	uint32 sample(const EntitySamplingInfo& info, float u, float& pdf) const;
+	float pdf(uint32 id, const EntitySamplingInfo& info) const;
+
+	inline size_t nodeCount() const { return mNodes.size(); }
+
+private:
+	struct Node {
+		BoundingBox Box;
+		NormalCone Cone;
+		float Power;
+		uint32 Parent;
+		uint32 Left;  // Primitive id if leaf
+		uint32 Right; // PR_INVALID_ID if leaf
+
+		inline bool isLeaf() const { return Right == PR_INVALID_ID; }
+	};
+
+	uint32 build(std::vector<Primitive>& primitives, size_t start, size_t end, uint32 parent);
+	float importance(const Node& node, const EntitySamplingInfo& info) const;
+	float childProbability(const Node& parent, uint32 child, const EntitySamplingInfo& info) const;
+
+	std::vector<Node> mNodes;
+	std::vector<uint32> mLeafNodes; // Node of each primitive
+};
+} // namespace PR
@@ -9,7 +9,8 @@
 namespace PR {
 
 LightSampler::LightSampler(Scene* scene, const SpectralRange& cameraSpectralRange)
-	: mInfLightSelectionProbability(0)
+	: mAreaLightCount(0)
+	, mInfLightSelectionProbability(0)
 	, mEmissiveSurfaceArea(0)
 	, mEmissiveSurfacePower(0)
 	, mEmissivePower(0)
@@ -101,6 +102,7 @@ LightSampler::LightSampler(Scene* scene, const SpectralRange& cameraSpectralRang
 	mLights.reserve(light_count);
 
 	// Add area lights
+	std::vector<LightBVH::Primitive> primitives;
 	size_t k = 0;
 	for (const auto& e : entities) {
 		if (!e->hasEmission())
@@ -113,8 +115,17 @@ LightSampler::LightSampler(Scene* scene, const SpectralRange& cameraSpectralRang
 		IEmission* emission = emissions[ems_id].get();
 		mLights.emplace_back(std::make_unique<Light>(Light::makeAreaLight(mLights.size(), e.get(), emission, intensities[k], this)));
 		mLightEntityMap[e.get()] = k;
+
+		// Keep a tiny power, such that powerless lights are still reachable
+		primitives.push_back(LightBVH::Primitive{ e->worldBoundingBox(), e->worldNormalCone(), std::max(PR_EPSILON, intensities[k]), (uint32)k });
 		++k;
 	}
+	mAreaLightCount = k;
+
+	if (!primitives.empty()) {
+		mHierarchy = std::make_unique<LightBVH>(primitives);
+		PR_LOG(L_INFO) << "Light hierarchy with " << mHierarchy->nodeCount() << " nodes" << std::endl;
+	}
 
 	// Add infinite lights (approx)
 	for (const auto& infL : inflights) {
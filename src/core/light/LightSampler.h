@@ -1,6 +1,7 @@
 #pragma once
 
 #include "Light.h"
+#include "LightBVH.h"
 #include "entity/IEntity.h"
 #include "math/Distribution1D.h"
 
@@ -20,8 +21,9 @@ public:
 	inline const Light* sample(float rnd, float& pdf) const;
 	inline std::pair<const Light*, float> sample(const LightSampleInput& in, LightSampleOutput& out, const RenderTileSession& session) const;
 
-	inline float pdfLightSelection(const Light* light) const;
-	inline float pdfEntitySelection(const IEntity* entity) const;
+	/// Selection probability of the given light. If hierarchyInfo is given, the probability respective to the light hierarchy is returned
+	inline float pdfLightSelection(const Light* light, const EntitySamplingInfo* hierarchyInfo = nullptr) const;
+	inline float pdfEntitySelection(const IEntity* entity, const EntitySamplingInfo* hierarchyInfo = nullptr) const;
 	inline LightPDF pdfPosition(const IEntity* entity, const Vector3f& posOnLight, const EntitySamplingInfo* info = nullptr) const;
 	inline float pdfDirection(const Vector3f& dir, const IEntity* entity, float cosLight = 1.0f) const;
 	inline const Light* light(const IEntity* entity) const;
@@ -31,6 +33,7 @@ public:
 
 	inline size_t emissiveEntityCount() const { return mLightEntityMap.size(); }
 	inline size_t lightCount() const { return mLights.size(); }
+	inline const LightBVH* hierarchy() const { return mHierarchy.get(); }
 
 	inline float emissiveSurfaceArea() const { return mEmissiveSurfaceArea; }
 	inline float emissiveSurfacePower() const { return mEmissiveSurfacePower; }
@@ -42,12 +45,16 @@ public:
 	inline ISpectralMapper* wavelengthSampler() const { return mWavelengthSampler.get(); }
 
 private:
+	inline float pdfAreaLightSelection(uint32 lightID, const EntitySamplingInfo* hierarchyInfo) const;
+
 	using LightEntityMap = std::unordered_map<const IEntity*, size_t>;
 
 	LightList mLights;
 	LightEntityMap mLightEntityMap;
 	std::vector<Light*> mInfLights; // Special purpose cache, as we expect inf lights be way less then area lights
 	std::unique_ptr<Distribution1D> mSelector;
+	std::unique_ptr<LightBVH> mHierarchy; // Only area lights
+	size_t mAreaLightCount;
 	float mInfLightSelectionProbability;
 	float mEmissiveSurfaceArea;
 	float mEmissiveSurfacePower;
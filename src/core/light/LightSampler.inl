@@ -14,8 +14,25 @@ inline const Light* LightSampler::sample(float rnd, float& pdf) const
 inline std::pair<const Light*, float> LightSampler::sample(const LightSampleInput& in, LightSampleOutput& out, const RenderTileSession& session) const
 {
 	if (mSelector) {
+		float u = in.selectionSample();
+
+		// Select area lights respective to the shading point, while infinite lights keep their global probability
+		if (mHierarchy && in.UseHierarchy && in.SamplingInfo) {
+			const float areaProb = (*mSelector)[mAreaLightCount]; // Area lights are first in the CDF
+			if (u < areaProb) {
+				float pdf;
+				const uint32 id = mHierarchy->sample(*in.SamplingInfo, std::min(u / areaProb, 1.0f - PR_EPSILON), pdf);
+				if (id >= mAreaLightCount)
+					return { nullptr, 0.0f };
+
+				const Light* l = mLights[id].get();
+				l->sample(in, out, session);
+				return { l, areaProb * pdf };
+			}
+		}
+
 		float pdf, rem;
-		const size_t id = mSelector->sampleDiscrete(in.RND.getFloat(), pdf, &rem);
+		const size_t id = mSelector->sampleDiscrete(u, pdf, &rem);
 		if (id < mLights.size()) {
 			const Light* l = mLights[id].get();
 			l->sample(in, out, session);
@@ -27,15 +44,27 @@ inline std::pair<const Light*, float> LightSampler::sample(const LightSampleInpu
 	return { nullptr, 0.0f };
 }
 
-inline float LightSampler::pdfLightSelection(const Light* light) const
+inline float LightSampler::pdfAreaLightSelection(uint32 lightID, const EntitySamplingInfo* hierarchyInfo) const
+{
+	if (!mHierarchy || !hierarchyInfo)
+		return mSelector->discretePdf(lightID);
+
+	const float areaProb = (*mSelector)[mAreaLightCount]; // Area lights are first in the CDF
+	return areaProb * mHierarchy->pdf(lightID, *hierarchyInfo);
+}
+
+inline float LightSampler::pdfLightSelection(const Light* light, const EntitySamplingInfo* hierarchyInfo) const
 {
 	PR_ASSERT(mSelector, "Expected initialized light sampler"); // If you get here!
 	PR_ASSERT(light, "Invalid light given");
 	PR_ASSERT(light->lightID() < mLights.size(), "Light not member of sampler");
-	return mSelector->discretePdf(light->lightID());
+	if (light->lightID() < mAreaLightCount)
+		return pdfAreaLightSelection(light->lightID(), hierarchyInfo);
+	else
+		return mSelector->discretePdf(light->lightID());
 }
 
-float LightSampler::pdfEntitySelection(const IEntity* entity) const
+float LightSampler::pdfEntitySelection(const IEntity* entity, const EntitySamplingInfo* hierarchyInfo) const
 {
 	if (!entity)
 		return mInfLightSelectionProbability;
@@ -44,7 +73,7 @@ float LightSampler::pdfEntitySelection(const IEntity* entity) const
 		return 0.0f;
 
 	const uint32 lightID = mLightEntityMap.at(entity);
-	return mSelector->discretePdf(lightID);
+	return pdfAreaLightSelection(lightID, hierarchyInfo);
 }
 
 LightPDF LightSampler::pdfPosition(const IEntity* entity, const Vector3f& posOnLight, const EntitySamplingInfo* info) const
@@ -5,6 +5,8 @@
 #include "Random.h"
 #include "shader/ShadingContext.h"
 
+#include <optional>
+
 namespace PR {
 
 struct PR_LIB_CORE MaterialBaseOutput {
@@ -41,6 +43,10 @@ struct PR_LIB_CORE MaterialSampleInput {
 	MaterialSampleContext Context;
 	PR::ShadingContext ShadingContext;
 	Random& RND;
+	std::optional<Vector2f> Sample; // Optional sample for the primary (direction) decision. RND is used if not given
+
+	/// Primary 2d sample of the material. Should be requested at most once per sample call
+	inline Vector2f sample2D() const { return Sample.has_value() ? Sample.value() : RND.get2D(); }
 
 	inline MaterialSampleInput(Random& rnd)
 		: RND(rnd)
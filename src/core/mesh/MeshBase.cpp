@@ -1,5 +1,6 @@
 #include "MeshBase.h"
 #include "Profiler.h"
+#include "math/Distribution1D.h"
 #include "serialization/FileSerializer.h"
 
 namespace PR {
@@ -170,6 +171,14 @@ BoundingBox MeshBase::constructBoundingBox() const
 	return box;
 }
 
+void MeshBase::buildFaceSamplingDistribution()
+{
+	PR_PROFILE_THIS;
+
+	mFaceSamplingDistribution = std::make_unique<Distribution1D>(faceCount());
+	mFaceSamplingDistribution->generate([&](size_t f) { return faceArea(f, Eigen::Affine3f::Identity()); });
+}
+
 void MeshBase::serialize(Serializer& serializer)
 {
 	serializer | mInfo.Features.value
@@ -200,6 +209,8 @@ size_t MeshBase::memoryFootprint() const
 	}
 	size += vectorSize(mMaterialSlots);
 	size += vectorSize(mFaceIndexOffset);
+	if (mFaceSamplingDistribution)
+		size += mFaceSamplingDistribution->numberOfEntries() * sizeof(float);
 	return size;
 }
 } // namespace PR
@@ -4,10 +4,12 @@
 #include "mesh/MeshInfo.h"
 #include "serialization/ISerializable.h"
 
+#include <memory>
 #include <unordered_map>
 #include <vector>
 
 namespace PR {
+class Distribution1D;
 class Normal;
 class UV;
 class Vertex;
@@ -91,6 +93,12 @@ public:
 
 	BoundingBox constructBoundingBox() const;
 
+	/// Build a distribution to sample faces proportional to their local area.
+	/// Should be called once before rendering, as it is not thread safe
+	void buildFaceSamplingDistribution();
+	/// Returns null if buildFaceSamplingDistribution() was not called beforehand
+	inline const Distribution1D* faceSamplingDistribution() const { return mFaceSamplingDistribution.get(); }
+
 	// Modifiers
 	void buildSmoothNormals();
 	void flipNormals();
@@ -111,6 +119,8 @@ private:
 	std::vector<uint32> mMaterialSlots;
 
 	std::vector<uint32> mFaceIndexOffset; // Only triangles and quads supported
+
+	std::unique_ptr<Distribution1D> mFaceSamplingDistribution;
 };
 } // namespace PR
 
@@ -34,6 +34,7 @@ enum AOV1D {
 enum AOVCounter {
 	AOV_SampleCount = 0,
 	AOV_Feedback,
+	AOV_PixelSampleCount, // Camera samples per pixel, which differ if adaptive sampling is enabled
 
 	AOV_COUNTER_COUNT
 };
@@ -18,6 +18,9 @@ public:
 	virtual void commitCustom1D(uint32 aov_id, const OutputCustom1DEntry* entries, size_t entrycount)										 = 0;
 	virtual void commitCustomCounter(uint32 aov_id, const OutputCustomCounterEntry* entries, size_t entrycount)								 = 0;
 
+	/// Reuse the device for a region of the given size, which is never larger than the size the device was created with
+	virtual void resize(const Size2i& size) = 0;
+
 	virtual void beforeMerge() {}
 };
 } // namespace PR
\ No newline at end of file
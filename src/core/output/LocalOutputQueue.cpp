@@ -4,18 +4,17 @@
 #include "Profiler.h"
 
 namespace PR {
-constexpr size_t AVG_PATH_LENGTH = 8;
-constexpr float MEM_SAFE_FACTOR	 = 0.9f;
+constexpr float MEM_SAFE_FACTOR = 0.9f;
 LocalOutputQueue::LocalOutputQueue(OutputSystem* system, StreamPipeline* pipeline, size_t max_entries, size_t trigger_threshold)
 	: mSystem(system)
 	, mSpectralQueue(max_entries)
 	, mSPQueue(max_entries)
 	, mFeedbackQueue(max_entries)
-	, mLightPathData(max_entries * (AVG_PATH_LENGTH + 1) * sizeof(uint32))
+	, mLPEMatchData(2 * max_entries * std::max<size_t>(1, system->lpeGroups().size()) * sizeof(uint64)) // Spectral and shading point entries
 	, mPipeline(pipeline)
 	, mMaxEntries(max_entries)
 	, mTriggerThreshold(std::min(trigger_threshold, max_entries))
-	, mMemTriggerThreshold(mLightPathData.maxMemory() * MEM_SAFE_FACTOR)
+	, mMemTriggerThreshold(mLPEMatchData.maxMemory() * MEM_SAFE_FACTOR)
 {
 	// TODO: Better get the maximum entry in the map and use that!
 	for (size_t i = 0; i < system->customSpectralChannels().size(); ++i)
@@ -78,7 +77,7 @@ void LocalOutputQueue::flush()
 	for (auto& q : mCustomCounterQueues)
 		q.It = 0;
 
-	mLightPathData.freeAll();
+	mLPEMatchData.freeAll();
 
 	++mFlushCount;
 }
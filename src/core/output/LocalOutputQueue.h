@@ -1,14 +1,15 @@
 #pragma once
 
 #include "OutputData.h"
+#include "OutputSystem.h"
 #include "memory/MemoryStack.h"
 #include "path/LightPath.h"
 
+#include <algorithm>
 #include <atomic>
 
 namespace PR {
 class LocalOutputSystem;
-class OutputSystem;
 class StreamPipeline;
 
 class PR_LIB_CORE LocalOutputQueue {
@@ -18,6 +19,9 @@ public:
 
 	inline void pushSpectralFragment(const Point2i& p, const SpectralBlob& mis, const SpectralBlob& importance, const SpectralBlob& radiance,
 									 const SpectralBlob& wavelengths, bool isMono, uint32 rayGroupID, const LightPath& path);
+	/// Push a spectral fragment with already matched LPEs. The matches are copied and have to contain lpeMatchCount() entries
+	inline void pushSpectralFragment(const Point2i& p, const SpectralBlob& mis, const SpectralBlob& importance, const SpectralBlob& radiance,
+									 const SpectralBlob& wavelengths, bool isMono, uint32 rayGroupID, const uint64* matches);
 	inline void pushSPFragment(const Point2i& p, const IntersectionPoint& pt, const LightPath& path);
 	inline void pushFeedbackFragment(const Point2i& p, uint32 feedback);
 
@@ -28,6 +32,11 @@ public:
 
 	inline bool isReadyToCommit() const;
 
+	/// Amount of match masks per fragment, one for each LPE group
+	inline size_t lpeMatchCount() const { return mSystem->lpeGroups().size(); }
+	/// Match the path against all LPE groups. The given buffer has to contain lpeMatchCount() entries
+	inline void matchLPE(const LightPath& path, uint64* matches) const;
+
 	void commitTo(LocalOutputSystem* localSystem) const;
 	void flush();
 
@@ -45,7 +54,11 @@ public:
 	inline size_t memoryTriggerThreshold() const { return mMemTriggerThreshold; }
 
 private:
-	inline const uint32* pushPath(const LightPath& path);
+	inline void addSpectralEntry(const Point2i& p, const SpectralBlob& mis, const SpectralBlob& importance, const SpectralBlob& radiance,
+								 const SpectralBlob& wavelengths, bool isMono, uint32 rayGroupID, const uint64* matches);
+	inline uint64* allocateLPEMatches();
+	inline const uint64* pushLPEMatches(const LightPath& path);
+	inline const uint64* pushLPEMatches(const uint64* matches);
 
 	template <typename T>
 	struct Queue {
@@ -78,7 +91,7 @@ private:
 	std::vector<Queue<OutputCustom1DEntry>> mCustom1DQueues;
 	std::vector<Queue<OutputCustomCounterEntry>> mCustomCounterQueues;
 
-	MemoryStack mLightPathData;
+	MemoryStack mLPEMatchData;
 
 	StreamPipeline* mPipeline;
 
@@ -8,6 +8,20 @@
 namespace PR {
 inline void LocalOutputQueue::pushSpectralFragment(const Point2i& p, const SpectralBlob& mis, const SpectralBlob& importance, const SpectralBlob& radiance,
 												   const SpectralBlob& wavelengths, bool isMono, uint32 rayGroupID, const LightPath& path)
+{
+	PR_ASSERT(!mSpectralQueue.isFull(), "Spectral entries are exhausted");
+	addSpectralEntry(p, mis, importance, radiance, wavelengths, isMono, rayGroupID, pushLPEMatches(path));
+}
+
+inline void LocalOutputQueue::pushSpectralFragment(const Point2i& p, const SpectralBlob& mis, const SpectralBlob& importance, const SpectralBlob& radiance,
+												   const SpectralBlob& wavelengths, bool isMono, uint32 rayGroupID, const uint64* matches)
+{
+	PR_ASSERT(!mSpectralQueue.isFull(), "Spectral entries are exhausted");
+	addSpectralEntry(p, mis, importance, radiance, wavelengths, isMono, rayGroupID, pushLPEMatches(matches));
+}
+
+inline void LocalOutputQueue::addSpectralEntry(const Point2i& p, const SpectralBlob& mis, const SpectralBlob& importance, const SpectralBlob& radiance,
+											   const SpectralBlob& wavelengths, bool isMono, uint32 rayGroupID, const uint64* matches)
 {
 #ifdef PR_CHECK_NANS
 	PR_ASSERT(!mis.hasNaN(), "Given MIS term has NaNs");
@@ -24,16 +38,14 @@ inline void LocalOutputQueue::pushSpectralFragment(const Point2i& p, const Spect
 	PR_ASSERT(!((importance < -PR_EPSILON).any()), "Given Importance term has Negatives");
 	PR_ASSERT(!((radiance < -PR_EPSILON).any()), "Given Radiance term has Negatives");
 #endif
-	PR_ASSERT(!mSpectralQueue.isFull(), "Spectral entries are exhausted");
-	const uint32* pathEntry = pushPath(path);
-	mSpectralQueue.add(OutputSpectralEntry{ p, mis, importance, radiance, wavelengths, isMono ? (uint32)OutputSpectralEntryFlag::Mono : 0, rayGroupID, pathEntry });
+	mSpectralQueue.add(OutputSpectralEntry{ p, mis, importance, radiance, wavelengths, isMono ? (uint32)OutputSpectralEntryFlag::Mono : 0, rayGroupID, matches });
 }
 
 inline void LocalOutputQueue::pushSPFragment(const Point2i& p, const IntersectionPoint& pt, const LightPath& path)
 {
 	PR_ASSERT(!mSPQueue.isFull(), "IntersectionPoint entries are exhausted");
-	const uint32* pathEntry = pushPath(path);
-	mSPQueue.add(OutputShadingPointEntry{ p, pt, pathEntry });
+	const uint64* matches = pushLPEMatches(path);
+	mSPQueue.add(OutputShadingPointEntry{ p, pt, matches });
 }
 
 inline void LocalOutputQueue::pushFeedbackFragment(const Point2i& p, uint32 feedback)
@@ -70,14 +82,44 @@ inline void LocalOutputQueue::pushCustomCounterFragment(uint32 queueID, const Po
 	mCustomCounterQueues[queueID].add(OutputCustomCounterEntry{ p, value });
 }
 
-inline const uint32* LocalOutputQueue::pushPath(const LightPath& path)
+inline void LocalOutputQueue::matchLPE(const LightPath& path, uint64* matches) const
+{
+	// Paths tracking the automata states already know the result, all others have to be matched once here
+	const auto& groups = mSystem->lpeGroups();
+	const bool tracked = path.isTrackingExpressionStates(&groups);
+	for (size_t i = 0; i < groups.size(); ++i) {
+		if (tracked && groups[i].isBuilt())
+			matches[i] = groups[i].stateMask(path.expressionState(i));
+		else
+			matches[i] = groups[i].match(path);
+	}
+}
+
+inline uint64* LocalOutputQueue::allocateLPEMatches()
+{
+	const size_t req_size = lpeMatchCount() * sizeof(uint64);
+	PR_ASSERT(mLPEMatchData.usedMemory() + req_size <= mLPEMatchData.maxMemory(), "LPE match buffer is full");
+	return (uint64*)mLPEMatchData.allocate(req_size, alignof(uint64));
+}
+
+inline const uint64* LocalOutputQueue::pushLPEMatches(const LightPath& path)
+{
+	if (lpeMatchCount() == 0)
+		return nullptr;
+
+	uint64* matches = allocateLPEMatches();
+	matchLPE(path, matches);
+	return matches;
+}
+
+inline const uint64* LocalOutputQueue::pushLPEMatches(const uint64* matches)
 {
-	const size_t req_size = path.packedSizeRequirement();
-	PR_ASSERT(mLightPathData.usedMemory() + req_size < mLightPathData.maxMemory(), "Lightpath buffer is full");
+	if (lpeMatchCount() == 0 || !matches)
+		return nullptr;
 
-	uint8* start = (uint8*)mLightPathData.allocate(req_size);
-	path.toPacked(start, req_size);
-	return (uint32*)start;
+	uint64* copy = allocateLPEMatches();
+	std::copy_n(matches, lpeMatchCount(), copy);
+	return copy;
 }
 
 inline bool LocalOutputQueue::isReadyToCommit() const
@@ -91,7 +133,7 @@ inline bool LocalOutputQueue::isReadyToCommit() const
 	if (mFeedbackQueue.isReady(mTriggerThreshold))
 		return true;
 
-	if (mLightPathData.usedMemory() >= mMemTriggerThreshold)
+	if (mLPEMatchData.usedMemory() >= mMemTriggerThreshold)
 		return true;
 
 	for (const auto& q : mCustomSpectralQueues)
@@ -5,6 +5,7 @@ namespace PR {
 LocalOutputSystem::LocalOutputSystem(const RenderTile* tile, const OutputSystem* parent, const Size2i& localSize)
 	: mTile(tile)
 	, mParent(parent)
+	, mMaxLocalSize(localSize)
 	, mLocalSize(localSize)
 {
 }
@@ -13,6 +14,16 @@ LocalOutputSystem::~LocalOutputSystem()
 {
 }
 
+void LocalOutputSystem::reuse(const RenderTile* tile, const Size2i& localSize)
+{
+	PR_ASSERT(localSize.Width <= mMaxLocalSize.Width && localSize.Height <= mMaxLocalSize.Height, "Local size has to fit into the initial size");
+
+	mTile	   = tile;
+	mLocalSize = localSize;
+	for (const auto& device : mLocalOutputDevices)
+		device->resize(localSize);
+}
+
 void LocalOutputSystem::clear(bool force)
 {
 	for (const auto& device : mLocalOutputDevices)
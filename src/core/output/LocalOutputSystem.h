@@ -18,6 +18,10 @@ public:
 
 	inline const Size2i& globalSize() const { return mParent->size(); }
 	inline const Size2i& localSize() const { return mLocalSize; }
+	inline const Size2i& maxLocalSize() const { return mMaxLocalSize; }
+
+	/// Reuse the system and all its devices for another tile. Buffers are kept, but have to be cleared by the caller
+	void reuse(const RenderTile* tile, const Size2i& localSize);
 
 	void clear(bool force = false);
 
@@ -39,7 +43,8 @@ protected:
 private:
 	const RenderTile* mTile;
 	const OutputSystem* mParent;
-	const Size2i mLocalSize;
+	const Size2i mMaxLocalSize;
+	Size2i mLocalSize;
 	std::vector<std::shared_ptr<LocalOutputDevice>> mLocalOutputDevices;
 };
 } // namespace PR
@@ -18,7 +18,7 @@ struct PR_LIB_CORE OutputSpectralEntry {
 	SpectralBlob Wavelengths;
 	OutputSpectralEntryFlags Flags;
 	uint32 RayGroupID;
-	const uint32* Path;
+	const uint64* LPEMatches; // Match mask for each LPE group of the output system. Null if no LPEs are registered
 
 	inline SpectralBlob contribution() const { return MIS * Importance * Radiance; }
 	inline float contribution(size_t index) const { return MIS[index] * Importance[index] * Radiance[index]; }
@@ -27,7 +27,7 @@ struct PR_LIB_CORE OutputSpectralEntry {
 struct PR_LIB_CORE OutputShadingPointEntry {
 	Point2i Position;
 	IntersectionPoint SP;
-	const uint32* Path;
+	const uint64* LPEMatches; // Match mask for each LPE group of the output system. Null if no LPEs are registered
 };
 
 struct PR_LIB_CORE OutputFeedbackEntry {
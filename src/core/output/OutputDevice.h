@@ -4,6 +4,7 @@
 #include "OutputData.h"
 
 namespace PR {
+class ConvergenceMap;
 class LocalOutputDevice;
 class LightPathExpression;
 
@@ -19,6 +20,10 @@ public:
 	virtual void enableCounterChannel(AOVCounter var)	= 0;
 	virtual void enable3DChannel(AOV3D var)				= 0;
 	virtual void enableSpectralChannel(AOVSpectral var) = 0;
+	/// Tiles advance iterations independently, therefore local outputs have to be blended at merge time instead of the end of an iteration
+	virtual void enableAsyncIterations() = 0;
+	/// Converged pixels of the map are not updated anymore and error estimates have to be provided at the end of each iteration
+	virtual void enableAdaptiveSampling(ConvergenceMap* map) = 0;
 
 	virtual void registerLPE1DChannel(AOV1D var, const LightPathExpression& expr, uint32 id)			 = 0;
 	virtual void registerLPECounterChannel(AOVCounter var, const LightPathExpression& expr, uint32 id)	 = 0;
@@ -78,35 +78,76 @@ void OutputSystem::enableSpectralChannel(AOVSpectral var)
 		device->enableSpectralChannel(var);
 }
 
+void OutputSystem::enableAsyncIterations()
+{
+	for (const auto& device : mOutputDevices)
+		device->enableAsyncIterations();
+}
+
+void OutputSystem::enableAdaptiveSampling(ConvergenceMap* map)
+{
+	for (const auto& device : mOutputDevices)
+		device->enableAdaptiveSampling(map);
+}
+
+LightPathExpression OutputSystem::assignLPEGroup(const LightPathExpression& expr)
+{
+	// Try to extend the last group, as long as its product automaton stays small
+	bool extended = false;
+	size_t bit	  = 0;
+	if (!mLPEGroups.empty() && !mLPEGroups.back().isFull()) {
+		LightPathExpressionSet candidate = mLPEGroups.back();
+		bit								 = candidate.add(expr);
+		if (candidate.build()) {
+			mLPEGroups.back() = std::move(candidate);
+			extended		  = true;
+		}
+	}
+
+	if (!extended) {
+		mLPEGroups.emplace_back();
+		bit = mLPEGroups.back().add(expr);
+		mLPEGroups.back().build();
+	}
+
+	LightPathExpression slotted = expr;
+	slotted.setMatchSlot(static_cast<uint32>(mLPEGroups.size() - 1), static_cast<uint32>(bit));
+	return slotted;
+}
+
 uint32 OutputSystem::registerLPE1DChannel(AOV1D var, const LightPathExpression& expr)
 {
-	const uint32 id = mLPE1DCount++;
+	const uint32 id					  = mLPE1DCount++;
+	const LightPathExpression slotted = assignLPEGroup(expr);
 	for (const auto& device : mOutputDevices)
-		device->registerLPE1DChannel(var, expr, id);
+		device->registerLPE1DChannel(var, slotted, id);
 	return id;
 }
 
 uint32 OutputSystem::registerLPECounterChannel(AOVCounter var, const LightPathExpression& expr)
 {
-	const uint32 id = mLPECounterCount++;
+	const uint32 id					  = mLPECounterCount++;
+	const LightPathExpression slotted = assignLPEGroup(expr);
 	for (const auto& device : mOutputDevices)
-		device->registerLPECounterChannel(var, expr, id);
+		device->registerLPECounterChannel(var, slotted, id);
 	return id;
 }
 
 uint32 OutputSystem::registerLPE3DChannel(AOV3D var, const LightPathExpression& expr)
 {
-	const uint32 id = mLPE3DCount++;
+	const uint32 id					  = mLPE3DCount++;
+	const LightPathExpression slotted = assignLPEGroup(expr);
 	for (const auto& device : mOutputDevices)
-		device->registerLPE3DChannel(var, expr, id);
+		device->registerLPE3DChannel(var, slotted, id);
 	return id;
 }
 
 uint32 OutputSystem::registerLPESpectralChannel(AOVSpectral var, const LightPathExpression& expr)
 {
-	const uint32 id = mLPESpectralCount++;
+	const uint32 id					  = mLPESpectralCount++;
+	const LightPathExpression slotted = assignLPEGroup(expr);
 	for (const auto& device : mOutputDevices)
-		device->registerLPESpectralChannel(var, expr, id);
+		device->registerLPESpectralChannel(var, slotted, id);
 	return id;
 }
 
@@ -2,13 +2,14 @@
 
 #include "AOV.h"
 #include "PR_Config.h"
+#include "path/LightPathExpressionSet.h"
 
 #include <functional>
 
 namespace PR {
+class ConvergenceMap;
 class OutputDevice;
 class LocalOutputSystem;
-class LightPathExpression;
 
 class RenderTile;
 struct OutputSpectralEntry;
@@ -54,12 +55,18 @@ public:
 	void enableCounterChannel(AOVCounter var);
 	void enable3DChannel(AOV3D var);
 	void enableSpectralChannel(AOVSpectral var);
+	void enableAsyncIterations();
+	void enableAdaptiveSampling(ConvergenceMap* map);
 
 	uint32 registerLPE1DChannel(AOV1D var, const LightPathExpression& expr);
 	uint32 registerLPECounterChannel(AOVCounter var, const LightPathExpression& expr);
 	uint32 registerLPE3DChannel(AOV3D var, const LightPathExpression& expr);
 	uint32 registerLPESpectralChannel(AOVSpectral var, const LightPathExpression& expr);
 
+	/// All registered LPEs combined into groups of product automata.
+	/// Each path is matched (or tracked) once per group and the result is stored as a bitmask per group
+	inline const std::vector<LightPathExpressionSet>& lpeGroups() const { return mLPEGroups; }
+
 	uint32 registerCustom1DChannel(const std::string& str);
 	uint32 registerCustomCounterChannel(const std::string& str);
 	uint32 registerCustom3DChannel(const std::string& str);
@@ -82,6 +89,8 @@ public:
 	inline const std::vector<OutputFeedbackCallback>& feedbackCallbacks() const { return mFeedbackCallbacks; }
 
 private:
+	LightPathExpression assignLPEGroup(const LightPathExpression& expr);
+
 	const Size2i mSize;
 	std::vector<std::shared_ptr<OutputDevice>> mOutputDevices;
 	CustomNameMap mCustom1DChannelMap;
@@ -93,6 +102,7 @@ private:
 	uint32 mLPE3DCount;
 	uint32 mLPECounterCount;
 	uint32 mLPESpectralCount;
+	std::vector<LightPathExpressionSet> mLPEGroups;
 
 	std::vector<OutputSpectralCallback> mSpectralCallbacks;
 	std::vector<OutputFeedbackCallback> mFeedbackCallbacks;
@@ -75,7 +75,7 @@ bool Automaton::build(const std::shared_ptr<RegExpr>& expr)
 
 					mIB_Allowed[index]		   = true;
 					mIB_LabelBlockStart[index] = lblAddr;
-					mIB_LabelBlockStart[index] = mLB_LabelIndices.size() - lblAddr;
+					mIB_LabelBlockSize[index]  = mLB_LabelIndices.size() - lblAddr;
 				}
 			}
 		}
@@ -95,7 +95,7 @@ size_t Automaton::nextState(size_t currentState, const LightPathToken& token, bo
 			return mIB_EmptyNextState[index];
 		} else if (token.LabelIndex != 0) {
 			const size_t saddr = mIB_LabelBlockStart[index];
-			for (size_t i = 0; mIB_LabelBlockSize[index] != 0; ++i) {
+			for (size_t i = 0; i < mIB_LabelBlockSize[index]; ++i) {
 				if (mLB_LabelIndices[saddr + i] == token.LabelIndex) {
 					success = true;
 					return mLB_NextStates[saddr + i];
@@ -139,7 +139,7 @@ std::string Automaton::dumpTable() const
 					stream << std::endl;
 
 					size_t saddr = mIB_LabelBlockStart[index];
-					for (uint32 l = 0; mIB_LabelBlockSize[index] != 0; ++l) {
+					for (uint32 l = 0; l < mIB_LabelBlockSize[index]; ++l) {
 						stream << "  - " << mLB_LabelIndices[saddr + l] << " -> " << mLB_NextStates[saddr + l] << std::endl;
 					}
 				}
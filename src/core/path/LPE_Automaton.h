@@ -34,8 +34,13 @@ public:
 
 	std::string dumpTable() const;
 
-private:
+	// Stepwise interface
+	inline size_t startingState() const { return mStartingState; }
+	inline bool isFinal(size_t state) const { return mSB_IsFinal[state]; }
 	size_t nextState(size_t currentState, const LightPathToken& token, bool& success) const;
+	inline const std::vector<size_t>& labelIndices() const { return mLB_LabelIndices; }
+
+private:
 
 	// SoA
 	// {Label Block}
@@ -3,10 +3,31 @@
 namespace PR {
 LightPath::LightPath(size_t expectedSize)
 	: mCurrentPos(0)
+	, mExpressionSets(nullptr)
 {
 	mTokens.reserve(expectedSize);
 }
 
+void LightPath::trackExpressionStates(const std::vector<LightPathExpressionSet>* sets)
+{
+	mExpressionSets = sets;
+	if (!mExpressionSets) {
+		mExpressionStates.clear();
+		return;
+	}
+
+	const size_t setCount = mExpressionSets->size();
+	mExpressionStates.resize((mTokens.size() + 1) * setCount);
+	for (size_t i = 0; i < setCount; ++i)
+		mExpressionStates[i] = (*mExpressionSets)[i].isBuilt() ? (*mExpressionSets)[i].startingState() : 0;
+
+	// Catch up with the tokens already available
+	const size_t size = mCurrentPos;
+	for (mCurrentPos = 1; mCurrentPos <= size; ++mCurrentPos)
+		advanceExpressionStates();
+	mCurrentPos = size;
+}
+
 LightPath LightPath::createCDL(size_t diffuseCount)
 {
 	LightPath path(2 + diffuseCount);
@@ -1,5 +1,6 @@
 #pragma once
 
+#include "LightPathExpressionSet.h"
 #include "LightPathToken.h"
 #include <vector>
 
@@ -52,9 +53,21 @@ public:
 	inline size_t packedSizeRequirement() const;
 	inline static size_t packedSizeRequirement(size_t length);
 
+	/// Advance the product automata of the given expression sets while tokens are added, such that no matching is required afterwards.
+	/// Only built sets are tracked. The sets have to outlive the path. Use nullptr to stop tracking
+	void trackExpressionStates(const std::vector<LightPathExpressionSet>* sets);
+	inline bool isTrackingExpressionStates(const std::vector<LightPathExpressionSet>* sets) const { return sets && mExpressionSets == sets; }
+	/// Current state of the product automaton of the given set. Only available if tracked
+	inline uint32 expressionState(size_t set) const;
+
 private:
+	inline void advanceExpressionStates();
+
 	std::vector<LightPathToken> mTokens;
 	size_t mCurrentPos;
+
+	const std::vector<LightPathExpressionSet>* mExpressionSets;
+	std::vector<uint32> mExpressionStates; // (Tokens + 1) * Sets, such that popping tokens requires no work
 };
 } // namespace PR
 
@@ -9,6 +9,8 @@ inline void LightPath::addToken(const LightPathToken& token)
 		mTokens[mCurrentPos] = token;
 		++mCurrentPos;
 	}
+
+	advanceExpressionStates();
 }
 
 inline void LightPath::addToken(LightPathToken&& token)
@@ -20,6 +22,8 @@ inline void LightPath::addToken(LightPathToken&& token)
 		mTokens[mCurrentPos] = std::move(token);
 		++mCurrentPos;
 	}
+
+	advanceExpressionStates();
 }
 
 inline void LightPath::popToken()
@@ -67,6 +71,30 @@ LightPathToken LightPath::token(int index) const
 	return mTokens[index];
 }
 
+inline void LightPath::advanceExpressionStates()
+{
+	if (!mExpressionSets)
+		return;
+
+	const size_t setCount = mExpressionSets->size();
+	const size_t prevRow  = (mCurrentPos - 1) * setCount;
+	const size_t nextRow  = prevRow + setCount;
+	if (mExpressionStates.size() < nextRow + setCount)
+		mExpressionStates.resize(nextRow + setCount);
+
+	const LightPathToken& token = mTokens[mCurrentPos - 1];
+	for (size_t i = 0; i < setCount; ++i) {
+		const LightPathExpressionSet& set = (*mExpressionSets)[i];
+		mExpressionStates[nextRow + i]	  = set.isBuilt() ? set.nextState(mExpressionStates[prevRow + i], token) : 0;
+	}
+}
+
+inline uint32 LightPath::expressionState(size_t set) const
+{
+	PR_ASSERT(mExpressionSets && set < mExpressionSets->size(), "Expected valid tracked expression set");
+	return mExpressionStates[mCurrentPos * mExpressionSets->size() + set];
+}
+
 inline size_t LightPath::packedSizeRequirement(size_t length)
 {
 	return (length + 1) * sizeof(uint32);
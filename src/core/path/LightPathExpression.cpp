@@ -4,9 +4,15 @@
 #include "Logger.h"
 
 namespace PR {
-LightPathExpression::LightPathExpression() {}
+LightPathExpression::LightPathExpression()
+	: mMatchGroup(PR_INVALID_ID)
+	, mMatchBit(0)
+{
+}
 
 LightPathExpression::LightPathExpression(const std::string& str)
+	: mMatchGroup(PR_INVALID_ID)
+	, mMatchBit(0)
 {
 	parseString(str);
 }
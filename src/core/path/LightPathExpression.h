@@ -11,6 +11,8 @@ class LightPath;
 class LightPathView;
 
 class PR_LIB_CORE LightPathExpression {
+	friend class LightPathExpressionSet;
+
 public:
 	LightPathExpression();
 	explicit LightPathExpression(const std::string& str);
@@ -22,6 +24,24 @@ public:
 
 	inline bool isValid() const { return mAutomaton != nullptr; }
 
+	/// Position of the expression inside the per group match masks of the output system.
+	/// Only available for expressions registered to the output system
+	inline bool hasMatchSlot() const { return mMatchGroup != PR_INVALID_ID; }
+	inline uint32 matchGroup() const { return mMatchGroup; }
+	inline uint32 matchBit() const { return mMatchBit; }
+	inline void setMatchSlot(uint32 group, uint32 bit)
+	{
+		mMatchGroup = group;
+		mMatchBit	= bit;
+	}
+
+	/// Lookup the already matched result in the given per group match masks
+	inline bool isMatched(const uint64* groupMasks) const
+	{
+		PR_ASSERT(hasMatchSlot(), "Expected expression registered to the output system");
+		return (groupMasks[mMatchGroup] >> mMatchBit) & 0x1;
+	}
+
 	std::string dumpTable() const;
 
 	static std::string generateTableString(const std::string& expr);
@@ -29,5 +49,7 @@ public:
 
 private:
 	std::shared_ptr<LPE::Automaton> mAutomaton;
+	uint32 mMatchGroup;
+	uint32 mMatchBit;
 };
 } // namespace PR
\ No newline at end of file
@@ -0,0 +1,188 @@
+#include "LightPathExpressionSet.h"
+#include "LPE_Automaton.h"
+
+#include <algorithm>
+#include <array>
+#include <map>
+
+namespace PR {
+LightPathExpressionSet::LightPathExpressionSet()
+	: mSymbolCount(0)
+{
+}
+
+LightPathExpressionSet::~LightPathExpressionSet()
+{
+}
+
+size_t LightPathExpressionSet::add(const LightPathExpression& expr)
+{
+	PR_ASSERT(!isFull(), "Expected non full expression set");
+	mAutomata.push_back(expr.mAutomaton);
+
+	// The product automaton has to be rebuilt
+	mTransitions.clear();
+	mStateMasks.clear();
+	return mAutomata.size() - 1;
+}
+
+void LightPathExpressionSet::clear()
+{
+	mAutomata.clear();
+	mLabelClasses.clear();
+	mTransitions.clear();
+	mStateMasks.clear();
+	mSymbolCount = 0;
+}
+
+bool LightPathExpressionSet::build(size_t maxStates)
+{
+	constexpr size_t DEAD = std::numeric_limits<size_t>::max();
+	using StateTuple	  = std::vector<size_t>;
+
+	mLabelClasses.clear();
+	mTransitions.clear();
+	mStateMasks.clear();
+	mSymbolCount = 0;
+
+	if (mAutomata.empty())
+		return false;
+
+	// Only labels referenced by an expression have to be distinguished
+	std::vector<uint16> labels;
+	for (const auto& automaton : mAutomata) {
+		if (!automaton)
+			continue;
+		for (size_t label : automaton->labelIndices()) {
+			if (label != 0 && label <= std::numeric_limits<uint16>::max())
+				labels.push_back(static_cast<uint16>(label));
+		}
+	}
+	std::sort(labels.begin(), labels.end());
+	labels.erase(std::unique(labels.begin(), labels.end()), labels.end());
+
+	std::vector<uint32> labelClasses(labels.empty() ? 0 : labels.back() + 1, 0);
+	for (size_t i = 0; i < labels.size(); ++i)
+		labelClasses[labels[i]] = static_cast<uint32>(i + 1);
+
+	const size_t symbolCount = (labels.size() + 1) * (size_t)ScatteringType::_COUNT * (size_t)ScatteringEvent::_COUNT;
+
+	// Breadth first construction of all reachable state tuples. A dead component stays dead
+	std::map<StateTuple, uint32> stateIDs;
+	std::vector<StateTuple> states;
+	const auto stateID = [&](const StateTuple& tuple) {
+		const auto it = stateIDs.find(tuple);
+		if (it != stateIDs.end())
+			return it->second;
+
+		const uint32 id = static_cast<uint32>(states.size());
+		stateIDs.emplace(tuple, id);
+		states.push_back(tuple);
+		return id;
+	};
+
+	StateTuple start(mAutomata.size(), DEAD);
+	for (size_t i = 0; i < mAutomata.size(); ++i) {
+		if (mAutomata[i])
+			start[i] = mAutomata[i]->startingState();
+	}
+	stateID(start);
+
+	std::vector<uint32> transitions;
+	std::vector<uint64> stateMasks;
+	for (size_t s = 0; s < states.size(); ++s) {
+		const StateTuple current = states[s]; // Copy, as states might grow
+
+		uint64 mask = 0;
+		for (size_t i = 0; i < mAutomata.size(); ++i) {
+			if (current[i] != DEAD && mAutomata[i]->isFinal(current[i]))
+				mask |= (uint64)1 << i;
+		}
+		stateMasks.push_back(mask);
+
+		// Same order as the symbol computation in nextState()
+		StateTuple next(mAutomata.size());
+		for (size_t c = 0; c <= labels.size(); ++c) {
+			for (size_t t = 0; t < (size_t)ScatteringType::_COUNT; ++t) {
+				for (size_t e = 0; e < (size_t)ScatteringEvent::_COUNT; ++e) {
+					const LightPathToken token((ScatteringType)t, (ScatteringEvent)e, c == 0 ? 0 : labels[c - 1]);
+					for (size_t i = 0; i < mAutomata.size(); ++i) {
+						if (current[i] == DEAD) {
+							next[i] = DEAD;
+						} else {
+							bool success;
+							const size_t ns = mAutomata[i]->nextState(current[i], token, success);
+							next[i]			= success ? ns : DEAD;
+						}
+					}
+					transitions.push_back(stateID(next));
+				}
+			}
+		}
+
+		if (states.size() > maxStates && mAutomata.size() > 1)
+			return false;
+	}
+
+	mLabelClasses = std::move(labelClasses);
+	mTransitions  = std::move(transitions);
+	mStateMasks	  = std::move(stateMasks);
+	mSymbolCount  = symbolCount;
+	return true;
+}
+
+template <typename Path>
+static inline uint64 matchAll(const std::vector<std::shared_ptr<LPE::Automaton>>& automata, const Path& path)
+{
+	std::array<size_t, LightPathExpressionSet::MAX_EXPRESSIONS> states;
+
+	uint64 alive = 0;
+	for (size_t i = 0; i < automata.size(); ++i) {
+		if (automata[i]) {
+			states[i] = automata[i]->startingState();
+			alive |= (uint64)1 << i;
+		}
+	}
+
+	// Unpack each token only once and advance all automata still alive
+	for (size_t t = 0; t < path.currentSize() && alive != 0; ++t) {
+		const LightPathToken token = path.token(t);
+		for (size_t i = 0; i < automata.size(); ++i) {
+			if (!(alive & ((uint64)1 << i)))
+				continue;
+
+			bool success;
+			states[i] = automata[i]->nextState(states[i], token, success);
+			if (!success)
+				alive &= ~((uint64)1 << i);
+		}
+	}
+
+	uint64 mask = 0;
+	for (size_t i = 0; i < automata.size(); ++i) {
+		if ((alive & ((uint64)1 << i)) && automata[i]->isFinal(states[i]))
+			mask |= (uint64)1 << i;
+	}
+
+	return mask;
+}
+
+template <typename Path>
+inline uint64 LightPathExpressionSet::matchTable(const Path& path) const
+{
+	uint32 state = startingState();
+	for (size_t t = 0; t < path.currentSize(); ++t)
+		state = nextState(state, path.token(t));
+	return stateMask(state);
+}
+
+uint64 LightPathExpressionSet::match(const LightPath& path) const
+{
+	return isBuilt() ? matchTable(path) : matchAll(mAutomata, path);
+}
+
+uint64 LightPathExpressionSet::match(const LightPathView& path) const
+{
+	return isBuilt() ? matchTable(path) : matchAll(mAutomata, path);
+}
+} // namespace PR
@@ -0,0 +1,64 @@
+#pragma once
+
+#include "LightPathExpression.h"
+#include "LightPathToken.h"
+
+#include <vector>
+
+namespace PR {
+/// Set of light path expressions matched in a single pass over a path.
+/// All automata are advanced together, which equals running their product automaton.
+/// After build() the product automaton is available as a table and can be advanced token by token
+class PR_LIB_CORE LightPathExpressionSet {
+public:
+	static constexpr size_t MAX_EXPRESSIONS	   = 64;
+	static constexpr size_t DEFAULT_MAX_STATES = 4096;
+
+	LightPathExpressionSet();
+	~LightPathExpressionSet();
+
+	/// Returns the bit of the expression in the mask returned by match()
+	size_t add(const LightPathExpression& expr);
+	void clear();
+
+	inline size_t size() const { return mAutomata.size(); }
+	inline bool empty() const { return mAutomata.empty(); }
+	inline bool isFull() const { return mAutomata.size() >= MAX_EXPRESSIONS; }
+
+	/// Bitmask of all matching expressions. Bit i corresponds to the i-th added expression
+	uint64 match(const LightPath& path) const;
+	uint64 match(const LightPathView& path) const;
+
+	/// Build the product automaton of all added expressions.
+	/// Returns false if it would have more than maxStates states. A single expression is always built
+	bool build(size_t maxStates = DEFAULT_MAX_STATES);
+	inline bool isBuilt() const { return !mTransitions.empty(); }
+	inline size_t stateCount() const { return mStateMasks.size(); }
+
+	// Stepwise interface of the product automaton. Only available if built
+	inline uint32 startingState() const { return 0; }
+	inline uint32 nextState(uint32 state, const LightPathToken& token) const;
+	/// Bitmask of all expressions accepting in the given state
+	inline uint64 stateMask(uint32 state) const { return mStateMasks[state]; }
+
+private:
+	template <typename Path>
+	inline uint64 matchTable(const Path& path) const;
+
+	std::vector<std::shared_ptr<LPE::Automaton>> mAutomata; // Invalid expressions are nullptr
+
+	// Product automaton
+	std::vector<uint32> mLabelClasses; // Label index -> Symbol class. Unused labels behave like no label (class 0)
+	std::vector<uint32> mTransitions;  // States * Symbols
+	std::vector<uint64> mStateMasks;   // States
+	size_t mSymbolCount;
+};
+
+inline uint32 LightPathExpressionSet::nextState(uint32 state, const LightPathToken& token) const
+{
+	PR_ASSERT(isBuilt(), "Expected built expression set");
+	const uint32 labelClass = token.LabelIndex < mLabelClasses.size() ? mLabelClasses[token.LabelIndex] : 0;
+	const uint32 symbol		= (labelClass * (uint32)ScatteringType::_COUNT + (uint32)token.Type) * (uint32)ScatteringEvent::_COUNT + (uint32)token.Event;
+	return mTransitions[state * mSymbolCount + symbol];
+}
+} // namespace PR
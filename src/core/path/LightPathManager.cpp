@@ -1,13 +1,20 @@
 #include "LightPathManager.h"
 
+#include <algorithm>
+#include <cctype>
 #include <functional>
 
 namespace PR {
 size_t LightPathManager::getLabelIndex(const std::string& lbl)
 {
+	if (lbl.empty())
+		return 0;
+
 	std::hash<std::string> hash;
-	std::string tmp;
-	std::transform(lbl.begin(), lbl.end(), tmp.begin(), ::tolower);
-	return hash(tmp);
+	std::string tmp = lbl;
+	std::transform(tmp.begin(), tmp.end(), tmp.begin(), [](char c) { return (char)std::tolower(c); });
+
+	// Tokens store labels as 16bit indices, with 0 being reserved for no label
+	return 1 + hash(tmp) % std::numeric_limits<uint16>::max();
 }
 } // namespace PR
\ No newline at end of file
@@ -1,6 +1,6 @@
 #pragma once
 
-#include "container/HashGrid.h"
+#include "container/SortedHashGrid.h"
 #include "photon/Photon.h"
 
 namespace PR {
@@ -20,7 +20,7 @@ struct PhotonSphere // Setup for the estimation query
 };
 
 // Spatial Hashmap
-class PhotonMap : public HashGrid<Photon> {
+class PhotonMap : public SortedHashGrid<Photon> {
 	PR_CLASS_NON_COPYABLE(PhotonMap);
 
 public:
@@ -2,7 +2,7 @@
 namespace PR {
 namespace Photon {
 PhotonMap::PhotonMap(const BoundingBox& bbox, float gridDelta)
-	: HashGrid(bbox, gridDelta)
+	: SortedHashGrid(bbox, gridDelta)
 {
 }
 
@@ -0,0 +1,62 @@
+#pragma once
+
+#include "PR_Config.h"
+#include <vector>
+
+namespace PR {
+
+/// Non thread safe container for integrator specific states of paths traced in wavefront fashion.
+/// The id of an acquired state is carried along with each ray via Ray::PathID.
+/// Released slots are reused, therefore the state returned by acquire() is not reset
+template <typename T>
+class PathStateContainer {
+public:
+	inline uint32 acquire()
+	{
+		if (!mFreeSlots.empty()) {
+			const uint32 id = mFreeSlots.back();
+			mFreeSlots.pop_back();
+			return id;
+		}
+
+		PR_ASSERT(mStates.size() < std::numeric_limits<uint32>::max(), "Way too many paths in flight");
+
+		const uint32 id = static_cast<uint32>(mStates.size());
+		mStates.emplace_back();
+		return id;
+	}
+
+	inline void release(uint32 id)
+	{
+		PR_ASSERT(id < mStates.size(), "Invalid access");
+		mFreeSlots.push_back(id);
+	}
+
+	inline T& state(uint32 id)
+	{
+		PR_ASSERT(id < mStates.size(), "Invalid access");
+		return mStates[id];
+	}
+
+	inline const T& state(uint32 id) const
+	{
+		PR_ASSERT(id < mStates.size(), "Invalid access");
+		return mStates[id];
+	}
+
+	/// Amount of paths currently in flight
+	inline size_t activeCount() const { return mStates.size() - mFreeSlots.size(); }
+
+	/// Release all states, but keep the underlying memory
+	inline void reset()
+	{
+		mFreeSlots.resize(mStates.size());
+		for (size_t i = 0; i < mStates.size(); ++i)
+			mFreeSlots[i] = static_cast<uint32>(mStates.size() - i - 1);
+	}
+
+private:
+	std::vector<T> mStates;
+	std::vector<uint32> mFreeSlots;
+};
+} // namespace PR
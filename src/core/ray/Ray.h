@@ -29,6 +29,7 @@ struct PR_LIB_CORE Ray {
 	RayFlags Flags			  = 0;
 	uint32 PixelIndex		  = 0;			   // Global pixel index
 	uint32 GroupID			  = PR_INVALID_ID; // Points to corresponding ray group if available
+	uint32 PathID			  = PR_INVALID_ID; // Points to integrator specific path state if available (wavefront tracing)
 
 public:
 	Ray()				  = default;
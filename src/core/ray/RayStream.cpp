@@ -2,6 +2,8 @@
 #include "Platform.h"
 #include "Profiler.h"
 #include "container/IndexSort.h"
+#include "container/RadixSort.h"
+#include "geometry/BoundingBox.h"
 
 #include <algorithm>
 #include <fstream>
@@ -32,7 +34,8 @@ inline size_t padSize(size_t size)
 }
 
 RayStream::RayStream(size_t raycount)
-	: mSize(raycount + raycount % MAX_BANDWIDTH)
+	: mReordered(false)
+	, mSize(raycount + raycount % MAX_BANDWIDTH)
 	, mCurrentReadPos(0)
 	, mCurrentWritePos(0)
 {
@@ -53,6 +56,7 @@ RayStream::RayStream(size_t raycount)
 	mMaxT.resize(padSize<float>(mSize));
 	mFlags.resize(mSize);
 	mGroupID.resize(mSize);
+	mPathID.resize(mSize);
 	for (size_t i = 0; i < PR_SPECTRAL_BLOB_SIZE; ++i)
 		mWavelengthNM[i].resize(padSize<float>(mSize));
 }
@@ -88,6 +92,7 @@ void RayStream::addRay(const Ray& ray)
 	mMaxT[mCurrentWritePos]			  = ray.MaxT;
 	mFlags[mCurrentWritePos]		  = ray.Flags;
 	mGroupID[mCurrentWritePos]		  = ray.GroupID;
+	mPathID[mCurrentWritePos]		  = ray.PathID;
 
 	PR_OPT_LOOP
 	for (size_t i = 0; i < PR_SPECTRAL_BLOB_SIZE; ++i)
@@ -100,21 +105,77 @@ void RayStream::reset()
 {
 	mCurrentWritePos = 0;
 	mCurrentReadPos	 = 0;
+	mReordered		 = false;
+}
+
+constexpr uint32 MORTON_BITS	 = 10; // Per axis
+constexpr uint32 MORTON_MAX		 = (1 << MORTON_BITS) - 1;
+constexpr uint32 OCTANT_POSITION = 3 * MORTON_BITS;
+void RayStream::reorder(const BoundingBox& bounds)
+{
+	PR_PROFILE_THIS;
+
+	PR_ASSERT(mCurrentReadPos == 0, "Reordering has to be done before reading");
+
+	const size_t size = currentSize();
+	if (size <= 1)
+		return;
+
+	// Setup keys
+	const Vector3f lower = bounds.lowerBound();
+	const Vector3f scale = MORTON_MAX * (bounds.upperBound() - lower).cwiseMax(PR_EPSILON).cwiseInverse();
+
+	mSortKey.resize(size);
+	for (size_t i = 0; i < size; ++i) {
+		// Origins outside the bounds (e.g., the camera) are clamped to the border
+		uint32 cell[3];
+		for (int k = 0; k < 3; ++k)
+			cell[k] = static_cast<uint32>(std::clamp((mOrigin[k][i] - lower[k]) * scale[k], 0.0f, (float)MORTON_MAX));
+
+		mSortKey[i] = (uint64(directionOctant(i)) << OCTANT_POSITION) | xyz_2_morton(cell[0], cell[1], cell[2]);
+	}
+
+	// Sort
+	const auto op = [&](size_t a, size_t b) {
+		std::swap(mSortKey[a], mSortKey[b]);
+		for (int k = 0; k < 3; ++k) {
+			std::swap(mOrigin[k][a], mOrigin[k][b]);
+			std::swap(mDirection[k][a], mDirection[k][b]);
+		}
+		std::swap(mPixelIndex[a], mPixelIndex[b]);
+		std::swap(mIterationDepth[a], mIterationDepth[b]);
+		std::swap(mFlags[a], mFlags[b]);
+		std::swap(mMinT[a], mMinT[b]);
+		std::swap(mMaxT[a], mMaxT[b]);
+		std::swap(mGroupID[a], mGroupID[b]);
+		std::swap(mPathID[a], mPathID[b]);
+		for (size_t k = 0; k < PR_SPECTRAL_BLOB_SIZE; ++k)
+			std::swap(mWavelengthNM[k][a], mWavelengthNM[k][b]);
+	};
+
+	radixSort(mSortKey.data(), op, 0, size - 1, uint64(1) << (OCTANT_POSITION + 2));
+	mReordered = true;
 }
 
-/* A algorithm grouping rays together for coherent intersections
- * would give this function more meaning.
- */
 RaySpan RayStream::getNextSpan()
 {
 	PR_PROFILE_THIS;
 
 	PR_ASSERT(hasNextSpan(), "Never call when not available");
 
-	// TODO: Check coherence
-	RaySpan grp(this, 0, currentSize(), false);
-	mCurrentReadPos += grp.size();
-	return grp;
+	if (!mReordered) {
+		RaySpan grp(this, mCurrentReadPos, currentSize() - mCurrentReadPos, false);
+		mCurrentReadPos += grp.size();
+		return grp;
+	}
+
+	// Return all rays of the same direction octant
+	const size_t start	= mCurrentReadPos;
+	const uint64 octant = mSortKey[start] >> OCTANT_POSITION;
+	while (mCurrentReadPos < currentSize() && (mSortKey[mCurrentReadPos] >> OCTANT_POSITION) == octant)
+		++mCurrentReadPos;
+
+	return RaySpan(this, start, mCurrentReadPos - start, true);
 }
 
 #ifdef PR_COMPRESS_RAY_DIR
@@ -125,7 +186,7 @@ RaySpan RayStream::getNextSpan()
 
 size_t RayStream::getMemoryUsage() const
 {
-	return mSize * (3 * sizeof(float) + COMPRES_MEM + sizeof(uint32) + sizeof(uint16) + sizeof(unorm16) + sizeof(uint8) + sizeof(size_t) + 2 * sizeof(float) + 2 * PR_SPECTRAL_BLOB_SIZE * sizeof(float));
+	return mSize * (3 * sizeof(float) + COMPRES_MEM + sizeof(uint32) + sizeof(uint16) + sizeof(unorm16) + sizeof(uint8) + 2 * sizeof(uint32) + 2 * sizeof(float) + 2 * PR_SPECTRAL_BLOB_SIZE * sizeof(float) + sizeof(uint64));
 }
 
 Ray RayStream::getRay(size_t id) const
@@ -159,6 +220,7 @@ Ray RayStream::getRay(size_t id) const
 	ray.MinT		   = mMinT[id];
 	ray.MaxT		   = mMaxT[id];
 	ray.GroupID		   = mGroupID[id];
+	ray.PathID		   = mPathID[id];
 
 	PR_OPT_LOOP
 	for (size_t k = 0; k < PR_SPECTRAL_BLOB_SIZE; ++k)
@@ -8,6 +8,7 @@
 #include <vector>
 
 namespace PR {
+class BoundingBox;
 class RayStream;
 class PR_LIB_CORE RaySpan {
 private:
@@ -40,6 +41,11 @@ public:
 	inline void copyMaxTRaw(size_t offset, size_t size, float* dst) const;
 	inline void copyMinTRaw(size_t offset, size_t size, float* dst) const;
 
+	// Direct access to the underlying arrays starting at the span offset
+	inline const float* originData(int axis) const;
+	inline const float* directionData(int axis) const;
+	inline const float* minTData() const;
+
 	inline size_t offset() const { return mOffset; }
 	inline size_t size() const { return mSize; }
 	inline bool isCoherent() const { return mCoherent; }
@@ -73,6 +79,19 @@ public:
 	void addRay(const Ray& ray);
 	Ray getRay(size_t id) const;
 
+	/// Octant of the direction of the given ray. Each bit represents the sign of one axis
+	inline uint32 directionOctant(size_t id) const
+	{
+		return (std::signbit(mDirection[0][id]) ? 0x1 : 0)
+			   | (std::signbit(mDirection[1][id]) ? 0x2 : 0)
+			   | (std::signbit(mDirection[2][id]) ? 0x4 : 0);
+	}
+
+	/// Reorder all rays by the octant of their direction and the morton code of their origin inside the given bounds.
+	/// Afterwards each span only contains rays of the same direction octant and spans are marked as coherent.
+	/// Has to be called before the first span is requested
+	void reorder(const BoundingBox& bounds);
+
 	void reset();
 	RaySpan getNextSpan();
 
@@ -100,6 +119,10 @@ private: // Some vectors are not aligned, due to required preprocessing
 	AlignedVector<float> mMaxT;
 	AlignedVector<float> mWavelengthNM[PR_SPECTRAL_BLOB_SIZE];
 	AlignedVector<uint32> mGroupID;
+	AlignedVector<uint32> mPathID;
+
+	std::vector<uint64> mSortKey; // Only used for reordering
+	bool mReordered;
 
 	size_t mSize;
 	size_t mCurrentReadPos;
@@ -210,4 +233,19 @@ inline void RaySpan::copyMinTRaw(size_t offset, size_t size, float* dst) const
 	std::memcpy(dst, &mStream->mMinT[offset + mOffset], size * sizeof(float));
 }
 
+inline const float* RaySpan::originData(int axis) const
+{
+	return &mStream->mOrigin[axis][mOffset];
+}
+
+inline const float* RaySpan::directionData(int axis) const
+{
+	return &mStream->mDirection[axis][mOffset];
+}
+
+inline const float* RaySpan::minTData() const
+{
+	return &mStream->mMinT[mOffset];
+}
+
 } // namespace PR
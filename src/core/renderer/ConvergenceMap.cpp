@@ -0,0 +1,37 @@
+#include "ConvergenceMap.h"
+
+namespace PR {
+ConvergenceMap::ConvergenceMap(const Size2i& size, float errorThreshold, uint32 minSampleCount)
+	: mSize(size)
+	, mBlockCount((size.Width + BLOCK_SIZE - 1) / BLOCK_SIZE, (size.Height + BLOCK_SIZE - 1) / BLOCK_SIZE)
+	, mErrorThreshold(errorThreshold)
+	, mMinSampleCount(std::max<uint32>(1, minSampleCount))
+	, mApron(0)
+	, mBlockErrors(mBlockCount.area(), -1.0f)
+	, mConvergedAt(mBlockCount.area(), 0)
+	, mConvergedBlockCount(0)
+{
+	PR_ASSERT(mSize.isValid(), "Invalid map size");
+}
+
+void ConvergenceMap::update(uint32 iteration)
+{
+	if (iteration >= mMinSampleCount) {
+		for (size_t i = 0; i < mConvergedAt.size(); ++i) {
+			if (mConvergedAt[i] == 0 && mBlockErrors[i] >= 0 && mBlockErrors[i] < mErrorThreshold) {
+				mConvergedAt[i] = iteration;
+				++mConvergedBlockCount;
+			}
+		}
+	}
+
+	std::fill(mBlockErrors.begin(), mBlockErrors.end(), -1.0f);
+}
+
+void ConvergenceMap::reset()
+{
+	std::fill(mBlockErrors.begin(), mBlockErrors.end(), -1.0f);
+	std::fill(mConvergedAt.begin(), mConvergedAt.end(), 0);
+	mConvergedBlockCount = 0;
+}
+} // namespace PR
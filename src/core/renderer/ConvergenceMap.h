@@ -0,0 +1,98 @@
+#pragma once
+
+#include "PR_Config.h"
+
+#include <atomic>
+#include <vector>
+
+namespace PR {
+/// Blockwise convergence state of the view used for adaptive sampling.
+/// Output devices provide per pixel error estimates at the end of each iteration, which are combined to blocks by update().
+/// A converged block is frozen: It keeps its current estimate and gets no further samples,
+/// except for pixels within the apron of an unconverged block, as their filter splats still contribute to it.
+/// No mutex check. Errors and updates are expected in between iterations only
+class PR_LIB_CORE ConvergenceMap {
+public:
+	static constexpr Size1i BLOCK_SIZE = 8;
+
+	ConvergenceMap(const Size2i& size, float errorThreshold, uint32 minSampleCount);
+	~ConvergenceMap() = default;
+
+	inline const Size2i& size() const { return mSize; }
+	inline float errorThreshold() const { return mErrorThreshold; }
+	inline uint32 minSampleCount() const { return mMinSampleCount; }
+	inline Size1i apron() const { return mApron; }
+
+	/// Extend the apron around unconverged blocks to at least the given radius, usually the radius of the reconstruction filter
+	inline void requestApron(Size1i radius) { mApron = std::max(mApron, radius); }
+
+	/// Relative standard error of the mean of a pixel with the given online mean and variance after n samples
+	inline static float relativeError(float mean, float variance, uint32 n);
+
+	/// Set error estimate of an unconverged pixel. Only the maximum of all pixels in a block is kept
+	inline void setError(const Point2i& p, float error);
+	/// Freeze all blocks with an error below the threshold and prepare for the next iteration. Iteration is the amount of samples done so far
+	void update(uint32 iteration);
+	/// Unfreeze all blocks, e.g., after the output was cleared
+	void reset();
+
+	inline bool isConverged(const Point2i& p) const { return mConvergedAt[blockIndex(p)] != 0; }
+	/// True if the pixel is unconverged or within the apron of an unconverged block
+	inline bool needsSamples(const Point2i& p) const;
+	/// Amount of samples done for the given pixel until the given iteration
+	inline uint32 sampleCount(const Point2i& p, uint32 iteration) const;
+
+	inline size_t blockCount() const { return mConvergedAt.size(); }
+	inline size_t convergedBlockCount() const { return mConvergedBlockCount; }
+
+private:
+	inline size_t blockIndex(const Point2i& p) const { return (p(1) / BLOCK_SIZE) * mBlockCount.Width + p(0) / BLOCK_SIZE; }
+
+	const Size2i mSize;
+	const Size2i mBlockCount;
+	const float mErrorThreshold;
+	const uint32 mMinSampleCount;
+	Size1i mApron;
+
+	std::vector<float> mBlockErrors;		  // Maximum error of the current iteration. Negative if no estimate is available
+	std::vector<uint32> mConvergedAt;		  // Iteration the block converged, or zero
+	std::atomic<size_t> mConvergedBlockCount; // Also queried by status requests while rendering
+};
+
+inline float ConvergenceMap::relativeError(float mean, float variance, uint32 n)
+{
+	constexpr float DarkBias = 1e-3f; // Prevent dark pixels from never converging
+	return std::sqrt(std::max(0.0f, variance) / std::max<uint32>(1, n)) / (std::abs(mean) + DarkBias);
+}
+
+inline void ConvergenceMap::setError(const Point2i& p, float error)
+{
+	float& blockError = mBlockErrors[blockIndex(p)];
+	blockError		  = std::max(blockError, error);
+}
+
+inline bool ConvergenceMap::needsSamples(const Point2i& p) const
+{
+	if (!isConverged(p))
+		return true;
+
+	if (mApron <= 0)
+		return false;
+
+	const Point2i start = (p - Point2i::Constant(mApron)).cwiseMax(Point2i::Zero()) / BLOCK_SIZE;
+	const Point2i end	= (p + Point2i::Constant(mApron)).cwiseMin(Point2i(mSize.Width - 1, mSize.Height - 1)) / BLOCK_SIZE;
+	for (Size1i by = start(1); by <= end(1); ++by) {
+		for (Size1i bx = start(0); bx <= end(0); ++bx) {
+			if (mConvergedAt[by * mBlockCount.Width + bx] == 0)
+				return true;
+		}
+	}
+	return false;
+}
+
+inline uint32 ConvergenceMap::sampleCount(const Point2i& p, uint32 iteration) const
+{
+	const uint32 convergedAt = mConvergedAt[blockIndex(p)];
+	return convergedAt != 0 ? std::min(convergedAt, iteration) : iteration;
+}
+} // namespace PR
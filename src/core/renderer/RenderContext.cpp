@@ -1,4 +1,5 @@
 #include "RenderContext.h"
+#include "ConvergenceMap.h"
 #include "Logger.h"
 #include "Platform.h"
 #include "Profiler.h"
@@ -20,6 +21,10 @@
 #include "trace/IntersectionPoint.h"
 
 namespace PR {
+// Tiles can run ahead of the slowest tile by this amount of iterations before they are parked
+constexpr uint32 ASYNC_MAX_ITERATION_LAG = 2;
+constexpr auto ASYNC_WAIT_INTERVAL		 = std::chrono::milliseconds(10);
+
 RenderContext::RenderContext(uint32 index, const Point2i& viewOffset, const Size2i& viewSize,
 							 const std::shared_ptr<IIntegrator>& integrator,
 							 const std::shared_ptr<Scene>& scene,
@@ -32,6 +37,7 @@ RenderContext::RenderContext(uint32 index, const Point2i& viewOffset, const Size
 	, mTileMap()
 	, mThreadsWaitingForIteration(0)
 	, mIncrementalCurrentIteration(0)
+	, mAsyncIterations(false)
 	, mRenderSettings(settings)
 	, mIntegrator(integrator)
 	, mIntegratorPassCount(1)
@@ -53,6 +59,11 @@ void RenderContext::reset()
 {
 	PR_PROFILE_THIS;
 
+	if (mCoordinator.joinable()) {
+		mShouldStop = true;
+		joinCoordinator();
+	}
+
 	mThreads.clear();
 
 	mShouldStop					 = false;
@@ -80,8 +91,9 @@ void RenderContext::start(uint32 rtx, uint32 rty, int32 threads)
 	for (uint32 i = 0; i < threadCount; ++i)
 		mThreads.emplace_back(std::make_unique<RenderThread>(i, this));
 
-	// Setup random map
-	mRandomMap = std::make_unique<RenderRandomMap>(this);
+	// Setup random map. Not needed if generators are seeded per sample
+	if (mRenderSettings.pixelRandomMode == PixelRandomMode::Map)
+		mRandomMap = std::make_unique<RenderRandomMap>(this);
 
 	// Setup light sampler
 	mLightSampler		= std::make_shared<LightSampler>(mScene.get(), cameraSpectralRange());
@@ -105,6 +117,25 @@ void RenderContext::start(uint32 rtx, uint32 rty, int32 threads)
 
 	mIntegratorPassCount = mIntegrator->configuration().PassCount;
 
+	// Multiple passes depend on each other and require all tiles to be synchronized
+	mAsyncIterations = mRenderSettings.asyncIterations && mIntegratorPassCount == 1;
+	if (mRenderSettings.asyncIterations && !mAsyncIterations)
+		PR_LOG(L_WARNING) << "Asynchronous iterations are only supported by single pass integrators. Falling back to synchronized iterations" << std::endl;
+	if (mAsyncIterations)
+		mOutputSystem->enableAsyncIterations();
+
+	// Adaptive sampling freezes blocks at the end of an iteration, which is only well defined if all tiles are synchronized
+	mConvergenceMap.reset();
+	if (mRenderSettings.adaptiveSampling) {
+		if (mAsyncIterations || mIntegratorPassCount != 1) {
+			PR_LOG(L_WARNING) << "Adaptive sampling is only supported by single pass integrators with synchronized iterations. Disabling it" << std::endl;
+		} else {
+			mConvergenceMap = std::make_unique<ConvergenceMap>(mViewSize, mRenderSettings.adaptiveErrorThreshold, mRenderSettings.adaptiveMinSampleCount);
+			mOutputSystem->enableVarianceEstimation();
+			mOutputSystem->enableAdaptiveSampling(mConvergenceMap.get());
+		}
+	}
+
 	// Call all interested objects after thread count is fixed
 	mScene->beforeRender(this);
 
@@ -127,7 +158,9 @@ void RenderContext::start(uint32 rtx, uint32 rty, int32 threads)
 				   << "  Camera Spectral Domain: [" << cameraSpectralRange().Start << ", " << cameraSpectralRange().End << "]" << std::endl
 				   << "  Light Spectral Domain:  [" << lightSpectralRange().Start << ", " << lightSpectralRange().End << "]" << std::endl
 				   << "  Adaptive Tiling:        " << (mRenderSettings.useAdaptiveTiling ? "true" : "false") << std::endl
-				   << "  Progressive:            " << (mRenderSettings.progressive ? "true" : "false") << std::endl;
+				   << "  Progressive:            " << (mRenderSettings.progressive ? "true" : "false") << std::endl
+				   << "  Async Iterations:       " << (mAsyncIterations ? "true" : "false") << std::endl
+				   << "  Adaptive Sampling:      " << (mConvergenceMap ? "true" : "false") << std::endl;
 
 	// Start
 	mIntegrator->onStart();
@@ -136,6 +169,9 @@ void RenderContext::start(uint32 rtx, uint32 rty, int32 threads)
 	PR_LOG(L_INFO) << "Starting threads." << std::endl;
 	for (const auto& thread : mThreads)
 		thread->start();
+
+	if (mAsyncIterations)
+		mCoordinator = std::thread([this]() { coordinateIterations(); });
 }
 
 void RenderContext::notifyEnd()
@@ -196,6 +232,8 @@ void RenderContext::waitForFinish()
 	// Wait for all threads to stop
 	for (const auto& thread : mThreads)
 		thread->join();
+
+	joinCoordinator();
 }
 
 void RenderContext::requestStop()
@@ -204,6 +242,7 @@ void RenderContext::requestStop()
 
 	// Make sure threads are not inside conditions
 	mIterationCondition.notify_all();
+	mCoordinatorCondition.notify_all();
 }
 
 void RenderContext::requestSoftStop()
@@ -229,12 +268,27 @@ void RenderContext::stop()
 	// Wait for all threads to stop
 	for (const auto& thread : mThreads)
 		thread->join();
+
+	joinCoordinator();
 }
 
 RenderTile* RenderContext::getNextTile(const RenderThread* thread)
 {
 	PR_PROFILE_THIS;
 
+	if (mAsyncIterations) {
+		while (!mShouldStop && !mTileMap->allFinished()) {
+			RenderTile* tile = mTileMap->getNextTile(thread);
+			if (tile)
+				return tile;
+
+			// All remaining tiles are worked on or wait for the slowest tiles to catch up
+			std::unique_lock<std::mutex> lk(mIterationMutex);
+			mIterationCondition.wait_for(lk, ASYNC_WAIT_INTERVAL);
+		}
+		return nullptr;
+	}
+
 	const size_t threads = threadCount();
 
 	RenderTile* tile = nullptr;
@@ -270,29 +324,92 @@ RenderTile* RenderContext::getNextTile(const RenderThread* thread)
 	return tile;
 }
 
+void RenderContext::releaseTile(RenderTile* tile, const RenderThread* thread)
+{
+	if (!mAsyncIterations) {
+		mTileMap->releaseTile(tile, thread);
+		return;
+	}
+
+	const uint32 current = currentIteration().Iteration;
+	tile->advanceIteration();
+	const uint32 tileIteration = tile->iteration();
+	mTileMap->releaseTile(tile, thread, true, current + ASYNC_MAX_ITERATION_LAG);
+
+	// One of the slowest tiles is done, which might complete the current iteration
+	if (tileIteration == current + 1)
+		mCoordinatorCondition.notify_one();
+}
+
+RenderIteration RenderContext::tileIteration(const RenderTile* tile) const
+{
+	return mAsyncIterations ? RenderIteration{ tile->iteration(), 0 } : currentIteration();
+}
+
+void RenderContext::coordinateIterations()
+{
+	PR_PROFILE_THREAD("Iteration Coordinator");
+
+	while (!mShouldStop) {
+		{
+			std::unique_lock<std::mutex> lk(mIterationMutex);
+			mCoordinatorCondition.wait_for(lk, ASYNC_WAIT_INTERVAL);
+		}
+
+		// The slowest tile defines the iteration every tile has completed
+		const bool finished	   = mTileMap->allFinished();
+		const uint32 completed = mTileMap->minIteration();
+		while (!mShouldStop && currentIteration().Iteration < completed)
+			handleNextIteration();
+
+		if (finished)
+			break;
+	}
+}
+
+void RenderContext::joinCoordinator()
+{
+	if (!mCoordinator.joinable())
+		return;
+
+	mCoordinatorCondition.notify_all();
+	mCoordinator.join();
+}
+
 void RenderContext::handleNextIteration()
 {
 	if (mShouldSoftStop)
 		requestInternalStop();
 
-	mTileMap->makeAllIdle();
+	if (!mAsyncIterations)
+		mTileMap->makeAllIdle();
 
 	if (mOutputClearRequest.exchange(false)) {
 		PR_LOG(L_DEBUG) << "Clearing output buffer" << std::endl;
 		mOutputSystem->clear(true);
+		if (mConvergenceMap)
+			mConvergenceMap->reset();
 	}
 
 	++mIncrementalCurrentIteration;
 	const RenderIteration iter = currentIteration();
 	mOutputSystem->onEndOfIteration(iter.Iteration);
+	if (mConvergenceMap)
+		mConvergenceMap->update(iter.Iteration);
 
-	if (iter.Pass == 0 && mRenderSettings.useAdaptiveTiling) {
+	// Tiles can not be split while others are working on them
+	if (!mAsyncIterations && iter.Pass == 0 && mRenderSettings.useAdaptiveTiling) {
 		PR_LOG(L_DEBUG) << "Optimizing tile map" << std::endl;
 		optimizeTileMap();
 	}
 
 	for (const auto& clb : mIterationCallbacks)
 		clb(iter);
+
+	if (mAsyncIterations) {
+		mTileMap->unparkTiles(iter.Iteration + ASYNC_MAX_ITERATION_LAG);
+		mIterationCondition.notify_all();
+	}
 }
 
 void RenderContext::optimizeTileMap()
@@ -332,8 +449,17 @@ RenderStatus RenderContext::status() const
 	status.setField("global.depth_count", s.depthCount());
 	status.setField("global.camera_depth_count", s.entry(RenderStatisticEntry::CameraDepthCount));
 	status.setField("global.light_depth_count", s.entry(RenderStatisticEntry::LightDepthCount));
+	status.setField("global.shading_group_count", s.entry(RenderStatisticEntry::ShadingGroupCount));
+	status.setField("global.shading_group_hit_count", s.entry(RenderStatisticEntry::ShadingGroupHitCount));
 	status.setField("global.iteration_count", (uint64)iter.Iteration);
 	status.setField("global.pass_count", (uint64)iter.Pass);
+	status.setField("global.tile_local_count", mTileMap->localTileCount());
+	status.setField("global.tile_stolen_count", mTileMap->stolenTileCount());
+	status.setField("global.tile_failed_steal_count", mTileMap->failedStealCount());
+	if (mConvergenceMap) {
+		status.setField("global.converged_block_count", (uint64)mConvergenceMap->convergedBlockCount());
+		status.setField("global.block_count", (uint64)mConvergenceMap->blockCount());
+	}
 
 	return status;
 }
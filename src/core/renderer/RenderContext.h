@@ -10,9 +10,11 @@
 #include <condition_variable>
 #include <functional>
 #include <mutex>
+#include <thread>
 #include <vector>
 
 namespace PR {
+class ConvergenceMap;
 class HitStream;
 class IEntity;
 class IIntegrator;
@@ -91,6 +93,12 @@ public:
 
 	/// Returns current render iteration with current iteration and pass
 	inline RenderIteration currentIteration() const { return RenderIteration{ mIncrementalCurrentIteration / mIntegratorPassCount, mIncrementalCurrentIteration % mIntegratorPassCount }; }
+	/// Returns the iteration the given tile is working on. Only differs from currentIteration() if iterations are asynchronous
+	RenderIteration tileIteration(const RenderTile* tile) const;
+	/// Returns true if tiles advance iterations independently and iteration callbacks are called by a background coordinator
+	inline bool hasAsyncIterations() const { return mAsyncIterations; }
+	/// Blockwise convergence state used by adaptive sampling. Null if adaptive sampling is disabled
+	inline const ConvergenceMap* convergenceMap() const { return mConvergenceMap.get(); }
 
 	/// Integrator used for rendering
 	inline std::shared_ptr<IIntegrator> integrator() const { return mIntegrator; }
@@ -121,12 +129,16 @@ public:
 protected:
 	/// Return next available tile for the given thread
 	RenderTile* getNextTile(const RenderThread* thread);
+	/// Release a tile returned by getNextTile
+	void releaseTile(RenderTile* tile, const RenderThread* thread);
 
 private:
 	void requestInternalStop();
 	void reset();
 	void handleNextIteration();
 	void optimizeTileMap();
+	void coordinateIterations();
+	void joinCoordinator();
 
 	const uint32 mIndex;
 	const Point2i mViewOffset;
@@ -145,10 +157,15 @@ private:
 	std::atomic<uint32> mIncrementalCurrentIteration; // A linear variant of iterations and passes
 	std::vector<std::unique_ptr<RenderThread>> mThreads;
 
+	bool mAsyncIterations;
+	std::thread mCoordinator; // Only used if iterations are asynchronous
+	std::condition_variable mCoordinatorCondition;
+
 	const RenderSettings mRenderSettings;
 	SpectralRange mLightSpectralRange;
 
 	std::unique_ptr<RenderRandomMap> mRandomMap;
+	std::unique_ptr<ConvergenceMap> mConvergenceMap;
 	std::shared_ptr<LightSampler> mLightSampler;
 
 	const std::shared_ptr<IIntegrator> mIntegrator;
@@ -1,6 +1,6 @@
 #pragma once
 
-#include "PR_Config.h"
+#include "Enum.h"
 
 namespace PR {
 /* Visual feedback tile mode */
@@ -16,4 +16,18 @@ enum class TimeMappingMode {
 	Left,		// [-1, 0]
 	Right		// [0, 1]
 };
+
+/* Source of the per pixel random number generators */
+enum class PixelRandomMode {
+	Map = 0, // Full sized map of generators with state carried over between samples
+	Hash	 // Generators seeded by a hash of seed, pixel and sample. Only the current tile keeps state
+};
+
+/* Secondary keys used to sort hits of the same entity for coherent shading */
+enum class HitSortKey : uint32 {
+	Material  = 0x1, // Material slot of the hit primitive
+	Direction = 0x2, // Octant of the ray direction
+	Primitive = 0x4
+};
+PR_MAKE_FLAGS(HitSortKey, HitSortKeys)
 } // namespace PR
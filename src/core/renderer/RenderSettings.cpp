@@ -12,12 +12,19 @@ RenderSettings::RenderSettings()
 	: seed(42)
 	, maxParallelRays(10000)
 	, sampleCountOverride(0)
+	, pixelRandomMode(PixelRandomMode::Map)
 	, timeMappingMode(TimeMappingMode::Right)
 	, timeScale(1)
 	, tileMode(TileMode::ZOrder)
 	, useAdaptiveTiling(true)
 	, sortHits(false)
+	, hitSortKeys(HitSortKey::Material | HitSortKey::Direction)
+	, reorderRays(false)
 	, progressive(false)
+	, asyncIterations(false)
+	, adaptiveSampling(false)
+	, adaptiveErrorThreshold(0.01f)
+	, adaptiveMinSampleCount(16)
 	, spectralStart(PR_CIE_WAVELENGTH_START)
 	, spectralEnd(PR_CIE_WAVELENGTH_END)
 	, spectralMono(false)
@@ -29,12 +29,21 @@ public:
 	// Will use this sample count if non zero
 	uint32 sampleCountOverride;
 
+	PixelRandomMode pixelRandomMode;
 	TimeMappingMode timeMappingMode;
 	float timeScale;
 	TileMode tileMode;
 	bool useAdaptiveTiling;
 	bool sortHits;
+	HitSortKeys hitSortKeys; // Only used if sortHits is true
+	bool reorderRays;		 // Reorder rays by direction and origin before traversal
 	bool progressive;
+	bool asyncIterations; // Let tiles advance iterations independently. Only used by single pass integrators
+
+	// Adaptive sampling entries. Only used with synchronized iterations
+	bool adaptiveSampling;
+	float adaptiveErrorThreshold;  // Relative standard error a pixel block has to fall below to be frozen
+	uint32 adaptiveMinSampleCount; // Samples each pixel gets before its block may be frozen
 
 	float spectralStart;
 	float spectralEnd;
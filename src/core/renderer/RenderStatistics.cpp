@@ -27,6 +27,13 @@ RenderStatistics& RenderStatistics::operator+=(const RenderStatistics& other)
 	return *this;
 }
 
+RenderStatistics& RenderStatistics::operator+=(const LocalRenderStatistics& other)
+{
+	for (int i = 0; i < (int)RenderStatisticEntry::_COUNT; ++i)
+		mCounters[i].fetch_add(other.entry((RenderStatisticEntry)i), std::memory_order_relaxed);
+	return *this;
+}
+
 RenderStatistics RenderStatistics::half() const
 {
 	RenderStatistics other;
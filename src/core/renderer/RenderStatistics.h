@@ -18,10 +18,32 @@ enum class RenderStatisticEntry {
 	BackgroundHitCount,
 	CameraDepthCount,
 	LightDepthCount,
+	ShadingGroupCount,
+	ShadingGroupHitCount, // Amount of hits handled by all shading groups
 
 	_COUNT
 };
 
+/// Plain counters only written by the thread currently working on a tile.
+/// Adding is a no-op if statistics are stripped at compile time (PR_WITH_STATISTICS)
+class PR_LIB_CORE LocalRenderStatistics {
+public:
+	inline LocalRenderStatistics() { reset(); }
+
+#ifdef PR_WITH_STATISTICS
+	inline void add(RenderStatisticEntry rse, uint64 i = 1) { mCounters[(uint32)rse] += i; }
+#else
+	inline void add(RenderStatisticEntry, uint64 = 1) {}
+#endif
+	inline uint64 entry(RenderStatisticEntry rse) const { return mCounters[(uint32)rse]; }
+
+	inline void reset() { mCounters.fill(0); }
+
+private:
+	std::array<uint64, (uint32)RenderStatisticEntry::_COUNT> mCounters;
+};
+
+/// Shared counters, which can be queried while rendering
 class PR_LIB_CORE RenderStatistics {
 public:
 	RenderStatistics();
@@ -29,6 +51,7 @@ public:
 
 	RenderStatistics& operator=(const RenderStatistics& other);
 	RenderStatistics& operator+=(const RenderStatistics& other);
+	RenderStatistics& operator+=(const LocalRenderStatistics& other);
 
 	inline uint64 rayCount() const
 	{
@@ -45,26 +45,33 @@ void RenderThread::main()
 	auto integrator	  = mRenderer->integrator()->createThreadInstance(mRenderer, mThreadIndex);
 	auto queue		  = std::make_shared<LocalOutputQueue>(outputSystem.get(), mPipeline.get(), QUEUE_SIZE, QUEUE_THRESHOLD);
 
+	// Tiles are never larger than the initial ones, therefore the local outputs are allocated once and reused for all tiles
+	auto localSystem = outputSystem->createLocal(nullptr, mRenderer->maxTileSize());
+
+	// Without a random map the generators of the acquired tile live here and are reseeded per sample
+	if (!mRenderer->randomMap())
+		mPixelRandoms = std::make_unique<Random[]>(mRenderer->maxTileSize().area());
+
 	integrator->onStart();
 	for (mTile = mRenderer->getNextTile(this);
 		 mTile && !shouldStop();
 		 mTile = mRenderer->getNextTile(this)) {
 
-		auto localSystem = outputSystem->createLocal(mTile, mTile->viewSize());
+		localSystem->reuse(mTile, mTile->viewSize());
 		RenderTileSession session(mThreadIndex, mTile, pipeline(), queue, localSystem);
 
 		localSystem->clear(true);
 		mPipeline->reset(mTile);
 		integrator->onTile(session);
 		if (PR_UNLIKELY(shouldStop())) {
-			mTile->release();
+			mRenderer->releaseTile(mTile, this);
 			break;
 		}
 		queue->commitAndFlush(localSystem.get());
-		outputSystem->mergeLocal(mTile->start(), localSystem, mRenderer->currentIteration().Iteration + 1);
+		outputSystem->mergeLocal(mTile->start(), localSystem, mRenderer->tileIteration(mTile).Iteration + 1);
 
 		mStatistics.addTileCount();
-		mTile->release();
+		mRenderer->releaseTile(mTile, this);
 	}
 	integrator->onEnd();
 }
@@ -1,5 +1,6 @@
 #pragma once
 
+#include "Random.h"
 #include "RenderThreadStatistics.h"
 #include "thread/Thread.h"
 
@@ -12,6 +13,8 @@ public:
 	RenderThread(uint32 index, RenderContext* renderer);
 	virtual ~RenderThread();
 
+	inline uint32 index() const { return mThreadIndex; }
+
 	inline RenderTile* currentTile() const
 	{
 		return mTile;
@@ -20,6 +23,9 @@ public:
 	inline StreamPipeline* pipeline() const { return mPipeline.get(); }
 	inline const RenderThreadStatistics& statistics() const { return mStatistics; }
 
+	/// Scratch generators for the pixels of the current tile, only available if no random map is used
+	inline Random* pixelRandoms() const { return mPixelRandoms.get(); }
+
 protected:
 	virtual void main();
 
@@ -29,5 +35,6 @@ private:
 	RenderTile* mTile;
 	std::unique_ptr<StreamPipeline> mPipeline;
 	RenderThreadStatistics mStatistics;
+	std::unique_ptr<Random[]> mPixelRandoms;
 };
 } // namespace PR
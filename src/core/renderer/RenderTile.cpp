@@ -1,8 +1,8 @@
 #include "RenderTile.h"
 #include "Profiler.h"
 #include "RenderContext.h"
+#include "RenderThread.h"
 #include "camera/ICamera.h"
-#include "math/Hash.h"
 #include "sampler/ISampler.h"
 #include "scene/Scene.h"
 #include "spectral/ISpectralMapper.h"
@@ -10,6 +10,12 @@
 namespace PR {
 constexpr size_t SLOT_RND_PRIME = 4201321; // Just a random prime number to not have same randomizer as pixels
 
+// Dimensions requested from the camera samplers, such that samplers of the same type are not correlated
+constexpr uint32 AA_SAMPLE_DIM	 = 0;
+constexpr uint32 LENS_SAMPLE_DIM = 2;
+constexpr uint32 TIME_SAMPLE_DIM = 4;
+static_assert(TIME_SAMPLE_DIM < PATH_SAMPLE_DIM, "Path dimensions should not overlap with camera dimensions");
+
 RenderTile::RenderTile(const Point2i& start, const Point2i& end,
 					   RenderContext* context, const RenderTileContext& tileContext)
 	: mStatus(static_cast<LockFreeAtomic::value_type>(RenderTileStatus::Idle))
@@ -25,6 +31,7 @@ RenderTile::RenderTile(const Point2i& start, const Point2i& end,
 	, mLastWorkTime()
 	, mRenderContext(context)
 	, mRenderRandomMap(context->randomMap())
+	, mPixelRandoms(nullptr)
 	, mCamera(context->scene()->activeCamera())
 {
 	PR_ASSERT(mViewSize.isValid(), "Invalid tile size");
@@ -74,18 +81,32 @@ std::optional<CameraRay> RenderTile::constructCameraRay(const Point2i& p, const
 
 	PR_PROFILE_THIS;
 
-	statistics().add(RenderStatisticEntry::PixelSampleCount);
+	localStatistics().add(RenderStatisticEntry::PixelSampleCount);
 	++mContext.PixelSamplesRendered;
 	const uint32 sample = iter.Iteration;
 
+	const uint64 pixel = pixelIndex(p);
+
+	// Start a new sequence for each sample if no state is carried over
+	if (!mRenderRandomMap) {
+		const uint64 rndSeed = hash_mix(mRenderContext->settings().seed ^ hash_mix(pixel ^ hash_mix(sample)));
+		random(p)			 = Random(rndSeed);
+	}
+
 	Random& rnd = random(p);
 
+	// Decorrelate the sequences of the pixels
+	const uint64 pixelSeed = sequenceSeed(p);
+	mAASampler->setSequenceSeed(pixelSeed);
+	mLensSampler->setSequenceSeed(pixelSeed);
+	mTimeSampler->setSequenceSeed(pixelSeed);
+
 	// Sample most information accesable by a camera
 	CameraSample cameraSample;
 	cameraSample.SensorSize	 = mImageSize;
-	cameraSample.Pixel		 = (p + mRenderContext->viewOffset()).cast<float>() + mAASampler->generate2D(rnd, sample).array() - Point2f(0.5f, 0.5f);
-	cameraSample.Lens		 = mLensSampler->generate2D(rnd, sample);
-	cameraSample.Time		 = mTimeAlpha * mTimeSampler->generate1D(rnd, sample) + mTimeBeta;
+	cameraSample.Pixel		 = (p + mRenderContext->viewOffset()).cast<float>() + mAASampler->generate2D(rnd, sample, AA_SAMPLE_DIM).array() - Point2f(0.5f, 0.5f);
+	cameraSample.Lens		 = mLensSampler->generate2D(rnd, sample, LENS_SAMPLE_DIM);
+	cameraSample.Time		 = mTimeAlpha * mTimeSampler->generate1D(rnd, sample, TIME_SAMPLE_DIM) + mTimeBeta;
 	cameraSample.BlendWeight = 1.0f;
 	cameraSample.Importance	 = 1.0f;
 
@@ -131,6 +152,26 @@ std::optional<CameraRay> RenderTile::constructCameraRay(const Point2i& p, const
 	return ray;
 }
 
+float RenderTile::pathSample1D(const Point2i& globalP, uint32 dimension)
+{
+	Random& rnd = random(globalP);
+	if (!mAASampler->supportsDimensions())
+		return rnd.getFloat();
+
+	mAASampler->setSequenceSeed(sequenceSeed(globalP));
+	return mAASampler->generate1D(rnd, mRenderContext->tileIteration(this).Iteration, dimension);
+}
+
+Vector2f RenderTile::pathSample2D(const Point2i& globalP, uint32 dimension)
+{
+	Random& rnd = random(globalP);
+	if (!mAASampler->supportsDimensions())
+		return rnd.get2D();
+
+	mAASampler->setSequenceSeed(sequenceSeed(globalP));
+	return mAASampler->generate2D(rnd, mRenderContext->tileIteration(this).Iteration, dimension);
+}
+
 bool RenderTile::accuire(const RenderThread* thread)
 {
 	if (isFinished())
@@ -141,6 +182,7 @@ bool RenderTile::accuire(const RenderThread* thread)
 
 	if (res) {
 		mCurrentThread = thread;
+		mPixelRandoms  = thread ? thread->pixelRandoms() : nullptr;
 		mWorkStart	   = std::chrono::high_resolution_clock::now();
 		return true;
 	} else {
@@ -154,9 +196,15 @@ void RenderTile::release()
 	const bool res						= mStatus.compare_exchange_strong(expected, static_cast<LockFreeAtomic::value_type>(RenderTileStatus::Done));
 
 	if (res) {
+#ifdef PR_WITH_STATISTICS
+		mContext.Statistics += mLocalStatistics;
+		mLocalStatistics.reset();
+#endif
+
 		auto end	   = std::chrono::high_resolution_clock::now();
 		mLastWorkTime  = std::chrono::duration_cast<std::chrono::microseconds>(end - mWorkStart);
 		mCurrentThread = nullptr;
+		mPixelRandoms  = nullptr;
 	}
 }
 
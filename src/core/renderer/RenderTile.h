@@ -1,6 +1,7 @@
 #pragma once
 
 #include "Random.h"
+#include "math/Hash.h"
 #include "ray/Ray.h"
 #include "renderer/RenderRandomMap.h"
 #include "renderer/RenderStatistics.h"
@@ -12,15 +13,18 @@
 namespace PR {
 struct PR_LIB_CORE RenderTileContext {
 	std::atomic<uint64> PixelSamplesRendered;
+	std::atomic<uint32> Iteration; // Only advanced if iterations are asynchronous
 	RenderStatistics Statistics;
 
 	inline RenderTileContext()
 		: PixelSamplesRendered(0)
+		, Iteration(0)
 	{
 	}
 
 	inline RenderTileContext(const RenderTileContext& other)
 		: PixelSamplesRendered(other.PixelSamplesRendered.load())
+		, Iteration(other.Iteration.load())
 		, Statistics(other.Statistics)
 	{
 	}
@@ -34,6 +38,9 @@ class RenderThread;
 class ISampler;
 class ISpectralMapper;
 
+/// Camera samplers occupy the first dimensions. Integrators request their per bounce dimensions starting from here
+constexpr uint32 PATH_SAMPLE_DIM = 5;
+
 enum class RenderTileStatus {
 	Idle	= 0,
 	Working = 1,
@@ -59,6 +66,7 @@ public:
 	inline void reset()
 	{
 		mContext.PixelSamplesRendered = 0;
+		mContext.Iteration			  = 0;
 		makeIdle();
 	}
 
@@ -80,12 +88,31 @@ public:
 
 	inline uint64 maxPixelSamples() const { return mMaxPixelSamples; }
 	inline uint64 pixelSamplesRendered() const { return mContext.PixelSamplesRendered; }
+	/// Account for a pixel sample without constructing a camera ray, e.g., for already converged pixels
+	inline void skipPixelSample() { ++mContext.PixelSamplesRendered; }
+
+	/// Amount of iterations done by this tile. Only used if iterations are asynchronous
+	inline uint32 iteration() const { return mContext.Iteration; }
+	inline void advanceIteration() { ++mContext.Iteration; }
 
 	std::pair<std::unique_ptr<RenderTile>, std::unique_ptr<RenderTile>>
 	split(int dim) const;
 
 	inline Random& random(RandomSlot slot) { return mRandomSlots[(int)slot]; }
-	inline Random& random(const Point2i& globalP) { return mRenderRandomMap->random(globalP); }
+	inline Random& random(const Point2i& globalP)
+	{
+		if (mRenderRandomMap)
+			return mRenderRandomMap->random(globalP);
+
+		PR_ASSERT(mPixelRandoms, "Pixel generators are only available while the tile is acquired");
+		const Point2i local = globalP - mStart;
+		return mPixelRandoms[local(0) + local(1) * mViewSize.Width];
+	}
+
+	/// Sample the given dimension of the current sample of the pixel with the AA sampler.
+	/// Falls back to the pixel random generator if the sampler does not support dimensions
+	float pathSample1D(const Point2i& globalP, uint32 dimension);
+	Vector2f pathSample2D(const Point2i& globalP, uint32 dimension);
 
 	inline ISampler* aaSampler() const { return mAASampler.get(); }
 	inline ISampler* lensSampler() const { return mLensSampler.get(); }
@@ -94,8 +121,10 @@ public:
 
 	inline ISpectralMapper* spectralMapper() const { return mSpectralMapper.get(); }
 
+	/// Statistics of all released work. Safe to query while rendering
 	inline const RenderStatistics& statistics() const { return mContext.Statistics; }
-	inline RenderStatistics& statistics() { return mContext.Statistics; }
+	/// Statistics of the current work, only accessible by the thread working on the tile. Folded into statistics() on release
+	inline LocalRenderStatistics& localStatistics() { return mLocalStatistics; }
 
 	inline const RenderContext* context() const { return mRenderContext; }
 	inline const RenderThread* currentThread() const { return mCurrentThread; }
@@ -103,6 +132,9 @@ public:
 	inline std::chrono::microseconds lastWorkTime() const { return mLastWorkTime; }
 
 private:
+	inline uint64 pixelIndex(const Point2i& globalP) const { return globalP(0) + globalP(1) * (uint64)mImageSize.Width; }
+	inline uint64 sequenceSeed(const Point2i& globalP) const { return hash_mix(pixelIndex(globalP)); }
+
 #if ATOMIC_INT_LOCK_FREE == 2
 	using LockFreeAtomic = std::atomic<int>;
 #elif ATOMIC_LONG_LOCK_FREE == 2
@@ -127,6 +159,7 @@ private:
 	const uint32 mMaxPixelSamples;
 
 	RenderTileContext mContext;
+	LocalRenderStatistics mLocalStatistics;
 	std::chrono::high_resolution_clock::time_point mWorkStart;
 	std::chrono::microseconds mLastWorkTime;
 
@@ -145,6 +178,7 @@ private:
 
 	RenderContext* mRenderContext;
 	RenderRandomMap* mRenderRandomMap;
+	Random* mPixelRandoms; // Scratch of the acquiring thread, only used if no random map is available
 	const std::shared_ptr<ICamera> mCamera;
 };
 } // namespace PR
@@ -2,6 +2,7 @@
 #include "Logger.h"
 #include "Profiler.h"
 #include "RenderContext.h"
+#include "RenderThread.h"
 #include "RenderTile.h"
 #include "math/Bits.h"
 #include "math/Generator.h"
@@ -9,6 +10,7 @@
 namespace PR {
 RenderTileMap::RenderTileMap()
 	: mTiles()
+	, mFinishedTiles(0)
 {
 }
 
@@ -20,7 +22,14 @@ RenderTileMap::~RenderTileMap()
 void RenderTileMap::clearMap()
 {
 	Mutex::scoped_lock lock(mMutex, true);
+	for (const auto& queue : mQueues)
+		queue->Tiles.clear();
+	{
+		std::lock_guard<std::mutex> guard(mParkedMutex);
+		mParkedTiles.clear();
+	}
 	mTiles.clear();
+	mFinishedTiles = 0;
 }
 
 void RenderTileMap::init(RenderContext* context, uint32 rtx, uint32 rty, TileMode mode)
@@ -37,6 +46,10 @@ void RenderTileMap::init(RenderContext* context, uint32 rtx, uint32 rty, TileMod
 	// Clear previous data
 	clearMap();
 
+	mQueues.clear();
+	for (size_t i = 0; i < std::max<size_t>(1, context->threadCount()); ++i)
+		mQueues.emplace_back(std::make_unique<ThreadQueue>());
+
 	// New data
 	PR_ASSERT(tx * ty > 0, "Expected positive tile size");
 	mTiles.reserve(static_cast<size_t>(tx * ty));
@@ -119,29 +132,144 @@ void RenderTileMap::init(RenderContext* context, uint32 rtx, uint32 rty, TileMod
 		}
 	}
 	}
+
+	distribute();
+}
+
+inline RenderTile* RenderTileMap::ThreadQueue::popFront()
+{
+	std::lock_guard<std::mutex> guard(Mutex);
+	if (Tiles.empty())
+		return nullptr;
+
+	RenderTile* tile = Tiles.front();
+	Tiles.pop_front();
+	return tile;
+}
+
+inline RenderTile* RenderTileMap::ThreadQueue::popBack()
+{
+	std::lock_guard<std::mutex> guard(Mutex);
+	if (Tiles.empty())
+		return nullptr;
+
+	RenderTile* tile = Tiles.back();
+	Tiles.pop_back();
+	return tile;
+}
+
+void RenderTileMap::distribute()
+{
+	std::vector<RenderTile*> tiles;
+	tiles.reserve(mTiles.size());
+	for (const auto& tile : mTiles) {
+		if (!tile->isFinished())
+			tiles.push_back(tile.get());
+	}
+
+	const size_t queueCount = mQueues.size();
+	for (size_t i = 0; i < queueCount; ++i) {
+		const size_t start = i * tiles.size() / queueCount;
+		const size_t end   = (i + 1) * tiles.size() / queueCount;
+
+		std::lock_guard<std::mutex> guard(mQueues[i]->Mutex);
+		mQueues[i]->Tiles.assign(tiles.begin() + start, tiles.begin() + end);
+	}
+}
+
+void RenderTileMap::recountFinished()
+{
+	size_t finished = 0;
+	for (const auto& tile : mTiles) {
+		if (tile->isFinished())
+			++finished;
+	}
+	mFinishedTiles = finished;
 }
 
 RenderTile* RenderTileMap::getNextTile(const RenderThread* thread)
 {
 	PR_PROFILE_THIS;
 
-	Mutex::scoped_lock lock(mMutex, false);
-	for (size_t i = 0; i < mTiles.size(); ++i)
-		if (mTiles[i]->accuire(thread))
-			return mTiles[i].get();
+	if (PR_UNLIKELY(mQueues.empty()))
+		return nullptr;
+
+	const size_t self = thread->index() % mQueues.size();
+	ThreadQueue& own  = *mQueues[self];
 
+	// Work through the own queue from the front, which keeps neighboring tiles on the same thread
+	while (RenderTile* tile = own.popFront()) {
+		if (tile->accuire(thread)) {
+			++own.LocalCount;
+			return tile;
+		}
+	}
+
+	// Steal from the back of the other queues, as far away as possible from the work of the owner
+	for (size_t i = 1; i < mQueues.size(); ++i) {
+		ThreadQueue& victim = *mQueues[(self + i) % mQueues.size()];
+		while (RenderTile* tile = victim.popBack()) {
+			if (tile->accuire(thread)) {
+				++own.StolenCount;
+				return tile;
+			}
+		}
+	}
+
+	++own.FailedStealCount;
 	return nullptr;
 }
 
-bool RenderTileMap::allFinished() const
+void RenderTileMap::releaseTile(RenderTile* tile, const RenderThread* thread, bool requeue, uint32 maxIteration)
 {
-	PR_PROFILE_THIS;
+	PR_ASSERT(tile, "Expected valid tile");
 
+	// A tile can only finish while working on it, as finished tiles are never acquired
+	tile->release();
+	if (tile->isFinished()) {
+		++mFinishedTiles;
+		return;
+	}
+
+	if (!requeue)
+		return;
+
+	// Make the tile available for its next iteration right away, unless it is too far ahead of the other tiles
+	tile->makeIdle();
+	const size_t self = thread->index() % mQueues.size();
+	if (tile->iteration() > maxIteration) {
+		std::lock_guard<std::mutex> guard(mParkedMutex);
+		mParkedTiles.emplace_back(tile, self);
+	} else {
+		std::lock_guard<std::mutex> guard(mQueues[self]->Mutex);
+		mQueues[self]->Tiles.push_back(tile);
+	}
+}
+
+void RenderTileMap::unparkTiles(uint32 maxIteration)
+{
+	std::lock_guard<std::mutex> guard(mParkedMutex);
+	for (auto it = mParkedTiles.begin(); it != mParkedTiles.end();) {
+		if (it->first->iteration() > maxIteration) {
+			++it;
+			continue;
+		}
+
+		{
+			std::lock_guard<std::mutex> queueGuard(mQueues[it->second]->Mutex);
+			mQueues[it->second]->Tiles.push_back(it->first);
+		}
+		it = mParkedTiles.erase(it);
+	}
+}
+
+uint32 RenderTileMap::minIteration() const
+{
 	Mutex::scoped_lock lock(mMutex, false);
-	for (size_t i = 0; i < mTiles.size(); ++i)
-		if (!mTiles[i]->isFinished() || mTiles[i]->isWorking())
-			return false;
-	return true;
+	uint32 iteration = std::numeric_limits<uint32>::max();
+	for (const auto& tile : mTiles)
+		iteration = std::min(iteration, tile->iteration());
+	return iteration;
 }
 
 void RenderTileMap::makeAllIdle()
@@ -151,6 +279,32 @@ void RenderTileMap::makeAllIdle()
 	Mutex::scoped_lock lock(mMutex, false);
 	for (size_t i = 0; i < mTiles.size(); ++i)
 		mTiles[i]->makeIdle();
+
+	distribute();
+}
+
+uint64 RenderTileMap::localTileCount() const
+{
+	uint64 count = 0;
+	for (const auto& queue : mQueues)
+		count += queue->LocalCount;
+	return count;
+}
+
+uint64 RenderTileMap::stolenTileCount() const
+{
+	uint64 count = 0;
+	for (const auto& queue : mQueues)
+		count += queue->StolenCount;
+	return count;
+}
+
+uint64 RenderTileMap::failedStealCount() const
+{
+	uint64 count = 0;
+	for (const auto& queue : mQueues)
+		count += queue->FailedStealCount;
+	return count;
 }
 
 RenderStatistics RenderTileMap::statistics() const
@@ -189,6 +343,13 @@ void RenderTileMap::reset()
 	Mutex::scoped_lock lock(mMutex, false);
 	for (size_t i = 0; i < mTiles.size(); ++i)
 		mTiles[i]->reset();
+
+	{
+		std::lock_guard<std::mutex> guard(mParkedMutex);
+		mParkedTiles.clear();
+	}
+	recountFinished();
+	distribute();
 }
 
 void RenderTileMap::optimize()
@@ -242,5 +403,9 @@ void RenderTileMap::optimize()
 		it = mTiles.insert(it, std::move(tiles.second));
 		++it;
 	}
+
+	// Previous tile pointers are invalid now
+	recountFinished();
+	distribute();
 }
 } // namespace PR
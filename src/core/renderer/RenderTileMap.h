@@ -4,6 +4,9 @@
 #include "renderer/RenderStatistics.h"
 
 #include <tbb/queuing_rw_mutex.h>
+#include <atomic>
+#include <deque>
+#include <mutex>
 #include <vector>
 
 namespace PR {
@@ -24,8 +27,17 @@ public:
 	/// Split tiles to minimize workoverload on single tiles
 	void optimize();
 
+	/// Get the next tile of the thread's own queue or steal one from another thread.
+	/// Queues are only refilled while no thread is requesting tiles, e.g., in between iterations
 	RenderTile* getNextTile(const RenderThread* thread);
-	bool allFinished() const;
+	/// Release a tile acquired by getNextTile.
+	/// If requeue is true, an unfinished tile is queued again for its next iteration, or parked if its iteration is beyond maxIteration
+	void releaseTile(RenderTile* tile, const RenderThread* thread, bool requeue = false, uint32 maxIteration = 0);
+	/// Queue all parked tiles not beyond the given iteration again
+	void unparkTiles(uint32 maxIteration);
+	/// Smallest iteration of all tiles
+	uint32 minIteration() const;
+	inline bool allFinished() const { return mFinishedTiles >= mTiles.size(); }
 	void reset();
 	/// Unmark all tiles to prepare for next linear iteration
 	void makeAllIdle();
@@ -33,11 +45,36 @@ public:
 	RenderStatistics statistics() const;
 	double percentage() const;
 
+	// Scheduler statistics
+	uint64 localTileCount() const;
+	uint64 stolenTileCount() const;
+	uint64 failedStealCount() const;
+
 private:
 	void clearMap();
+	/// Assign all unfinished tiles to the thread queues. Consecutive tiles, which are close to each other depending on the tile mode, are given to the same thread
+	void distribute();
+	void recountFinished();
+
+	struct ThreadQueue {
+		std::mutex Mutex;
+		std::deque<RenderTile*> Tiles;
+
+		std::atomic<uint64> LocalCount{ 0 };
+		std::atomic<uint64> StolenCount{ 0 };
+		std::atomic<uint64> FailedStealCount{ 0 };
+
+		inline RenderTile* popFront();
+		inline RenderTile* popBack();
+	};
 
 	Size2i mMaxTileSize;
 	std::vector<std::unique_ptr<RenderTile>> mTiles;
+	std::vector<std::unique_ptr<ThreadQueue>> mQueues;
+	std::atomic<size_t> mFinishedTiles;
+
+	std::mutex mParkedMutex;
+	std::vector<std::pair<RenderTile*, size_t>> mParkedTiles; // Tile and queue it came from
 
 	using Mutex = tbb::queuing_rw_mutex;
 	mutable Mutex mMutex;
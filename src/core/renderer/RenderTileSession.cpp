@@ -62,19 +62,19 @@ bool RenderTileSession::traceSingleRay(const Ray& ray, Vector3f& pos, GeometryPo
 
 #ifndef PR_NO_RAY_STATISTICS
 	if (ray.Flags & RayFlag::Camera)
-		mTile->statistics().add(RenderStatisticEntry::CameraRayCount);
+		mTile->localStatistics().add(RenderStatisticEntry::CameraRayCount);
 	else if (ray.Flags & RayFlag::Light)
-		mTile->statistics().add(RenderStatisticEntry::LightRayCount);
+		mTile->localStatistics().add(RenderStatisticEntry::LightRayCount);
 
 	if (ray.Flags & RayFlag::Bounce)
-		mTile->statistics().add(RenderStatisticEntry::BounceRayCount);
+		mTile->localStatistics().add(RenderStatisticEntry::BounceRayCount);
 	else if (ray.Flags & RayFlag::Shadow) // Should not happen, but might for some bad written integrators
-		mTile->statistics().add(RenderStatisticEntry::ShadowRayCount);
+		mTile->localStatistics().add(RenderStatisticEntry::ShadowRayCount);
 	else
-		mTile->statistics().add(RenderStatisticEntry::PrimaryRayCount);
+		mTile->localStatistics().add(RenderStatisticEntry::PrimaryRayCount);
 
 	if (ray.Flags & RayFlag::Monochrome)
-		mTile->statistics().add(RenderStatisticEntry::MonochromeRayCount);
+		mTile->localStatistics().add(RenderStatisticEntry::MonochromeRayCount);
 #endif
 
 	HitEntry entry;
@@ -105,12 +105,40 @@ bool RenderTileSession::traceShadowRay(const Ray& ray, float distance) const
 	PR_PROFILE_THIS;
 
 #ifndef PR_NO_RAY_STATISTICS
-	mTile->statistics().add(RenderStatisticEntry::ShadowRayCount);
+	mTile->localStatistics().add(RenderStatisticEntry::ShadowRayCount);
 #endif
 
 	return mTile->context()->scene()->traceShadowRay(ray, distance);
 }
 
+void RenderTileSession::pushDeferredSpectralFragment(const SpectralBlob& mis, const SpectralBlob& importance, const SpectralBlob& radiance,
+													 const Ray& shadow, const LightPath& path, float distance) const
+{
+	PR_PROFILE_THIS;
+
+#ifndef PR_NO_RAY_STATISTICS
+	mTile->localStatistics().add(RenderStatisticEntry::ShadowRayCount);
+#endif
+
+	ShadowRayQueue& queue = mPipeline->shadowRayQueue();
+	if (!queue.enoughSpace())
+		resolveShadowRays();
+
+	Ray ray	 = shadow;
+	ray.MaxT = distance;
+
+	// The path is only valid now, therefore match it before deferring
+	uint64* matches = queue.add(ray, mis, importance, radiance);
+	if (matches)
+		mOutputQueue->matchLPE(path, matches);
+}
+
+void RenderTileSession::resolveShadowRays() const
+{
+	PR_PROFILE_THIS;
+	mPipeline->shadowRayQueue().resolve(mTile->context()->scene().get(), *this);
+}
+
 Point2i RenderTileSession::globalCoordinates(Point1i pixelIndex) const
 {
 	const Size1i slice = mTile->context()->viewSize().Width;
@@ -142,6 +170,18 @@ void RenderTileSession::pushSpectralFragment(const SpectralBlob& mis, const Spec
 		mOutputQueue->commitAndFlush(mLocalSystem.get());
 }
 
+void RenderTileSession::pushSpectralFragment(const SpectralBlob& mis, const SpectralBlob& importance, const SpectralBlob& radiance,
+											 const Ray& ray, const uint64* lpeMatches) const
+{
+	PR_PROFILE_THIS;
+	auto coords		= localCoordinates(ray.PixelIndex);
+	const auto& grp = getRayGroup(ray);
+	mOutputQueue->pushSpectralFragment(coords, mis, grp.Importance * importance, radiance,
+									   ray.WavelengthNM, ray.Flags & RayFlag::Monochrome, ray.GroupID, lpeMatches);
+	if (mOutputQueue->isReadyToCommit())
+		mOutputQueue->commitAndFlush(mLocalSystem.get());
+}
+
 void RenderTileSession::pushSPFragment(const IntersectionPoint& pt,
 									   const LightPath& path) const
 {
@@ -39,6 +39,8 @@ public:
 	inline Random& random(RandomSlot slot) { return mTile->random(slot); }
 	inline Random& random(const Point2i& globalP) { return mTile->random(globalP); }
 	inline Random& random(const Point1i& rayLocalPixelIndex) { return random(globalCoordinates(rayLocalPixelIndex)); }
+	inline float pathSample1D(const Point1i& rayLocalPixelIndex, uint32 dimension) { return mTile->pathSample1D(globalCoordinates(rayLocalPixelIndex), dimension); }
+	inline Vector2f pathSample2D(const Point1i& rayLocalPixelIndex, uint32 dimension) { return mTile->pathSample2D(globalCoordinates(rayLocalPixelIndex), dimension); }
 	inline StreamPipeline* pipeline() const { return mPipeline; }
 
 	IEntity* getEntity(uint32 id) const;
@@ -51,8 +53,17 @@ public:
 	bool traceSingleRay(const Ray& ray, Vector3f& pos, GeometryPoint& pt, IEntity*& entity, IMaterial*& material) const;
 	bool traceShadowRay(const Ray& ray, float distance = PR_INF) const;
 
+	/// Push a spectral fragment which is only contributing if the given shadow ray is not occluded.
+	/// The actual shadow test is deferred and done in batches. Call resolveShadowRays() before the tile is finished
+	void pushDeferredSpectralFragment(const SpectralBlob& mis, const SpectralBlob& importance, const SpectralBlob& radiance,
+									  const Ray& shadow, const LightPath& path, float distance = PR_INF) const;
+	void resolveShadowRays() const;
+
 	void pushSpectralFragment(const SpectralBlob& mis, const SpectralBlob& importance, const SpectralBlob& radiance,
 							  const Ray& ray, const LightPath& path) const;
+	/// Push a spectral fragment with already matched LPEs, see LocalOutputQueue::matchLPE()
+	void pushSpectralFragment(const SpectralBlob& mis, const SpectralBlob& importance, const SpectralBlob& radiance,
+							  const Ray& ray, const uint64* lpeMatches) const;
 	void pushSPFragment(const IntersectionPoint& pt, const LightPath& path) const;
 	void pushFeedbackFragment(uint32 feedback, const Ray& ray) const;
 
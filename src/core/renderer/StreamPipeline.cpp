@@ -1,9 +1,11 @@
 #include "StreamPipeline.h"
+#include "ConvergenceMap.h"
 #include "Profiler.h"
 #include "RenderContext.h"
 #include "RenderTile.h"
 #include "camera/ICamera.h"
 #include "math/Bits.h"
+#include "output/OutputSystem.h"
 
 namespace PR {
 StreamPipeline::StreamPipeline(RenderContext* ctx)
@@ -13,6 +15,7 @@ StreamPipeline::StreamPipeline(RenderContext* ctx)
 	, mReadRayStream(std::make_unique<RayStream>(ctx->settings().maxParallelRays))
 	, mHitStream(ctx->settings().maxParallelRays)
 	, mGroupContainer()
+	, mShadowRayQueue(ctx->settings().maxParallelRays, ctx->output()->lpeGroups().size())
 	, mCurrentVirtualPixelIndex(0)
 	, mCurrentPixelIndex(0)
 	, mMaxPixelCount(0)
@@ -35,6 +38,7 @@ void StreamPipeline::reset(RenderTile* tile)
 	mReadRayStream->reset();
 	mHitStream.reset();
 	mGroupContainer.reset();
+	mShadowRayQueue.reset();
 }
 
 bool StreamPipeline::isFinished() const
@@ -66,6 +70,10 @@ void StreamPipeline::runPipeline()
 	std::swap(mWriteRayStream, mReadRayStream);
 	mWriteRayStream->reset();
 
+	// Reorder rays for more coherent traversal
+	if (mContext->settings().reorderRays)
+		mReadRayStream->reorder(mContext->scene()->boundingBox());
+
 	// Trace rays
 	mHitStream.reset();
 	mContext->scene()->traceRays(
@@ -77,7 +85,8 @@ void StreamPipeline::runPipeline()
 		return;
 
 	// Setup hit stream
-	mHitStream.setup(mContext->settings().sortHits);
+	mHitStream.setup(mContext->settings().sortHits, mContext->settings().hitSortKeys,
+					 *mReadRayStream, *mContext->scene());
 }
 
 void StreamPipeline::fillWithCameraRays()
@@ -85,7 +94,8 @@ void StreamPipeline::fillWithCameraRays()
 	const Size2i size  = mTile->viewSize();
 	const uint32 slice = mTile->imageSize().Width;
 
-	const RenderIteration iter = mContext->currentIteration();
+	const RenderIteration iter			 = mContext->tileIteration(mTile);
+	const ConvergenceMap* convergenceMap = mContext->convergenceMap();
 	while (mCurrentPixelIndex < mMaxPixelCount) {
 		if (mWriteRayStream->isFull() || mContext->isStopping())
 			break;
@@ -101,6 +111,14 @@ void StreamPipeline::fillWithCameraRays()
 
 		const Point2i p = Point2i(x, y) + mTile->start();
 
+		// Converged pixels are frozen, but still count towards the tile being finished.
+		// Pixels near unconverged blocks are still sampled, as their filter splats contribute to the unconverged neighbours
+		if (convergenceMap && !convergenceMap->needsSamples(p)) {
+			mTile->skipPixelSample();
+			++mCurrentPixelIndex;
+			continue;
+		}
+
 		std::optional<CameraRay> camera_ray = mTile->constructCameraRay(p, iter);
 		if (camera_ray.has_value()) {
 			uint32 grp_id;
@@ -11,6 +11,7 @@
 #include "scene/Scene.h"
 #include "shader/ShadingGroup.h"
 #include "trace/HitStream.h"
+#include "trace/ShadowRayQueue.h"
 
 namespace PR {
 class RenderTile;
@@ -25,6 +26,9 @@ public:
 	void runPipeline();
 
 	inline void enqueueCameraRay(const Ray& ray);
+	/// Enqueue a ray to be traced in the next pipeline run.
+	/// Rays enqueued while handling shading groups are traced before new camera rays are generated,
+	/// therefore at most one bounce ray per traced ray is allowed. Use Ray::PathID to track the path state
 	inline void enqueueBounceRay(const Ray& ray);
 	inline void enqueueLightRay(const Ray& ray);
 
@@ -34,6 +38,9 @@ public:
 	inline bool hasShadingGroup() const;
 	inline ShadingGroup popShadingGroup(const RenderTileSession& session);
 
+	/// Shadow rays queued while handling shading groups. Has to be resolved before the tile is finished
+	inline ShadowRayQueue& shadowRayQueue() { return mShadowRayQueue; }
+
 private:
 	void fillWithCameraRays();
 
@@ -43,6 +50,7 @@ private:
 	std::unique_ptr<RayStream> mReadRayStream;
 	HitStream mHitStream;
 	RayGroupContainer mGroupContainer;
+	ShadowRayQueue mShadowRayQueue;
 
 	uint64 mCurrentVirtualPixelIndex;
 	uint64 mCurrentPixelIndex;
@@ -4,8 +4,8 @@ inline void StreamPipeline::enqueueCameraRay(const Ray& ray)
 {
 	mWriteRayStream->addRay(ray);
 #ifndef PR_NO_RAY_STATISTICS
-	mTile->statistics().add(RenderStatisticEntry::CameraRayCount);
-	mTile->statistics().add(RenderStatisticEntry::PrimaryRayCount);
+	mTile->localStatistics().add(RenderStatisticEntry::CameraRayCount);
+	mTile->localStatistics().add(RenderStatisticEntry::PrimaryRayCount);
 #endif
 }
 
@@ -13,20 +13,24 @@ inline void StreamPipeline::enqueueLightRay(const Ray& ray)
 {
 	mWriteRayStream->addRay(ray);
 #ifndef PR_NO_RAY_STATISTICS
-	mTile->statistics().add(RenderStatisticEntry::LightRayCount);
-	mTile->statistics().add(RenderStatisticEntry::PrimaryRayCount);
+	mTile->localStatistics().add(RenderStatisticEntry::LightRayCount);
+	mTile->localStatistics().add(RenderStatisticEntry::PrimaryRayCount);
 #endif
 }
 
 inline void StreamPipeline::enqueueBounceRay(const Ray& ray)
 {
+	PR_ASSERT(mWriteRayStream->enoughSpace(), "Only one bounce ray per traced ray is allowed");
 	mWriteRayStream->addRay(ray);
 #ifndef PR_NO_RAY_STATISTICS
 	if (ray.Flags & RayFlag::Camera)
-		mTile->statistics().add(RenderStatisticEntry::CameraRayCount);
+		mTile->localStatistics().add(RenderStatisticEntry::CameraRayCount);
 	else if (ray.Flags & RayFlag::Light)
-		mTile->statistics().add(RenderStatisticEntry::LightRayCount);
-	mTile->statistics().add(RenderStatisticEntry::BounceRayCount);
+		mTile->localStatistics().add(RenderStatisticEntry::LightRayCount);
+	mTile->localStatistics().add(RenderStatisticEntry::BounceRayCount);
+
+	if (ray.Flags & RayFlag::Monochrome)
+		mTile->localStatistics().add(RenderStatisticEntry::MonochromeRayCount);
 #endif
 }
 
@@ -46,6 +50,12 @@ inline ShadingGroup StreamPipeline::popShadingGroup(const RenderTileSession& ses
 {
 	PR_ASSERT(hasShadingGroup(), "Trying to pop non existant shading group");
 
-	return ShadingGroup(mHitStream.getNextGroup(), this, session);
+	const ShadingGroupBlock block = mHitStream.getNextGroup();
+#ifndef PR_NO_RAY_STATISTICS
+	mTile->localStatistics().add(RenderStatisticEntry::ShadingGroupCount);
+	mTile->localStatistics().add(RenderStatisticEntry::ShadingGroupHitCount, block.size());
+#endif
+
+	return ShadingGroup(block, this, session);
 }
 } // namespace PR
@@ -15,10 +15,33 @@ public:
 	virtual float generate1D(Random& rnd, uint32 index)	   = 0;
 	virtual Vector2f generate2D(Random& rnd, uint32 index) = 0;
 
+	/// Request a sample of the given dimension. A 2D sample occupies the dimensions [dimension, dimension+1]
+	/// Samplers not supporting dimensions ignore it and use the variants above
+	virtual float generate1D(Random& rnd, uint32 index, uint32 dimension)
+	{
+		PR_UNUSED(dimension);
+		return generate1D(rnd, index);
+	}
+
+	virtual Vector2f generate2D(Random& rnd, uint32 index, uint32 dimension)
+	{
+		PR_UNUSED(dimension);
+		return generate2D(rnd, index);
+	}
+
+	/// True if the sampler generates decorrelated samples for different dimensions of the same index.
+	/// Only such samplers are used for dimensions beyond the camera, as others would correlate the bounces with the camera sample
+	virtual bool supportsDimensions() const { return false; }
+
+	/// Seed used to decorrelate the sequences of, e.g., different pixels. Ignored by most samplers
+	inline void setSequenceSeed(uint64 seed) { mSequenceSeed = seed; }
+	inline uint64 sequenceSeed() const { return mSequenceSeed; }
+
 	inline uint32 maxSamples() const { return mMaxSamples; }
 	inline bool isProgressive() const { return maxSamples() == 0; }
 
 private:
 	const uint32 mMaxSamples;
+	uint64 mSequenceSeed = 0;
 };
 } // namespace PR
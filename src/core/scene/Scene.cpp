@@ -12,6 +12,8 @@
 
 #include "Logger.h"
 
+#include <numeric>
+
 namespace PR {
 Scene::Scene(const std::shared_ptr<ServiceObserver>& serviceObserver,
 			 const std::shared_ptr<ICamera>& activeCamera,
@@ -120,7 +122,9 @@ void Scene::setupScene()
 }
 
 constexpr unsigned int MASK_ALL = 0xFFFFFFF;
-constexpr int VALID_ALL			= -1; //0xFF;
+
+// FIXME: What is the perfect value for that??
+constexpr float SHADOW_DISTANCE_EPS = 0.001f;
 inline static void assignRay(const Ray& ray, RTCRay& rray)
 {
 	rray.org_x = ray.Origin[0];
@@ -135,85 +139,144 @@ inline static void assignRay(const Ray& ray, RTCRay& rray)
 	rray.mask  = MASK_ALL;
 }
 
-void Scene::traceRays(RayStream& rays, HitStream& hits) const
+/// Buffers required by the embree stream interface which are not part of the ray stream
+struct StreamBuffer {
+	std::vector<float> TFar;
+	std::vector<float> Time;
+	std::vector<unsigned int> Mask;
+	std::vector<unsigned int> ID;
+	std::vector<unsigned int> Flags;
+
+	std::vector<float> Ng[3];
+	std::vector<float> U;
+	std::vector<float> V;
+	std::vector<unsigned int> PrimID;
+	std::vector<unsigned int> GeomID;
+	std::vector<unsigned int> InstID;
+
+	inline void setupRays(const RaySpan& grp, float tfarOffset)
+	{
+		const size_t size = grp.size();
+		TFar.resize(size);
+		Time.resize(size, 0.0f);
+		Mask.resize(size, MASK_ALL);
+		Flags.resize(size, 0);
+		ID.resize(size);
+
+		grp.copyMaxTRaw(0, size, TFar.data());
+
+		std::iota(ID.begin(), ID.end(), 0u);
+
+		PR_OPT_LOOP
+		for (size_t k = 0; k < size; ++k)
+			TFar[k] -= tfarOffset;
+	}
+
+	inline void setupHits(size_t size)
+	{
+		for (int i = 0; i < 3; ++i)
+			Ng[i].resize(size);
+		U.resize(size);
+		V.resize(size);
+		PrimID.resize(size);
+		GeomID.resize(size);
+		InstID.resize(size);
+
+		std::fill_n(GeomID.begin(), size, RTC_INVALID_GEOMETRY_ID);
+		std::fill_n(InstID.begin(), size, RTC_INVALID_GEOMETRY_ID);
+	}
+
+	// Embree does not modify the input data, except tfar which is not taken from the ray stream
+	inline RTCRayNp rayNp(const RaySpan& grp)
+	{
+		RTCRayNp rays;
+		rays.org_x = const_cast<float*>(grp.originData(0));
+		rays.org_y = const_cast<float*>(grp.originData(1));
+		rays.org_z = const_cast<float*>(grp.originData(2));
+		rays.dir_x = const_cast<float*>(grp.directionData(0));
+		rays.dir_y = const_cast<float*>(grp.directionData(1));
+		rays.dir_z = const_cast<float*>(grp.directionData(2));
+		rays.tnear = const_cast<float*>(grp.minTData());
+		rays.tfar  = TFar.data();
+		rays.time  = Time.data();
+		rays.mask  = Mask.data();
+		rays.id	   = ID.data();
+		rays.flags = Flags.data();
+		return rays;
+	}
+
+	inline RTCHitNp hitNp()
+	{
+		RTCHitNp hits;
+		hits.Ng_x	   = Ng[0].data();
+		hits.Ng_y	   = Ng[1].data();
+		hits.Ng_z	   = Ng[2].data();
+		hits.u		   = U.data();
+		hits.v		   = V.data();
+		hits.primID	   = PrimID.data();
+		hits.geomID	   = GeomID.data();
+		hits.instID[0] = InstID.data();
+		return hits;
+	}
+};
+
+// Each thread has its own buffers, as the scene is shared
+static thread_local StreamBuffer sStreamBuffer;
+
+static void traceSpan(RTCScene scene, const RaySpan& grp, RTCIntersectContextFlags flags, HitStream& hits)
 {
-	constexpr size_t PACKAGE_SIZE = 16;
+	const size_t size = grp.size();
+	sStreamBuffer.setupRays(grp, 0.0f);
+	sStreamBuffer.setupHits(size);
 
-	// Split stream into specific groups
-	hits.reset();
+	RTCRayHitNp rhits;
+	rhits.ray = sStreamBuffer.rayNp(grp);
+	rhits.hit = sStreamBuffer.hitNp();
+
+	RTCIntersectContext ctx;
+	rtcInitIntersectContext(&ctx);
+	ctx.flags = flags;
+	rtcIntersectNp(scene, &ctx, &rhits, static_cast<unsigned int>(size));
+
+	for (size_t k = 0; k < size; ++k) {
+		const bool good = sStreamBuffer.GeomID[k] != RTC_INVALID_GEOMETRY_ID;
+		const auto id	= sStreamBuffer.InstID[k] != RTC_INVALID_GEOMETRY_ID ? sStreamBuffer.InstID[k] : sStreamBuffer.GeomID[k];
+
+		HitEntry entry;
+		entry.EntityID	  = good ? id : PR_INVALID_ID;
+		entry.PrimitiveID = sStreamBuffer.PrimID[k];
+		entry.RayID		  = grp.offset() + k;
+		entry.Parameter	  = Vector3f(sStreamBuffer.U[k], sStreamBuffer.V[k], sStreamBuffer.TFar[k]);
+		hits.add(entry);
+	}
+}
+
+static void traceShadowSpan(RTCScene scene, const RaySpan& grp, RTCIntersectContextFlags flags, std::vector<bool>& occluded)
+{
+	const size_t size = grp.size();
+	sStreamBuffer.setupRays(grp, SHADOW_DISTANCE_EPS);
+
+	const RTCRayNp rrays = sStreamBuffer.rayNp(grp);
 
-	auto scene = mInternal->Scene;
 	RTCIntersectContext ctx;
-	RTCRayHit16 rhits;
+	rtcInitIntersectContext(&ctx);
+	ctx.flags = flags;
+	rtcOccludedNp(scene, &ctx, &rrays, static_cast<unsigned int>(size));
 
-	alignas(64) int valids[PACKAGE_SIZE];
-	std::fill_n(valids, PACKAGE_SIZE, VALID_ALL); // All are valid
+	for (size_t k = 0; k < size; ++k)
+		occluded[grp.offset() + k] = sStreamBuffer.TFar[k] == -PR_INF;
+}
+
+void Scene::traceRays(RayStream& rays, HitStream& hits) const
+{
+	// Split stream into specific groups
+	hits.reset();
 
 	while (rays.hasNextSpan()) {
-		RaySpan grp = rays.getNextSpan();
+		const RaySpan grp = rays.getNextSpan();
 
 		const RTCIntersectContextFlags flags = grp.isCoherent() ? RTC_INTERSECT_CONTEXT_FLAG_COHERENT : RTC_INTERSECT_CONTEXT_FLAG_INCOHERENT;
-
-		// Split group into cells of max 16 rays each
-		const size_t cells = grp.size() / PACKAGE_SIZE;
-		for (size_t i = 0; i < cells; ++i) {
-			PR_OPT_LOOP
-			for (size_t k = 0; k < PACKAGE_SIZE; ++k) {
-				rhits.hit.geomID[k]	   = RTC_INVALID_GEOMETRY_ID;
-				rhits.hit.instID[0][k] = RTC_INVALID_GEOMETRY_ID;
-				rhits.ray.flags[k]	   = 0;
-				rhits.ray.id[k]		   = k;
-				rhits.ray.mask[k]	   = MASK_ALL;
-			}
-
-			grp.copyOriginXRaw(i * PACKAGE_SIZE, PACKAGE_SIZE, rhits.ray.org_x);
-			grp.copyOriginYRaw(i * PACKAGE_SIZE, PACKAGE_SIZE, rhits.ray.org_y);
-			grp.copyOriginZRaw(i * PACKAGE_SIZE, PACKAGE_SIZE, rhits.ray.org_z);
-			grp.copyDirectionXRaw(i * PACKAGE_SIZE, PACKAGE_SIZE, rhits.ray.dir_x);
-			grp.copyDirectionYRaw(i * PACKAGE_SIZE, PACKAGE_SIZE, rhits.ray.dir_y);
-			grp.copyDirectionZRaw(i * PACKAGE_SIZE, PACKAGE_SIZE, rhits.ray.dir_z);
-			grp.copyMaxTRaw(i * PACKAGE_SIZE, PACKAGE_SIZE, rhits.ray.tfar);
-			grp.copyMinTRaw(i * PACKAGE_SIZE, PACKAGE_SIZE, rhits.ray.tnear);
-
-			rtcInitIntersectContext(&ctx);
-			ctx.flags = flags;
-			rtcIntersect16(valids, scene, &ctx, &rhits);
-
-			PR_OPT_LOOP
-			for (size_t k = 0; k < PACKAGE_SIZE; ++k) {
-				const bool good = rhits.hit.geomID[k] != RTC_INVALID_GEOMETRY_ID;
-				const auto id	= rhits.hit.instID[0][k] != RTC_INVALID_GEOMETRY_ID ? rhits.hit.instID[0][k] : rhits.hit.geomID[k];
-
-				HitEntry entry;
-				entry.EntityID	  = good ? id : PR_INVALID_ID;
-				entry.PrimitiveID = rhits.hit.primID[k];
-				entry.RayID		  = grp.offset() + i * PACKAGE_SIZE + rhits.ray.id[k];
-				entry.Parameter	  = Vector3f(rhits.hit.u[k], rhits.hit.v[k], rhits.ray.tfar[k]);
-				hits.add(entry);
-			}
-		}
-
-		// Trace remaining rays which did not fit into a 16 package cell
-		for (size_t k = cells * PACKAGE_SIZE; k < grp.size(); ++k) {
-			RTCRayHit rhit;
-			assignRay(grp.getRay(k), rhit.ray);
-			rhit.hit.geomID	   = RTC_INVALID_GEOMETRY_ID;
-			rhit.hit.instID[0] = RTC_INVALID_GEOMETRY_ID;
-
-			rtcInitIntersectContext(&ctx);
-			ctx.flags = flags;
-			rtcIntersect1(mInternal->Scene, &ctx, &rhit);
-
-			const bool good = rhit.hit.geomID != RTC_INVALID_GEOMETRY_ID;
-			const auto id	= rhit.hit.instID[0] != RTC_INVALID_GEOMETRY_ID ? rhit.hit.instID[0] : rhit.hit.geomID;
-
-			HitEntry entry;
-			entry.EntityID	  = good ? id : PR_INVALID_ID;
-			entry.PrimitiveID = rhit.hit.primID;
-			entry.RayID		  = grp.offset() + k;
-			entry.Parameter	  = Vector3f(rhit.hit.u, rhit.hit.v, rhit.ray.tfar);
-			hits.add(entry);
-		}
+		traceSpan(mInternal->Scene, grp, flags, hits);
 	}
 }
 
@@ -272,13 +335,25 @@ bool Scene::traceShadowRay(const Ray& ray, float distance) const
 	RTCRay rray;
 	assignRay(ray, rray);
 
-	rray.tfar = distance - 0.001f; // FIXME: What is the perfect value for that??
+	rray.tfar = distance - SHADOW_DISTANCE_EPS;
 
 	rtcOccluded1(mInternal->Scene, &ctx, &rray);
 
 	return rray.tfar == -PR_INF; // RTCRay.tfar is set to -inf if hit anything
 }
 
+void Scene::traceShadowRays(RayStream& rays, std::vector<bool>& occluded) const
+{
+	occluded.resize(rays.currentSize());
+
+	while (rays.hasNextSpan()) {
+		const RaySpan grp = rays.getNextSpan();
+
+		const RTCIntersectContextFlags flags = grp.isCoherent() ? RTC_INTERSECT_CONTEXT_FLAG_COHERENT : RTC_INTERSECT_CONTEXT_FLAG_INCOHERENT;
+		traceShadowSpan(mInternal->Scene, grp, flags, occluded);
+	}
+}
+
 size_t Scene::entityCount() const { return mDatabase->Entities->size(); }
 size_t Scene::emissionCount() const { return mDatabase->Emissions->size(); }
 size_t Scene::materialCount() const { return mDatabase->Materials->size(); }
@@ -47,6 +47,8 @@ public:
 	bool traceSingleRay(const Ray& ray, Vector3f& pos, GeometryPoint& pt) const;
 	/// Traces a single ray and returns true if something lays within the given distance
 	bool traceShadowRay(const Ray& ray, float distance = PR_INF) const override;
+	/// Traces a stream of shadow rays and marks each ray as occluded if something lays within its maximum distance
+	void traceShadowRays(RayStream& rays, std::vector<bool>& occluded) const override;
 
 	inline virtual BoundingBox boundingBox() const override { return mBoundingBox; }
 	inline const Sphere& boundingSphere() const { return mBoundingSphere; }
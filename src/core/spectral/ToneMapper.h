@@ -28,6 +28,13 @@ public:
 	inline float scale() const { return mScale; }
 	inline void setScale(float s) { mScale = s; }
 
+	/// Copy all settings of the given tone mapper
+	inline void copyFrom(const ToneMapper& other)
+	{
+		mColorMode = other.mColorMode;
+		mScale	   = other.mScale;
+	}
+
 private:
 	ToneColorMode mColorMode;
 	float mScale;
@@ -1,5 +1,8 @@
 #include "HitStream.h"
 #include "Profiler.h"
+#include "entity/IEntity.h"
+#include "ray/RayStream.h"
+#include "scene/Scene.h"
 
 // Prefer radix sort, as it is much more cache friendly in OUR case
 // due to the high swap penalty
@@ -13,7 +16,8 @@
 namespace PR {
 
 HitStream::HitStream(size_t size)
-	: mSize(size + size % 16) // Safety offset
+	: mSortKeyBits(0)
+	, mSize(size + size % 16) // Safety offset
 	, mCurrentPos(0)
 {
 	mRayID.reserve(mSize);
@@ -21,6 +25,7 @@ HitStream::HitStream(size_t size)
 	mPrimitiveID.reserve(mSize);
 	for (int i = 0; i < 3; ++i)
 		mParameter[i].reserve(mSize);
+	mSortKey.reserve(mSize);
 }
 
 HitStream::~HitStream()
@@ -54,7 +59,80 @@ HitEntry HitStream::get(size_t index) const
 	return entry;
 }
 
-void HitStream::setup(bool sort)
+// Amount of bits required to represent the given value
+inline static uint32 requiredBits(uint32 v)
+{
+	return v == 0 ? 0 : 32 - clz(v);
+}
+
+void HitStream::computeSortKeys(HitSortKeys keys, const RayStream& rays, const Scene& scene)
+{
+	PR_PROFILE_THIS;
+
+	const size_t size = currentSize();
+	mSortKey.resize(size);
+
+	// Gather the range of all keys first to pack them as tight as possible
+	uint32 maxEntityID	  = 0;
+	uint32 maxPrimitiveID = 0;
+	for (size_t i = 0; i < size; ++i) {
+		if (mEntityID[i] != PR_INVALID_ID)
+			maxEntityID = std::max(maxEntityID, mEntityID[i]);
+		maxPrimitiveID = std::max(maxPrimitiveID, mPrimitiveID[i]);
+	}
+
+	// Use the sort key as temporary storage for the material slots
+	uint32 maxMaterialSlot = 0;
+	if (keys & HitSortKey::Material) {
+		uint32 lastEntityID	  = PR_INVALID_ID;
+		const IEntity* entity = nullptr;
+		for (size_t i = 0; i < size; ++i) {
+			if (mEntityID[i] == PR_INVALID_ID) {
+				mSortKey[i] = 0;
+				continue;
+			}
+
+			if (mEntityID[i] != lastEntityID) {
+				lastEntityID = mEntityID[i];
+				entity		 = scene.getEntity(lastEntityID);
+			}
+
+			const uint32 slot = entity ? entity->localMaterialSlot(mPrimitiveID[i]) : 0;
+			maxMaterialSlot	  = std::max(maxMaterialSlot, slot);
+			mSortKey[i]		  = slot;
+		}
+	}
+
+	// Background hits are mapped to the last entity slot
+	const uint32 entityBits	   = requiredBits(maxEntityID + 1);
+	const uint32 materialBits  = (keys & HitSortKey::Material) ? requiredBits(maxMaterialSlot) : 0;
+	const uint32 octantBits	   = (keys & HitSortKey::Direction) ? 3 : 0;
+	const uint32 primitiveBits = (keys & HitSortKey::Primitive) ? requiredBits(maxPrimitiveID) : 0;
+
+	// Drop the least significant parts if the keys do not fit into 64 bits
+	const uint32 totalBits	   = entityBits + materialBits + octantBits + primitiveBits;
+	const uint32 excess		   = totalBits > 64 ? totalBits - 64 : 0;
+	const uint32 primitiveDrop = std::min(excess, primitiveBits);
+	const uint32 materialDrop  = std::min(excess - primitiveDrop, materialBits);
+
+	mSortKeyBits = totalBits - primitiveDrop - materialDrop;
+
+	for (size_t i = 0; i < size; ++i) {
+		const uint64 entity = mEntityID[i] == PR_INVALID_ID ? maxEntityID + 1 : mEntityID[i];
+
+		uint64 key = entity;
+		if (materialBits > materialDrop)
+			key = (key << (materialBits - materialDrop)) | (mSortKey[i] >> materialDrop);
+		if (octantBits > 0)
+			key = (key << octantBits) | rays.directionOctant(mRayID[i]);
+		if (primitiveBits > primitiveDrop)
+			key = (key << (primitiveBits - primitiveDrop)) | (mPrimitiveID[i] >> primitiveDrop);
+
+		mSortKey[i] = key;
+	}
+}
+
+void HitStream::setup(bool sort, HitSortKeys keys, const RayStream& rays, const Scene& scene)
 {
 	PR_PROFILE_THIS;
 
@@ -62,9 +140,12 @@ void HitStream::setup(bool sort)
 		return;
 
 	if (sort) {
+		computeSortKeys(keys, rays, scene);
+
 		// Swapping the whole context is quite heavy,
 		// but a single vector solution requires additional memory
 		auto op = [&](size_t a, size_t b) {
+			std::swap(mSortKey[a], mSortKey[b]);
 			std::swap(mRayID[a], mRayID[b]);
 			std::swap(mEntityID[a], mEntityID[b]);
 			std::swap(mPrimitiveID[a], mPrimitiveID[b]);
@@ -73,11 +154,13 @@ void HitStream::setup(bool sort)
 		};
 
 #ifdef PR_USE_RADIXSORT
-		uint32 mask = msb(currentSize());
-		radixSort(mEntityID.data(), op,
-				  0, currentSize() - 1, mask);
+		if (mSortKeyBits > 0) {
+			const uint64 mask = uint64(1) << (mSortKeyBits - 1);
+			radixSort(mSortKey.data(), op,
+					  0, currentSize() - 1, mask);
+		}
 #else
-		quickSort(mEntityID.data(), op,
+		quickSort(mSortKey.data(), op,
 				  0, currentSize() - 1);
 #endif
 	}
@@ -94,6 +177,7 @@ void HitStream::reset()
 	mPrimitiveID.clear();
 	for (int i = 0; i < 3; ++i)
 		mParameter[i].clear();
+	mSortKey.clear();
 
 	mCurrentPos = 0;
 }
@@ -120,7 +204,7 @@ ShadingGroupBlock HitStream::getNextGroup()
 
 size_t HitStream::getMemoryUsage() const
 {
-	return mSize * (3 * sizeof(uint32) + 3 * sizeof(float));
+	return mSize * (3 * sizeof(uint32) + 3 * sizeof(float) + sizeof(uint64));
 }
 
 } // namespace PR
@@ -1,12 +1,15 @@
 #pragma once
 
 #include "HitEntry.h"
+#include "renderer/RenderEnums.h"
 #include "shader/ShadingGroupBlock.h"
 
 #include <array>
 #include <vector>
 
 namespace PR {
+class RayStream;
+class Scene;
 
 class PR_LIB_CORE HitStream {
 public:
@@ -24,19 +27,25 @@ public:
 
 	/* Sort order:
 	ENTITY_ID,
-	MATERIAL_ID
+	MATERIAL_SLOT (if HitSortKey::Material),
+	DIRECTION_OCTANT (if HitSortKey::Direction),
+	PRIMITIVE_ID (if HitSortKey::Primitive)
 	*/
-	void setup(bool sort);
+	void setup(bool sort, HitSortKeys keys, const RayStream& rays, const Scene& scene);
 	void reset();
 	ShadingGroupBlock getNextGroup();
 
 	size_t getMemoryUsage() const;
 
 private:
+	void computeSortKeys(HitSortKeys keys, const RayStream& rays, const Scene& scene);
+
 	std::vector<uint32> mRayID;
 	std::vector<uint32> mEntityID;
 	std::vector<uint32> mPrimitiveID;
 	std::vector<float> mParameter[3];
+	std::vector<uint64> mSortKey;
+	uint32 mSortKeyBits;
 
 	size_t mSize;
 	size_t mCurrentPos;
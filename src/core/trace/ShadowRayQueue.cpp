@@ -0,0 +1,64 @@
+#include "ShadowRayQueue.h"
+#include "Profiler.h"
+#include "renderer/RenderTileSession.h"
+#include "scene/Scene.h"
+
+namespace PR {
+ShadowRayQueue::ShadowRayQueue(size_t size, size_t matchCount)
+	: mRays(size)
+	, mMatchData(mRays.maxSize() * matchCount)
+	, mMatchCount(matchCount)
+{
+	mEntries.reserve(mRays.maxSize());
+	mOccluded.reserve(mRays.maxSize());
+}
+
+ShadowRayQueue::~ShadowRayQueue()
+{
+}
+
+uint64* ShadowRayQueue::add(const Ray& shadow, const SpectralBlob& mis, const SpectralBlob& importance, const SpectralBlob& radiance)
+{
+	PR_PROFILE_THIS;
+
+	PR_ASSERT(enoughSpace(), "Check before adding!");
+
+	const size_t offset = mEntries.size() * mMatchCount;
+	mRays.addRay(shadow);
+	mEntries.push_back(Entry{ mis, importance, radiance, offset });
+
+	return mMatchCount > 0 ? &mMatchData[offset] : nullptr;
+}
+
+void ShadowRayQueue::resolve(const Scene* scene, const RenderTileSession& session)
+{
+	PR_PROFILE_THIS;
+
+	if (isEmpty())
+		return;
+
+	scene->traceShadowRays(mRays, mOccluded);
+
+	for (size_t i = 0; i < mEntries.size(); ++i) {
+		const Entry& entry = mEntries[i];
+
+		// Occluded fragments are still pushed, as they count as a sample
+		session.pushSpectralFragment(entry.MIS, entry.Importance,
+									 mOccluded[i] ? SpectralBlob::Zero() : entry.Radiance,
+									 mRays.getRay(i), mMatchCount > 0 ? &mMatchData[entry.MatchOffset] : nullptr);
+	}
+
+	reset();
+}
+
+void ShadowRayQueue::reset()
+{
+	mRays.reset();
+	mEntries.clear();
+}
+
+size_t ShadowRayQueue::getMemoryUsage() const
+{
+	return mRays.getMemoryUsage() + mEntries.capacity() * sizeof(Entry) + mMatchData.size() * sizeof(uint64);
+}
+} // namespace PR
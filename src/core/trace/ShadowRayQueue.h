@@ -0,0 +1,51 @@
+#pragma once
+
+#include "ray/RayStream.h"
+#include "spectral/SpectralBlob.h"
+
+#include <vector>
+
+namespace PR {
+class RenderTileSession;
+class Scene;
+
+/// Queue of spectral fragments which only contribute if the corresponding shadow ray is not occluded.
+/// All shadow rays are traced at once with Scene::traceShadowRays when the queue is resolved
+class PR_LIB_CORE ShadowRayQueue {
+public:
+	/// The match count is the number of LPE groups of the output system, see OutputSystem::lpeGroups()
+	ShadowRayQueue(size_t size, size_t matchCount);
+	~ShadowRayQueue();
+
+	inline bool isEmpty() const { return mRays.isEmpty(); }
+	inline size_t currentSize() const { return mRays.currentSize(); }
+	inline size_t maxSize() const { return mRays.maxSize(); }
+	inline bool enoughSpace() const { return mRays.enoughSpace(); }
+	inline size_t matchCount() const { return mMatchCount; }
+
+	/// Add a shadow ray with the fragment to splat if the ray is not occluded. The maximum of the ray is used as distance.
+	/// Returns the slot for the LPE matches of the fragment, which has to be filled by the caller (nullptr if no LPEs are registered).
+	/// The matches are computed while the path is still tracking the expression states, see LocalOutputQueue::matchLPE()
+	uint64* add(const Ray& shadow, const SpectralBlob& mis, const SpectralBlob& importance, const SpectralBlob& radiance);
+
+	/// Trace all shadow rays and push the fragments to the given session. The queue will be empty afterwards
+	void resolve(const Scene* scene, const RenderTileSession& session);
+	void reset();
+
+	size_t getMemoryUsage() const;
+
+private:
+	struct Entry {
+		SpectralBlob MIS;
+		SpectralBlob Importance;
+		SpectralBlob Radiance;
+		size_t MatchOffset;
+	};
+
+	RayStream mRays;
+	std::vector<Entry, Eigen::aligned_allocator<Entry>> mEntries;
+	std::vector<bool> mOccluded;
+	std::vector<uint64> mMatchData;
+	const size_t mMatchCount;
+};
+} // namespace PR
@@ -116,6 +116,15 @@ void SceneLoadContext::addMesh(const std::string& name, const std::shared_ptr<Me
 	mMeshes.emplace(name, m);
 }
 
+std::vector<std::string> SceneLoadContext::meshNames() const
+{
+	std::vector<std::string> names;
+	names.reserve(mMeshes.size());
+	for (const auto& p : mMeshes)
+		names.push_back(p.first);
+	return names;
+}
+
 uint32 SceneLoadContext::addNode(const std::string& name, const std::shared_ptr<INode>& output)
 {
 	PR_ASSERT(!hasNode(name), "Given name should be unique");
@@ -73,6 +73,7 @@ public:
 	std::shared_ptr<MeshBase> getMesh(const std::string& name) const;
 	bool hasMesh(const std::string& name) const;
 	void addMesh(const std::string& name, const std::shared_ptr<MeshBase>& m);
+	std::vector<std::string> meshNames() const;
 
 	// ---------------- Node
 	uint32 addNode(const std::string& name, const std::shared_ptr<INode>& output);
@@ -2,6 +2,7 @@
 #include "Environment.h"
 #include "Logger.h"
 #include "Platform.h"
+#include "archives/CachedSubGraphLoader.h"
 #include "archives/MtsSerializedLoader.h"
 #include "archives/PlyLoader.h"
 #include "archives/WavefrontLoader.h"
@@ -795,53 +796,43 @@ void SceneLoader::addSubGraph(const DL::DataGroup& group, SceneLoadContext& ctx)
 		loader = "obj";
 	}
 
-	if (loader == "obj") {
-		DL::Data nameD		 = group.getFromKey("name");
-		DL::Data flipNormalD = group.getFromKey("flipNormal");
-		DL::Data cacheD		 = group.getFromKey("cache");
+	DL::Data nameD		 = group.getFromKey("name");
+	DL::Data flipNormalD = group.getFromKey("flipNormal");
+	DL::Data cacheD		 = group.getFromKey("cache");
 
-		WavefrontLoader loader(nameD.type() == DL::DT_String ? nameD.getString() : "");
+	const std::string name = nameD.type() == DL::DT_String ? nameD.getString() : "";
+	const bool flipNormal  = flipNormalD.type() == DL::DT_Bool ? flipNormalD.getBool() : false;
 
-		if (flipNormalD.type() == DL::DT_Bool)
-			loader.flipNormal(flipNormalD.getBool());
+	// All options influencing the produced meshes have to be part of the cache key
+	std::stringstream key;
+	key << loader << ";" << name << ";" << flipNormal;
 
-		try {
-			loader.load(file, ctx);
-		} catch (const std::bad_alloc& ex) {
-			PR_LOG(L_ERROR) << "[Loader] Out of memory to load subgraph " << fileD.getString() << std::endl;
-		}
+	std::unique_ptr<SubGraphLoader> subLoader;
+	if (loader == "obj") {
+		auto objLoader = std::make_unique<WavefrontLoader>(name);
+		objLoader->flipNormal(flipNormal);
+		subLoader = std::move(objLoader);
 	} else if (loader == "ply") {
-		DL::Data flipNormalD = group.getFromKey("flipNormal");
-		DL::Data nameD		 = group.getFromKey("name");
-		DL::Data cacheD		 = group.getFromKey("cache");
-
-		PlyLoader loader(nameD.type() == DL::DT_String ? nameD.getString() : "");
-
-		if (flipNormalD.type() == DL::DT_Bool)
-			loader.flipNormal(flipNormalD.getBool());
-
-		try {
-			loader.load(file, ctx);
-		} catch (const std::bad_alloc& ex) {
-			PR_LOG(L_ERROR) << "[Loader] Out of memory to load subgraph " << fileD.getString() << std::endl;
-		}
+		auto plyLoader = std::make_unique<PlyLoader>(name);
+		plyLoader->flipNormal(flipNormal);
+		subLoader = std::move(plyLoader);
 	} else if (loader == "mts") {
-		DL::Data flipNormalD = group.getFromKey("flipNormal");
-		DL::Data nameD		 = group.getFromKey("name");
-		DL::Data cacheD		 = group.getFromKey("cache");
-
-		MtsSerializedLoader loader(nameD.type() == DL::DT_String ? nameD.getString() : "");
-
-		if (flipNormalD.type() == DL::DT_Bool)
-			loader.flipNormal(flipNormalD.getBool());
-
-		try {
-			loader.load(file, ctx);
-		} catch (const std::bad_alloc& ex) {
-			PR_LOG(L_ERROR) << "[Loader] Out of memory to load subgraph " << fileD.getString() << std::endl;
-		}
+		auto mtsLoader = std::make_unique<MtsSerializedLoader>(name);
+		mtsLoader->flipNormal(flipNormal);
+		subLoader = std::move(mtsLoader);
+		key << ";" << ctx.parameters().getUInt("shape", 0);
 	} else {
 		PR_LOG(L_ERROR) << "[Loader] Unknown " << loader << " loader." << std::endl;
+		return;
+	}
+
+	if (cacheD.type() == DL::DT_Bool && cacheD.getBool())
+		subLoader = std::make_unique<CachedSubGraphLoader>(std::move(subLoader), key.str());
+
+	try {
+		subLoader->load(file, ctx);
+	} catch (const std::bad_alloc& ex) {
+		PR_LOG(L_ERROR) << "[Loader] Out of memory to load subgraph " << fileD.getString() << std::endl;
 	}
 }
 
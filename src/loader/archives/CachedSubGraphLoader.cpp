@@ -0,0 +1,230 @@
+#include "CachedSubGraphLoader.h"
+#include "Environment.h"
+#include "Logger.h"
+#include "ResourceManager.h"
+#include "SceneLoadContext.h"
+#include "math/Hash.h"
+#include "mesh/MeshBase.h"
+#include "serialization/FileSerializer.h"
+#include "serialization/MappedFileSerializer.h"
+
+#include <algorithm>
+#include <iomanip>
+#include <sstream>
+
+namespace PR {
+constexpr uint32 CACHE_MAGIC   = 0x434d5250; // PRMC
+constexpr uint32 CACHE_VERSION = 1;
+
+struct SourceStamp {
+	std::string Path;
+	uint64 Size  = 0;
+	int64 MTime = 0;
+
+	inline bool operator==(const SourceStamp& other) const
+	{
+		return Path == other.Path && Size == other.Size && MTime == other.MTime;
+	}
+};
+
+static bool getSourceStamp(const std::filesystem::path& file, SourceStamp& stamp)
+{
+	std::error_code error_code;
+	stamp.Path = std::filesystem::absolute(file, error_code).generic_string();
+	if (error_code)
+		return false;
+
+	stamp.Size = std::filesystem::file_size(file, error_code);
+	if (error_code)
+		return false;
+
+	stamp.MTime = std::filesystem::last_write_time(file, error_code).time_since_epoch().count();
+	return !error_code;
+}
+
+CachedSubGraphLoader::CachedSubGraphLoader(std::unique_ptr<SubGraphLoader>&& loader, const std::string& key)
+	: mLoader(std::move(loader))
+	, mKey(key)
+{
+	PR_ASSERT(mLoader, "Expected valid loader");
+}
+
+CachedSubGraphLoader::~CachedSubGraphLoader()
+{
+}
+
+void CachedSubGraphLoader::load(const std::filesystem::path& file, SceneLoadContext& ctx)
+{
+	SourceStamp stamp;
+	auto manager = ctx.environment()->resourceManager();
+	if (!manager || !getSourceStamp(file, stamp)) {
+		mLoader->load(file, ctx);
+		return;
+	}
+
+	size_t hash = 0;
+	hash_combine(hash, stamp.Path);
+	hash_combine(hash, mKey);
+
+	std::stringstream stream;
+	stream << file.stem().generic_string() << "_" << std::hex << std::setw(16) << std::setfill('0') << hash;
+	const std::string name = stream.str();
+
+	manager->addDependency("mesh", name, file);
+
+	bool updateNeeded					  = false;
+	const std::filesystem::path cacheFile = manager->requestFile("mesh", name, ".prmc", updateNeeded);
+	if (cacheFile.empty()) { // Query mode
+		mLoader->load(file, ctx);
+		return;
+	}
+
+	if (!updateNeeded && loadCache(cacheFile, file, ctx))
+		return;
+
+	std::vector<std::string> previous = ctx.meshNames();
+	mLoader->load(file, ctx);
+	std::vector<std::string> current = ctx.meshNames();
+
+	// Only store meshes introduced by this loader
+	std::sort(previous.begin(), previous.end());
+	std::sort(current.begin(), current.end());
+	std::vector<std::string> meshes;
+	std::set_difference(current.begin(), current.end(), previous.begin(), previous.end(), std::back_inserter(meshes));
+
+	if (meshes.empty())
+		return;
+
+	MeshList list;
+	list.reserve(meshes.size());
+	for (const auto& name : meshes)
+		list.emplace_back(name, ctx.getMesh(name));
+
+	if (!writeCache(cacheFile, file, mKey, list))
+		PR_LOG(L_WARNING) << "[Loader] Could not create mesh cache " << cacheFile << std::endl;
+}
+
+bool CachedSubGraphLoader::loadCache(const std::filesystem::path& cacheFile, const std::filesystem::path& file, SceneLoadContext& ctx) const
+{
+	MeshList meshes;
+	if (!readCache(cacheFile, file, mKey, meshes))
+		return false;
+
+	for (const auto& p : meshes) {
+		std::string errMsg;
+		if (!p.second->isValid(&errMsg)) {
+			PR_LOG(L_WARNING) << "[Loader] Mesh cache " << cacheFile << " contains invalid mesh data: " << errMsg << std::endl;
+			return false;
+		}
+
+		if (ctx.hasMesh(p.first)) {
+			PR_LOG(L_ERROR) << "[Loader] Mesh " << p.first << " already exists" << std::endl;
+			return false;
+		}
+	}
+
+	for (auto& p : meshes) {
+		PR_LOG(L_INFO) << "Added mesh '" << p.first << "' with " << p.second->triangleCount() << " triangles and " << p.second->quadCount() << " quads from cache" << std::endl;
+		ctx.addMesh(p.first, std::move(p.second));
+	}
+
+	return true;
+}
+
+bool CachedSubGraphLoader::readCache(const std::filesystem::path& cacheFile, const std::filesystem::path& file,
+									 const std::string& key, MeshList& meshes)
+{
+	MappedFileSerializer serializer(cacheFile);
+	if (!serializer.isValid())
+		return false;
+
+	// Every length prefix is checked against the remaining data by the serializer, which throws if it is exceeded.
+	// Truncated strings end at the end of the data
+	try {
+		uint32 magic   = 0;
+		uint32 version = 0;
+		serializer | magic | version;
+		if (magic != CACHE_MAGIC || version != CACHE_VERSION)
+			return false;
+
+		std::string cachedKey;
+		SourceStamp cachedStamp;
+		serializer | cachedKey | cachedStamp.Path | cachedStamp.Size | cachedStamp.MTime;
+
+		// The dependency check of the resource manager only compares timestamps, also catch replaced files and changed options
+		SourceStamp stamp;
+		if (cachedKey != key || !getSourceStamp(file, stamp) || !(stamp == cachedStamp))
+			return false;
+
+		uint32 count = 0;
+		serializer | count;
+		if (count > serializer.remaining()) {
+			PR_LOG(L_WARNING) << "[Loader] Mesh cache " << cacheFile << " is corrupted. Ignoring it" << std::endl;
+			return false;
+		}
+
+		meshes.clear();
+		meshes.reserve(count);
+		for (uint32 i = 0; i < count; ++i) {
+			std::string name;
+			serializer | name;
+
+			auto mesh = std::make_shared<MeshBase>();
+			serializer | *mesh;
+			meshes.emplace_back(name, mesh);
+		}
+	} catch (const std::exception& e) {
+		PR_LOG(L_WARNING) << "[Loader] Mesh cache " << cacheFile << " is corrupted: " << e.what() << ". Ignoring it" << std::endl;
+		meshes.clear();
+		return false;
+	}
+
+	if (serializer.isTruncated() || serializer.remaining() != 0) {
+		PR_LOG(L_WARNING) << "[Loader] Mesh cache " << cacheFile << " is corrupted. Ignoring it" << std::endl;
+		meshes.clear();
+		return false;
+	}
+
+	return true;
+}
+
+bool CachedSubGraphLoader::writeCache(const std::filesystem::path& cacheFile, const std::filesystem::path& file,
+									  const std::string& key, const MeshList& meshes)
+{
+	SourceStamp stamp;
+	if (!getSourceStamp(file, stamp))
+		return false;
+
+	// Write into a temporary file first to never leave a partial cache behind
+	std::filesystem::path tmpFile = cacheFile;
+	tmpFile += ".tmp";
+
+	{
+		FileSerializer serializer(tmpFile, false);
+		if (!serializer.isValid())
+			return false;
+
+		uint32 magic   = CACHE_MAGIC;
+		uint32 version = CACHE_VERSION;
+		serializer | magic | version;
+		serializer.write(key);
+		serializer | stamp.Path | stamp.Size | stamp.MTime;
+
+		uint32 count = (uint32)meshes.size();
+		serializer | count;
+		for (const auto& p : meshes) {
+			serializer.write(p.first);
+			serializer.write(*p.second);
+		}
+	}
+
+	std::error_code error_code;
+	std::filesystem::rename(tmpFile, cacheFile, error_code);
+	if (error_code) {
+		std::filesystem::remove(tmpFile, error_code);
+		return false;
+	}
+
+	return true;
+}
+} // namespace PR
@@ -0,0 +1,36 @@
+#pragma once
+
+#include "SubGraphLoader.h"
+
+#include <memory>
+#include <vector>
+
+namespace PR {
+class MeshBase;
+
+/// Wraps another subgraph loader and stores the meshes produced by it in a binary cache inside the working directory.
+/// Further loads of the same unchanged source file map the cache instead of parsing the source again.
+/// The given key has to contain all loader options which have an influence on the produced meshes
+class PR_LIB_LOADER CachedSubGraphLoader : public SubGraphLoader {
+public:
+	CachedSubGraphLoader(std::unique_ptr<SubGraphLoader>&& loader, const std::string& key);
+	~CachedSubGraphLoader();
+
+	void load(const std::filesystem::path& file, SceneLoadContext& ctx) override;
+
+	using MeshList = std::vector<std::pair<std::string, std::shared_ptr<MeshBase>>>;
+
+	/// Write the given meshes produced from the given source file into a cache file. Returns false if the cache could not be created
+	static bool writeCache(const std::filesystem::path& cacheFile, const std::filesystem::path& file,
+						   const std::string& key, const MeshList& meshes);
+	/// Read all meshes of a cache file. Returns false if the cache is corrupted or does not match the given source file and key
+	static bool readCache(const std::filesystem::path& cacheFile, const std::filesystem::path& file,
+						  const std::string& key, MeshList& meshes);
+
+private:
+	bool loadCache(const std::filesystem::path& cacheFile, const std::filesystem::path& file, SceneLoadContext& ctx) const;
+
+	std::unique_ptr<SubGraphLoader> mLoader;
+	std::string mKey;
+};
+} // namespace PR
@@ -62,6 +62,67 @@ void FrameContainer::clear(bool force)
 		p->clear(force);
 }
 
+template <typename T>
+static inline void copyBuffer(std::shared_ptr<FrameBuffer<T>>& dst, const std::shared_ptr<FrameBuffer<T>>& src)
+{
+	if (!src)
+		return;
+
+	if (!dst || !dst->isSameSizeAs(*src))
+		dst = FrameBuffer<T>::sameAsPtr(*src);
+	dst->copyFrom(*src);
+}
+
+template <typename T>
+static inline void copyBuffers(std::vector<std::shared_ptr<FrameBuffer<T>>>& dst, const std::vector<std::shared_ptr<FrameBuffer<T>>>& src)
+{
+	dst.resize(src.size());
+	for (size_t i = 0; i < src.size(); ++i)
+		copyBuffer(dst[i], src[i]);
+}
+
+template <typename T>
+static inline void copyBuffers(std::vector<std::pair<LightPathExpression, std::shared_ptr<FrameBuffer<T>>>>& dst,
+							   const std::vector<std::pair<LightPathExpression, std::shared_ptr<FrameBuffer<T>>>>& src)
+{
+	dst.resize(src.size());
+	for (size_t i = 0; i < src.size(); ++i) {
+		dst[i].first = src[i].first;
+		copyBuffer(dst[i].second, src[i].second);
+	}
+}
+
+void FrameContainer::copyFrom(const FrameContainer& other)
+{
+	copyBuffer(mOnlineM, other.mOnlineM);
+	copyBuffer(mOnlineS, other.mOnlineS);
+
+	for (uint32 i = 0; i < AOV_SPECTRAL_COUNT; ++i) {
+		copyBuffer(mSpectral[i], other.mSpectral[i]);
+		copyBuffers(mLPE_Spectral[i], other.mLPE_Spectral[i]);
+	}
+
+	for (uint32 i = 0; i < AOV_1D_COUNT; ++i) {
+		copyBuffer(mInt1D[i], other.mInt1D[i]);
+		copyBuffers(mLPE_1D[i], other.mLPE_1D[i]);
+	}
+
+	for (uint32 i = 0; i < AOV_COUNTER_COUNT; ++i) {
+		copyBuffer(mIntCounter[i], other.mIntCounter[i]);
+		copyBuffers(mLPE_Counter[i], other.mLPE_Counter[i]);
+	}
+
+	for (uint32 i = 0; i < AOV_3D_COUNT; ++i) {
+		copyBuffer(mInt3D[i], other.mInt3D[i]);
+		copyBuffers(mLPE_3D[i], other.mLPE_3D[i]);
+	}
+
+	copyBuffers(mCustom1D, other.mCustom1D);
+	copyBuffers(mCustomCounter, other.mCustomCounter);
+	copyBuffers(mCustom3D, other.mCustom3D);
+	copyBuffers(mCustomSpectral, other.mCustomSpectral);
+}
+
 std::shared_ptr<FrameBufferFloat> FrameContainer::createSpectralBuffer() const
 {
 	PR_ASSERT(mSpectral[AOV_Output], "Spectral Output has to be available all the time");
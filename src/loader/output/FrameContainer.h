@@ -31,6 +31,8 @@ public:
 	~FrameContainer();
 
 	void clear(bool force = false);
+	/// Copy all buffers of other, which might have more channels registered than this container
+	void copyFrom(const FrameContainer& other);
 
 	// Internal
 	inline bool hasInternalChannel_1D(AOV1D var) const;
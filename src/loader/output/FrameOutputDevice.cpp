@@ -1,6 +1,7 @@
 #include "FrameOutputDevice.h"
 #include "LocalFrameOutputDevice.h"
 #include "filter/IFilter.h"
+#include "renderer/ConvergenceMap.h"
 
 namespace PR {
 FrameOutputDevice::FrameOutputDevice(const std::shared_ptr<IFilter>& filter,
@@ -8,7 +9,13 @@ FrameOutputDevice::FrameOutputDevice(const std::shared_ptr<IFilter>& filter,
 	: OutputDevice()
 	, mFilter(filter)
 	, mMonotonic(monotonic)
+	, mAsyncIterations(false)
+	, mConvergenceMap(nullptr)
 	, mData(size, specChannels)
+	, mMergeBlockCount((size.Width + MERGE_BLOCK_SIZE - 1) / MERGE_BLOCK_SIZE, (size.Height + MERGE_BLOCK_SIZE - 1) / MERGE_BLOCK_SIZE)
+	, mMergeMutexes(mMergeBlockCount.area())
+	, mChangeStamp(0)
+	, mBlockStamps(mMergeBlockCount.area(), 0)
 {
 }
 
@@ -22,6 +29,12 @@ inline static bool ignoreInLocal(AOVSpectral var)
 	return var == AOV_OnlineMean || var == AOV_OnlineVariance;
 }
 
+// Pixel sample counts are only known by the global device
+inline static bool ignoreInLocal(AOVCounter var)
+{
+	return var == AOV_PixelSampleCount;
+}
+
 std::shared_ptr<LocalOutputDevice> FrameOutputDevice::createLocal(const Size2i& size) const
 {
 	std::shared_ptr<LocalFrameOutputDevice> bucket = std::make_shared<LocalFrameOutputDevice>(
@@ -37,10 +50,12 @@ std::shared_ptr<LocalOutputDevice> FrameOutputDevice::createLocal(const Size2i&
 		bucket->data().requestInternalChannel_3D((AOV3D)i);
 	for (int i = 0; i < AOV_1D_COUNT; ++i)
 		bucket->data().requestInternalChannel_1D((AOV1D)i);
-	for (int i = 0; i < AOV_COUNTER_COUNT; ++i)
-		bucket->data().requestInternalChannel_Counter((AOVCounter)i);
+	for (int i = 0; i < AOV_COUNTER_COUNT; ++i) {
+		if (!ignoreInLocal((AOVCounter)i))
+			bucket->data().requestInternalChannel_Counter((AOVCounter)i);
+	}
 
-	// Custom (TODO: This can be done more efficiently)
+	// Custom
 	for (uint32 id = 0; id < mData.mCustom3D.size(); ++id)
 		bucket->data().requestCustomChannel_3D(id);
 	for (uint32 id = 0; id < mData.mCustom1D.size(); ++id)
@@ -50,7 +65,7 @@ std::shared_ptr<LocalOutputDevice> FrameOutputDevice::createLocal(const Size2i&
 	for (uint32 id = 0; id < mData.mCustomSpectral.size(); ++id)
 		bucket->data().requestCustomChannel_Spectral(id);
 
-	// LPE (TODO: This can be done more efficiently)
+	// LPE
 	for (int i = 0; i < AOV_3D_COUNT; ++i) {
 		uint32 id = 0;
 		for (const auto& p : mData.mLPE_3D[i])
@@ -62,6 +77,9 @@ std::shared_ptr<LocalOutputDevice> FrameOutputDevice::createLocal(const Size2i&
 			bucket->data().requestLPEChannel_1D((AOV1D)i, p.first, id++);
 	}
 	for (int i = 0; i < AOV_COUNTER_COUNT; ++i) {
+		if (ignoreInLocal((AOVCounter)i))
+			continue;
+
 		uint32 id = 0;
 		for (const auto& p : mData.mLPE_Counter[i])
 			bucket->data().requestLPEChannel_Counter((AOVCounter)i, p.first, id++);
@@ -89,8 +107,6 @@ void FrameOutputDevice::mergeLocal(
 	if (!bucket)
 		return;
 
-	std::lock_guard<std::mutex> guard(mMergeMutex);
-
 	const int32 off		 = mFilter->radius();
 	const Size2i offSize = Size2i(off, off);
 	const Point2i sp	 = p - offSize;
@@ -98,77 +114,131 @@ void FrameOutputDevice::mergeLocal(
 	const Point2i dst_off = Point2i::Zero().cwiseMax(sp);
 	const Point2i src_off = -Point2i::Zero().cwiseMin(sp);
 
-	const Size2i src_size = Size2i::fromArray(bucket->extendedSize() - src_off);
-	const Size2i dst_size = src_size;
+	const Point2i size	  = (bucket->extendedSize() - src_off).cwiseMin(mData.mSpectral[AOV_Output]->size().asArray() - dst_off);
+	const Point2i dst_end = dst_off + size;
+	if ((size <= 0).any())
+		return;
+
+	// The region of the tile itself without the filter border
+	const Point2i own_off = p.cwiseMax(Point2i::Zero());
+	const Point2i own_end = (p + bucket->originalSize().asArray()).cwiseMin(mData.mSpectral[AOV_Output]->size().asArray());
+
+	// Only lock the blocks overlapping with the region. Blocks are always locked one after another, therefore no deadlock is possible
+	const Point2i startBlock = dst_off / MERGE_BLOCK_SIZE;
+	const Point2i endBlock	 = (dst_end - Point2i::Ones()) / MERGE_BLOCK_SIZE;
+	for (Size1i by = startBlock.y(); by <= endBlock.y(); ++by) {
+		for (Size1i bx = startBlock.x(); bx <= endBlock.x(); ++bx) {
+			const Point2i block_off = Point2i(bx, by) * MERGE_BLOCK_SIZE;
+			const Point2i sub_off	= block_off.cwiseMax(dst_off);
+			const Point2i sub_end	= (block_off + Point2i::Constant(MERGE_BLOCK_SIZE)).cwiseMin(dst_end);
+
+			const Size1i index = by * mMergeBlockCount.Width + bx;
+			std::lock_guard<std::mutex> guard(mMergeMutexes[index]);
+			mergeBlock(sub_off, src_off + (sub_off - dst_off), Size2i::fromArray(sub_end - sub_off), *bucket, iteration);
+			if (mAsyncIterations) {
+				const Point2i own_block_off = block_off.cwiseMax(own_off);
+				const Point2i own_block_end = (block_off + Point2i::Constant(MERGE_BLOCK_SIZE)).cwiseMin(own_end);
+				if ((own_block_end > own_block_off).all())
+					countTileRegion(own_block_off, Size2i::fromArray(own_block_end - own_block_off));
+				normalizeRegion(sub_off, Size2i::fromArray(sub_end - sub_off));
+			}
+			markBlock(index);
+		}
+	}
+}
+
+void FrameOutputDevice::mergeBlock(const Point2i& dst_off, const Point2i& src_off, const Size2i& size,
+								   LocalFrameOutputDevice& bucket, size_t iteration)
+{
+	const Size2i src_size = size;
+	const Size2i dst_size = size;
 
 	// Do the variance estimation
 	if (mData.hasVarianceEstimator()) {
 		auto varianceEstimator = mData.varianceEstimator();
-		for (Size1i i = 0; i < mData.mSpectral[AOV_OnlineMean]->channels(); ++i)
-			varianceEstimator.addBlock(i, dst_off, dst_size, src_off, src_size, *bucket->data().mSpectral[AOV_Output], iteration);
+		if (mConvergenceMap) {
+			// Converged pixels got no samples, keep their estimate untouched
+			const FrameBufferFloat& local = *bucket.data().mSpectral[AOV_Output];
+			for (Size1i y = 0; y < size.Height; ++y) {
+				for (Size1i x = 0; x < size.Width; ++x) {
+					const Point2i p = dst_off + Point2i(x, y);
+					if (mConvergenceMap->isConverged(p))
+						continue;
+
+					for (Size1i i = 0; i < varianceEstimator.channelCount(); ++i)
+						varianceEstimator.addValue(p, i, local.getFragment(src_off + Point2i(x, y), i), iteration);
+				}
+			}
+		} else {
+			for (Size1i i = 0; i < mData.mSpectral[AOV_OnlineMean]->channels(); ++i)
+				varianceEstimator.addBlock(i, dst_off, dst_size, src_off, src_size, *bucket.data().mSpectral[AOV_Output], iteration);
+		}
 	}
 
-	// Add spectral AOVs
+	// Add spectral AOVs. These are blended at the end of the iteration, or accumulated and normalized while merging if iterations are asynchronous
 	PR_OPT_LOOP
 	for (int i = 0; i < AOV_SPECTRAL_COUNT; ++i) {
 		if (ignoreInLocal((AOVSpectral)i))
 			continue;
 
 		if (mData.mSpectral[i])
-			mCopySpectral[i]->addBlock(dst_off, dst_size, src_off, src_size, *bucket->data().mSpectral[i]);
+			mCopySpectral[i]->addBlock(dst_off, dst_size, src_off, src_size, *bucket.data().mSpectral[i]);
 
 		PR_OPT_LOOP
 		for (size_t k = 0; k < mData.mLPE_Spectral[i].size(); ++k)
-			mCopyLPE_Spectral[i][k]->addBlock(dst_off, dst_size, src_off, src_size, *bucket->data().mLPE_Spectral[i][k].second);
+			mCopyLPE_Spectral[i][k]->addBlock(dst_off, dst_size, src_off, src_size, *bucket.data().mLPE_Spectral[i][k].second);
 	}
 
 	// Add 3d AOVs
 	PR_OPT_LOOP
 	for (int i = 0; i < AOV_3D_COUNT; ++i) {
 		if (mData.mInt3D[i])
-			mData.mInt3D[i]->addBlock(dst_off, dst_size, src_off, src_size, *bucket->data().mInt3D[i]);
+			mData.mInt3D[i]->addBlock(dst_off, dst_size, src_off, src_size, *bucket.data().mInt3D[i]);
 
 		PR_OPT_LOOP
 		for (size_t k = 0; k < mData.mLPE_3D[i].size(); ++k)
-			mData.mLPE_3D[i][k].second->addBlock(dst_off, dst_size, src_off, src_size, *bucket->data().mLPE_3D[i][k].second);
+			mData.mLPE_3D[i][k].second->addBlock(dst_off, dst_size, src_off, src_size, *bucket.data().mLPE_3D[i][k].second);
 	}
 
 	// Add 1d AOVs
 	PR_OPT_LOOP
 	for (int i = 0; i < AOV_1D_COUNT; ++i) {
 		if (mData.mInt1D[i])
-			mData.mInt1D[i]->addBlock(dst_off, dst_size, src_off, src_size, *bucket->data().mInt1D[i]);
+			mData.mInt1D[i]->addBlock(dst_off, dst_size, src_off, src_size, *bucket.data().mInt1D[i]);
 
 		PR_OPT_LOOP
 		for (size_t k = 0; k < mData.mLPE_1D[i].size(); ++k)
-			mData.mLPE_1D[i][k].second->addBlock(dst_off, dst_size, src_off, src_size, *bucket->data().mLPE_1D[i][k].second);
+			mData.mLPE_1D[i][k].second->addBlock(dst_off, dst_size, src_off, src_size, *bucket.data().mLPE_1D[i][k].second);
 	}
 
 	// Add counter AOVs
 	PR_OPT_LOOP
 	for (int i = 0; i < AOV_COUNTER_COUNT; ++i) {
+		if (ignoreInLocal((AOVCounter)i))
+			continue;
+
 		if (i == AOV_Feedback) {
 			if (mData.mIntCounter[i])
-				mData.mIntCounter[i]->applyBlock(dst_off, dst_size, src_off, src_size, *bucket->data().mIntCounter[i],
+				mData.mIntCounter[i]->applyBlock(dst_off, dst_size, src_off, src_size, *bucket.data().mIntCounter[i],
 												 [](uint32 pre, uint32 val) { return pre | val; });
 
 			PR_OPT_LOOP
 			for (size_t k = 0; k < mData.mLPE_Counter[i].size(); ++k)
-				mData.mLPE_Counter[i][k].second->applyBlock(dst_off, dst_size, src_off, src_size, *bucket->data().mLPE_Counter[i][k].second,
+				mData.mLPE_Counter[i][k].second->applyBlock(dst_off, dst_size, src_off, src_size, *bucket.data().mLPE_Counter[i][k].second,
 															[](uint32 pre, uint32 val) { return pre | val; });
 		} else {
 			if (mData.mIntCounter[i])
-				mData.mIntCounter[i]->addBlock(dst_off, dst_size, src_off, src_size, *bucket->data().mIntCounter[i]);
+				mData.mIntCounter[i]->addBlock(dst_off, dst_size, src_off, src_size, *bucket.data().mIntCounter[i]);
 
 			PR_OPT_LOOP
 			for (size_t k = 0; k < mData.mLPE_Counter[i].size(); ++k)
-				mData.mLPE_Counter[i][k].second->addBlock(dst_off, dst_size, src_off, src_size, *bucket->data().mLPE_Counter[i][k].second);
+				mData.mLPE_Counter[i][k].second->addBlock(dst_off, dst_size, src_off, src_size, *bucket.data().mLPE_Counter[i][k].second);
 		}
 	}
 
 	// Add custom spectral aovs
 	PR_OPT_LOOP
-	for (auto aI = mData.mCustomSpectral.begin(), bI = bucket->data().mCustomSpectral.begin();
+	for (auto aI = mData.mCustomSpectral.begin(), bI = bucket.data().mCustomSpectral.begin();
 		 aI != mData.mCustomSpectral.end();
 		 ++aI, ++bI) {
 		(*aI)->addBlock(dst_off, dst_size, src_off, src_size, *(*bI));
@@ -176,7 +246,7 @@ void FrameOutputDevice::mergeLocal(
 
 	// Add custom 3d aovs
 	PR_OPT_LOOP
-	for (auto aI = mData.mCustom3D.begin(), bI = bucket->data().mCustom3D.begin();
+	for (auto aI = mData.mCustom3D.begin(), bI = bucket.data().mCustom3D.begin();
 		 aI != mData.mCustom3D.end();
 		 ++aI, ++bI) {
 		(*aI)->addBlock(dst_off, dst_size, src_off, src_size, *(*bI));
@@ -184,7 +254,7 @@ void FrameOutputDevice::mergeLocal(
 
 	// Add custom 1d aovs
 	PR_OPT_LOOP
-	for (auto aI = mData.mCustom1D.begin(), bI = bucket->data().mCustom1D.begin();
+	for (auto aI = mData.mCustom1D.begin(), bI = bucket.data().mCustom1D.begin();
 		 aI != mData.mCustom1D.end();
 		 ++aI, ++bI) {
 		(*aI)->addBlock(dst_off, dst_size, src_off, src_size, *(*bI));
@@ -192,15 +262,88 @@ void FrameOutputDevice::mergeLocal(
 
 	// Add custom counter aovs
 	PR_OPT_LOOP
-	for (auto aI = mData.mCustomCounter.begin(), bI = bucket->data().mCustomCounter.begin();
+	for (auto aI = mData.mCustomCounter.begin(), bI = bucket.data().mCustomCounter.begin();
 		 aI != mData.mCustomCounter.end();
 		 ++aI, ++bI) {
 		(*aI)->addBlock(dst_off, dst_size, src_off, src_size, *(*bI));
 	}
 }
 
+void FrameOutputDevice::countTileRegion(const Point2i& off, const Size2i& size)
+{
+	for (Size1i y = 0; y < size.Height; ++y) {
+		for (Size1i x = 0; x < size.Width; ++x) {
+			const Point2i p		 = off + Point2i(x, y);
+			const uint32 samples = ++mBlendCounts->getFragment(p, 0);
+
+			if (mData.mIntCounter[AOV_PixelSampleCount])
+				mData.mIntCounter[AOV_PixelSampleCount]->getFragment(p, 0) = samples;
+		}
+	}
+}
+
+void FrameOutputDevice::normalizeRegion(const Point2i& off, const Size2i& size)
+{
+	// The copy buffers keep the sums of all merged tile iterations, including the filter border of neighbouring tiles.
+	// Neighbours lag at most a few iterations behind the tile owning the pixel and no contribution is dropped,
+	// therefore the result is exact as soon as all tiles finished the same amount of iterations
+	for (Size1i y = 0; y < size.Height; ++y) {
+		for (Size1i x = 0; x < size.Width; ++x) {
+			const Point2i p	  = off + Point2i(x, y);
+			const float scale = 1.0f / std::max<uint32>(1, mBlendCounts->getFragment(p, 0));
+
+			PR_OPT_LOOP
+			for (int i = 0; i < AOV_SPECTRAL_COUNT; ++i) {
+				if (ignoreInLocal((AOVSpectral)i))
+					continue;
+
+				if (mData.mSpectral[i])
+					normalizeFragment(*mData.mSpectral[i], *mCopySpectral[i], p, scale);
+
+				PR_OPT_LOOP
+				for (size_t k = 0; k < mData.mLPE_Spectral[i].size(); ++k)
+					normalizeFragment(*mData.mLPE_Spectral[i][k].second, *mCopyLPE_Spectral[i][k], p, scale);
+			}
+		}
+	}
+}
+
+inline void FrameOutputDevice::normalizeFragment(FrameBufferFloat& dst, const FrameBufferFloat& src, const Point2i& p, float scale)
+{
+	for (Size1i i = 0; i < dst.channels(); ++i)
+		dst.getFragment(p, i) = src.getFragment(p, i) * scale;
+}
+
+void FrameOutputDevice::lockAllBlocks()
+{
+	// Merges lock a single block only, therefore locking all blocks in order can not deadlock
+	mIterationMutex.lock();
+	for (auto& mutex : mMergeMutexes)
+		mutex.lock();
+}
+
+void FrameOutputDevice::unlockAllBlocks()
+{
+	for (auto& mutex : mMergeMutexes)
+		mutex.unlock();
+	mIterationMutex.unlock();
+}
+
+void FrameOutputDevice::snapshot(FrameContainer& dst)
+{
+	lockAllBlocks();
+	dst.copyFrom(mData);
+	unlockAllBlocks();
+}
+
 void FrameOutputDevice::onEndOfIteration(size_t iteration)
 {
+	// Already normalized while merging
+	if (mAsyncIterations)
+		return;
+
+	std::lock_guard<std::mutex> guard(mIterationMutex);
+
 	const auto merger = [=](float a, float b) { return (a * (iteration - 1) + b) / iteration; };
 	PR_OPT_LOOP
 	for (int i = 0; i < AOV_SPECTRAL_COUNT; ++i) {
@@ -208,21 +351,146 @@ void FrameOutputDevice::onEndOfIteration(size_t iteration)
 			continue;
 
 		if (mData.mSpectral[i]) {
-			mData.mSpectral[i]->applyBlock(Point2i::Zero(), *mCopySpectral[i], merger);
+			blendIteration(*mData.mSpectral[i], *mCopySpectral[i], merger);
 			mCopySpectral[i]->clear(true);
 		}
 
 		PR_OPT_LOOP
 		for (size_t k = 0; k < mData.mLPE_Spectral[i].size(); ++k) {
-			mData.mLPE_Spectral[i][k].second->applyBlock(Point2i::Zero(), *mCopyLPE_Spectral[i][k], merger);
+			blendIteration(*mData.mLPE_Spectral[i][k].second, *mCopyLPE_Spectral[i][k], merger);
 			mCopyLPE_Spectral[i][k]->clear(true);
 		}
 	}
+
+	if (mConvergenceMap)
+		estimateErrors(static_cast<uint32>(iteration));
+
+	// Blending touched every block with at least one unconverged pixel
+	if (!mConvergenceMap) {
+		for (Size1i i = 0; i < (Size1i)mBlockStamps.size(); ++i) {
+			std::lock_guard<std::mutex> blockGuard(mMergeMutexes[i]);
+			markBlock(i);
+		}
+	} else {
+		for (Size1i by = 0; by < mMergeBlockCount.Height; ++by) {
+			for (Size1i bx = 0; bx < mMergeBlockCount.Width; ++bx) {
+				const Point2i block_off = Point2i(bx, by) * MERGE_BLOCK_SIZE;
+				const Point2i block_end = (block_off + Point2i::Constant(MERGE_BLOCK_SIZE)).cwiseMin(mData.mSpectral[AOV_Output]->size().asArray());
+
+				bool changed = false;
+				for (Size1i y = block_off.y(); y < block_end.y() && !changed; y += ConvergenceMap::BLOCK_SIZE)
+					for (Size1i x = block_off.x(); x < block_end.x() && !changed; x += ConvergenceMap::BLOCK_SIZE)
+						changed = !mConvergenceMap->isConverged(Point2i(x, y));
+
+				if (changed) {
+					const Size1i index = by * mMergeBlockCount.Width + bx;
+					std::lock_guard<std::mutex> blockGuard(mMergeMutexes[index]);
+					markBlock(index);
+				}
+			}
+		}
+	}
+
+	if (mData.mIntCounter[AOV_PixelSampleCount]) {
+		FrameBufferUInt32& samples = *mData.mIntCounter[AOV_PixelSampleCount];
+		if (mConvergenceMap) {
+			for (Size1i y = 0; y < samples.height(); ++y)
+				for (Size1i x = 0; x < samples.width(); ++x)
+					samples.getFragment(Point2i(x, y), 0) = mConvergenceMap->sampleCount(Point2i(x, y), static_cast<uint32>(iteration));
+		} else {
+			samples.fill(static_cast<uint32>(iteration));
+		}
+	}
+}
+
+template <typename Func>
+void FrameOutputDevice::blendIteration(FrameBufferFloat& dst, const FrameBufferFloat& src, Func merger) const
+{
+	if (!mConvergenceMap) {
+		dst.applyBlock(Point2i::Zero(), src, merger);
+		return;
+	}
+
+	// Converged pixels got no samples and keep their estimate
+	for (Size1i y = 0; y < dst.height(); ++y) {
+		for (Size1i x = 0; x < dst.width(); ++x) {
+			const Point2i p = Point2i(x, y);
+			if (mConvergenceMap->isConverged(p))
+				continue;
+
+			for (Size1i i = 0; i < dst.channels(); ++i)
+				dst.getFragment(p, i) = merger(dst.getFragment(p, i), src.getFragment(p, i));
+		}
+	}
+}
+
+void FrameOutputDevice::estimateErrors(uint32 iteration)
+{
+	if (!mData.hasVarianceEstimator())
+		return;
+
+	const FrameBufferFloat& mean	 = *mData.mSpectral[AOV_OnlineMean];
+	const FrameBufferFloat& variance = *mData.mSpectral[AOV_OnlineVariance];
+	for (Size1i y = 0; y < mean.height(); ++y) {
+		for (Size1i x = 0; x < mean.width(); ++x) {
+			const Point2i p = Point2i(x, y);
+			if (mConvergenceMap->isConverged(p))
+				continue;
+
+			float error = 0;
+			for (Size1i i = 0; i < mean.channels(); ++i)
+				error = std::max(error, ConvergenceMap::relativeError(mean.getFragment(p, i), variance.getFragment(p, i), iteration));
+			mConvergenceMap->setError(p, error);
+		}
+	}
+}
+
+bool FrameOutputDevice::isBlockDirty(const Point2i& block, uint64 stamp) const
+{
+	const Size1i index = block.y() * mMergeBlockCount.Width + block.x();
+	std::lock_guard<std::mutex> guard(mMergeMutexes[index]);
+	return mBlockStamps[index] > stamp;
+}
+
+uint64 FrameOutputDevice::dirtyBlocks(uint64 stamp, std::vector<Point2i>& blocks) const
+{
+	// Query the current stamp first. Blocks modified while iterating are reported again by the next query.
+	// Stamps are drawn and published under the block mutex. A block holding a stamp not larger than the current one
+	// is therefore either visible after locking it, or still has to draw its stamp, which will be larger
+	const uint64 current = mChangeStamp;
+	for (Size1i by = 0; by < mMergeBlockCount.Height; ++by) {
+		for (Size1i bx = 0; bx < mMergeBlockCount.Width; ++bx) {
+			const Size1i index = by * mMergeBlockCount.Width + bx;
+			std::lock_guard<std::mutex> guard(mMergeMutexes[index]);
+			if (mBlockStamps[index] > stamp)
+				blocks.emplace_back(bx, by);
+		}
+	}
+	return current;
+}
+
+void FrameOutputDevice::markAllBlocks()
+{
+	for (Size1i i = 0; i < (Size1i)mBlockStamps.size(); ++i)
+		markBlock(i);
 }
 
 void FrameOutputDevice::clear(bool force)
 {
+	// Clearing might be requested while tiles are still merged if iterations are asynchronous
+	lockAllBlocks();
 	mData.clear(force);
+	if (mAsyncIterations) {
+		for (int i = 0; i < AOV_SPECTRAL_COUNT; ++i) {
+			if (mCopySpectral[i])
+				mCopySpectral[i]->clear(true);
+			for (const auto& buffer : mCopyLPE_Spectral[i])
+				buffer->clear(true);
+		}
+		mBlendCounts->clear(true);
+	}
+	markAllBlocks();
+	unlockAllBlocks();
 }
 
 void FrameOutputDevice::enable1DChannel(AOV1D var)
@@ -240,6 +508,21 @@ void FrameOutputDevice::enable3DChannel(AOV3D var)
 	mData.requestInternalChannel_3D(var);
 }
 
+void FrameOutputDevice::enableAsyncIterations()
+{
+	mAsyncIterations = true;
+	if (!mBlendCounts)
+		mBlendCounts = mData.createCounterBuffer();
+	mBlendCounts->clear(true);
+}
+
+void FrameOutputDevice::enableAdaptiveSampling(ConvergenceMap* map)
+{
+	mConvergenceMap = map;
+	if (mConvergenceMap)
+		mConvergenceMap->requestApron(mFilter->radius());
+}
+
 void FrameOutputDevice::enableSpectralChannel(AOVSpectral var)
 {
 	mData.requestInternalChannel_Spectral(var);
@@ -3,12 +3,17 @@
 #include "FrameContainer.h"
 #include "output/OutputDevice.h"
 
+#include <atomic>
 #include <mutex>
 
 namespace PR {
+class ConvergenceMap;
 class IFilter;
+class LocalFrameOutputDevice;
 class PR_LIB_CORE FrameOutputDevice : public OutputDevice {
 public:
+	static constexpr Size1i MERGE_BLOCK_SIZE = 64; // Width and height of the regions locked while merging and tracked for changes
+
 	explicit FrameOutputDevice(const std::shared_ptr<IFilter>& filter,
 							   const Size2i& size, Size1i specChannels, bool monotonic);
 	virtual ~FrameOutputDevice();
@@ -16,6 +21,17 @@ public:
 	inline FrameContainer& data() { return mData; }
 	inline const FrameContainer& data() const { return mData; }
 
+	/// Copy all buffers into the given container without tearing, even while rendering
+	void snapshot(FrameContainer& dst);
+
+	/// Every modification of a merge block stamps it with a new, monotonically increasing change stamp
+	inline uint64 changeStamp() const { return mChangeStamp; }
+	inline const Size2i& mergeBlockCount() const { return mMergeBlockCount; }
+	/// Return true if the given merge block was modified after the given stamp
+	bool isBlockDirty(const Point2i& block, uint64 stamp) const;
+	/// Append all merge blocks modified after the given stamp and return the stamp to use for the next query
+	uint64 dirtyBlocks(uint64 stamp, std::vector<Point2i>& blocks) const;
+
 	// Mandatory interface
 
 	void clear(bool force = false) override;
@@ -27,6 +43,8 @@ public:
 	void enableCounterChannel(AOVCounter var) override;
 	void enable3DChannel(AOV3D var) override;
 	void enableSpectralChannel(AOVSpectral var) override;
+	void enableAsyncIterations() override;
+	void enableAdaptiveSampling(ConvergenceMap* map) override;
 
 	void registerLPE1DChannel(AOV1D var, const LightPathExpression& expr, uint32 id) override;
 	void registerLPECounterChannel(AOVCounter var, const LightPathExpression& expr, uint32 id) override;
@@ -41,13 +59,35 @@ public:
 	const char* type() const override { return "pr_frameoutputdevice"; };
 
 private:
+	void mergeBlock(const Point2i& dst_off, const Point2i& src_off, const Size2i& size,
+					LocalFrameOutputDevice& bucket, size_t iteration);
+	template <typename Func>
+	void blendIteration(FrameBufferFloat& dst, const FrameBufferFloat& src, Func merger) const;
+	void countTileRegion(const Point2i& off, const Size2i& size);
+	void normalizeRegion(const Point2i& off, const Size2i& size);
+	inline static void normalizeFragment(FrameBufferFloat& dst, const FrameBufferFloat& src, const Point2i& p, float scale);
+	void estimateErrors(uint32 iteration);
+	// The mutex of the block has to be held, such that a stamp is always drawn and published at once
+	inline void markBlock(Size1i index) { mBlockStamps[index] = ++mChangeStamp; }
+	void markAllBlocks(); // All block mutexes have to be held
+	void lockAllBlocks();
+	void unlockAllBlocks();
+
 	const std::shared_ptr<IFilter> mFilter;
 	const bool mMonotonic;
+	bool mAsyncIterations;
+	ConvergenceMap* mConvergenceMap; // Only set if adaptive sampling is enabled
 
 	FrameContainer mData;
-	std::mutex mMergeMutex;
+	const Size2i mMergeBlockCount;
+	mutable std::vector<std::mutex> mMergeMutexes; // One for each merge block. Also guards the change stamp of the block
+	std::mutex mIterationMutex;			   // Guards the blending at the end of an iteration against snapshots
+
+	std::atomic<uint64> mChangeStamp;
+	std::vector<uint64> mBlockStamps; // Change stamp of the last modification for each merge block
 
 	std::shared_ptr<FrameBufferFloat> mCopySpectral[AOV_SPECTRAL_COUNT];
+	std::shared_ptr<FrameBufferUInt32> mBlendCounts; // Merged iterations of the tile owning the pixel since the last clear. Only used if iterations are asynchronous
 	std::vector<std::shared_ptr<FrameBufferFloat>> mCopyLPE_Spectral[AOV_SPECTRAL_COUNT];
 };
 } // namespace PR
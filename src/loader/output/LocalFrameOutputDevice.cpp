@@ -2,7 +2,7 @@
 #include "filter/IFilter.h"
 #include "output/Feedback.h"
 #include "output/OutputData.h"
-#include "path/LightPathView.h"
+#include "path/LightPathExpression.h"
 #include "renderer/StreamPipeline.h"
 #include "spectral/CIE.h"
 
@@ -11,11 +11,12 @@ LocalFrameOutputDevice::LocalFrameOutputDevice(const std::shared_ptr<IFilter>& f
 											   const Size2i& size, Size1i specChannels, bool monotonic)
 	: LocalOutputDevice()
 	, mFilter(filter.get())
+	, mMaxExtendedSize(size.Width + 2 * mFilter.radius(), size.Height + 2 * mFilter.radius())
 	, mOriginalSize(size)
-	, mExtendedSize(mOriginalSize.Width + 2 * mFilter.radius(), mOriginalSize.Height + 2 * mFilter.radius())
+	, mExtendedSize(mMaxExtendedSize)
 	, mMonotonic(monotonic)
 	, mHasFilter(mFilter.radius() > 0)
-	, mData(mExtendedSize, specChannels)
+	, mData(mMaxExtendedSize, specChannels)
 	, mHasNonSpecLPE(false)
 	, mSpectralMapBuffer{ std::vector<float>(specChannels), std::vector<float>(specChannels), std::vector<float>(specChannels) }
 {
@@ -31,8 +32,18 @@ void LocalFrameOutputDevice::clear(bool force)
 	mData.clear(force);
 }
 
+void LocalFrameOutputDevice::resize(const Size2i& size)
+{
+	// Buffers keep their allocated size, only the region used for splatting and merging changes
+	mOriginalSize = size;
+	mExtendedSize = Size2i(size.Width + 2 * mFilter.radius(), size.Height + 2 * mFilter.radius());
+	PR_ASSERT(mExtendedSize.Width <= mMaxExtendedSize.Width && mExtendedSize.Height <= mMaxExtendedSize.Height, "Expected size to fit into the allocated buffers");
+}
+
 void LocalFrameOutputDevice::cache()
 {
+	mLPESpectralMatches.reserve(mData.mLPE_Spectral[AOV_Output].size());
+
 	mHasNonSpecLPE = false;
 	for (int i = 0; i < AOV_1D_COUNT; ++i) {
 		if (!mData.mLPE_1D[i].empty()) {
@@ -94,19 +105,23 @@ void LocalFrameOutputDevice::commitSpectrals2(StreamPipeline* pipeline, const Ou
 
 	PR_ASSERT(HasFilter || filterRadius == 0, "If no filter is choosen, radius must be zero");
 
-	const auto addContribution = [&](const Point2i& sp, const CIETriplet& triplet, const LightPathView& path) {
+	const auto& lpeChannels = mData.mLPE_Spectral[AOV_Output];
+
+	const auto addContribution = [&](const Point2i& sp, const CIETriplet& triplet, bool hasLPEMatch) {
 		// Add contribution to main channel
 		PR_UNROLL_LOOP(3)
 		for (Size1i k = 0; k < 3; ++k)
 			spectralCh->getFragment(sp, k) += triplet[k];
 
+		if (!hasLPEMatch)
+			return;
+
 		// LPE
-		for (auto pair : mData.mLPE_Spectral[AOV_Output]) {
-			if (pair.first.match(path)) {
-				PR_UNROLL_LOOP(3)
-				for (Size1i k = 0; k < 3; ++k)
-					pair.second->getFragment(sp, k) += triplet[k];
-			}
+		for (size_t c : mLPESpectralMatches) {
+			const auto& channel = lpeChannels[c].second;
+			PR_UNROLL_LOOP(3)
+			for (Size1i k = 0; k < 3; ++k)
+				channel->getFragment(sp, k) += triplet[k];
 		}
 	};
 
@@ -143,7 +158,14 @@ void LocalFrameOutputDevice::commitSpectrals2(StreamPipeline* pipeline, const Ou
 #endif
 
 		const CIETriplet triplet = mapSpectral<IsMono>(contrib, wvls);
-		const LightPathView path = LightPathView(entry.Path);
+
+		// Lookup the matched channels once for all filter taps
+		mLPESpectralMatches.clear();
+		for (size_t c = 0; c < lpeChannels.size(); ++c) {
+			if (lpeChannels[c].first.isMatched(entry.LPEMatches))
+				mLPESpectralMatches.push_back(c);
+		}
+		const bool hasLPEMatch = !mLPESpectralMatches.empty();
 
 		if constexpr (HasFilter) {
 			// Apply for each filter area
@@ -154,11 +176,11 @@ void LocalFrameOutputDevice::commitSpectrals2(StreamPipeline* pipeline, const Ou
 					const Point2i sp		 = Point2i(px, py);
 					const float filterWeight = mFilter.evalWeight(sp(0) - rp(0), sp(1) - rp(1));
 					if (filterWeight > PR_EPSILON)
-						addContribution(sp, filterWeight * grp.BlendWeight * triplet, path);
+						addContribution(sp, filterWeight * grp.BlendWeight * triplet, hasLPEMatch);
 				}
 			}
 		} else {
-			addContribution(entry.Position, grp.BlendWeight * triplet, path);
+			addContribution(entry.Position, grp.BlendWeight * triplet, hasLPEMatch);
 		}
 	}
 }
@@ -175,12 +197,11 @@ void LocalFrameOutputDevice::commitSpectrals2(StreamPipeline* pipeline, const Ou
 	}
 
 #define BLEND_1D_LPE(var, val)                                    \
-	for (auto pair : mData.mLPE_1D[var]) {                        \
+	for (const auto& pair : mData.mLPE_1D[var]) {                 \
 		PR_OPT_LOOP                                               \
 		for (size_t i = 0; i < entry_count; ++i) {                \
-			const auto& entry		 = entries[i];                \
-			const LightPathView path = LightPathView(entry.Path); \
-			if (!pair.first.match(path))                          \
+			const auto& entry = entries[i];                       \
+			if (!pair.first.isMatched(entry.LPEMatches))          \
 				continue;                                         \
 			const Point2i sp = entry.Position + filterSize;       \
 			pair.second->getFragment(sp, 0) += val;               \
@@ -203,12 +224,11 @@ void LocalFrameOutputDevice::commitSpectrals2(StreamPipeline* pipeline, const Ou
 	}
 
 #define BLEND_2D_LPE(var, val)                                    \
-	for (auto pair : mData.mLPE_3D[var]) {                        \
+	for (const auto& pair : mData.mLPE_3D[var]) {                 \
 		PR_OPT_LOOP                                               \
 		for (size_t i = 0; i < entry_count; ++i) {                \
-			const auto& entry		 = entries[i];                \
-			const LightPathView path = LightPathView(entry.Path); \
-			if (!pair.first.match(path))                          \
+			const auto& entry = entries[i];                       \
+			if (!pair.first.isMatched(entry.LPEMatches))          \
 				continue;                                         \
 			const Point2i sp = entry.Position + filterSize;       \
 			const Vector2f v = val;                               \
@@ -233,12 +253,11 @@ void LocalFrameOutputDevice::commitSpectrals2(StreamPipeline* pipeline, const Ou
 	}
 
 #define BLEND_3D_LPE(var, val)                                    \
-	for (auto pair : mData.mLPE_3D[var]) {                        \
+	for (const auto& pair : mData.mLPE_3D[var]) {                 \
 		PR_OPT_LOOP                                               \
 		for (size_t i = 0; i < entry_count; ++i) {                \
-			const auto& entry		 = entries[i];                \
-			const LightPathView path = LightPathView(entry.Path); \
-			if (!pair.first.match(path))                          \
+			const auto& entry = entries[i];                       \
+			if (!pair.first.isMatched(entry.LPEMatches))          \
 				continue;                                         \
 			const Point2i sp = entry.Position + filterSize;       \
 			const Vector3f v = val;                               \
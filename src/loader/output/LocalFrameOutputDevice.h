@@ -33,6 +33,7 @@ public:
 	virtual void commitCustom3D(uint32 aov_id, const OutputCustom3DEntry* entries, size_t entrycount) override;
 	virtual void commitCustom1D(uint32 aov_id, const OutputCustom1DEntry* entries, size_t entrycount) override;
 	virtual void commitCustomCounter(uint32 aov_id, const OutputCustomCounterEntry* entries, size_t entrycount) override;
+	virtual void resize(const Size2i& size) override;
 
 protected:
 	void cache();
@@ -45,13 +46,15 @@ private:
 	void commitCustomSpectrals2(FrameBufferFloat* aov, StreamPipeline* pipeline, const OutputCustomSpectralEntry* entries, size_t entrycount);
 
 	const FilterCache mFilter;
-	const Size2i mOriginalSize;
-	const Size2i mExtendedSize;
+	const Size2i mMaxExtendedSize; // Size of the allocated buffers
+	Size2i mOriginalSize;
+	Size2i mExtendedSize;
 	const bool mMonotonic;
 	const bool mHasFilter;
 
 	FrameContainer mData;
 	bool mHasNonSpecLPE;
+	std::vector<size_t> mLPESpectralMatches; // Spectral LPE channels matched by the current entry
 	std::array<std::vector<float>, 3> mSpectralMapBuffer;
 };
 } // namespace PR
@@ -1,6 +1,7 @@
 #include "ImageWriter.h"
 #include "Logger.h"
 #include "config/Build.h"
+#include "math/Hash.h"
 #include "output/FrameOutputDevice.h"
 #include "renderer/RenderContext.h"
 
@@ -54,6 +55,83 @@ bool ImageWriter::save(FrameOutputDevice* outputDevice,
 					   const std::vector<IM_ChannelSettingCounter>& chcounter,
 					   const std::vector<IM_ChannelSetting3D>& ch3d,
 					   const IM_SaveOptions& options) const
+{
+	return save(outputDevice->data(), toneMapper, file, chSpec, ch1d, chcounter, ch3d, options);
+}
+
+template <typename T>
+static inline void hashBuffer(uint64& seed, const std::shared_ptr<FrameBuffer<T>>& buffer)
+{
+	static_assert(sizeof(T) == sizeof(uint32), "Expected 32bit buffer entries");
+	if (!buffer)
+		return;
+
+	const size_t count = (size_t)buffer->heightPitch() * buffer->height();
+	const T* ptr	   = buffer->ptr();
+	for (size_t i = 0; i < count; ++i) {
+		uint32 word;
+		std::memcpy(&word, &ptr[i], sizeof(word));
+		seed = hash_mix(seed ^ word);
+	}
+}
+
+uint64 ImageWriter::contentHash(const FrameContainer& data,
+								const std::vector<IM_ChannelSettingSpec>& chSpec,
+								const std::vector<IM_ChannelSetting1D>& ch1d,
+								const std::vector<IM_ChannelSettingCounter>& chcounter,
+								const std::vector<IM_ChannelSetting3D>& ch3d)
+{
+	uint64 seed = 0;
+	for (const IM_ChannelSettingSpec& sett : chSpec) {
+		if (sett.CustomID >= 0)
+			hashBuffer(seed, data.getCustomChannel_Spectral(sett.CustomID));
+		else if (sett.LPE < 0)
+			hashBuffer(seed, data.getInternalChannel_Spectral(sett.Variable));
+		else
+			hashBuffer(seed, data.getLPEChannel_Spectral(sett.Variable, sett.LPE));
+	}
+
+	// Technical AOVs are weighted by the sample count
+	if (!ch3d.empty() || !ch1d.empty())
+		hashBuffer(seed, data.getInternalChannel_Counter(AOV_SampleCount));
+
+	for (const IM_ChannelSetting3D& sett : ch3d) {
+		if (sett.CustomID >= 0)
+			hashBuffer(seed, data.getCustomChannel_3D(sett.CustomID));
+		else if (sett.LPE < 0)
+			hashBuffer(seed, data.getInternalChannel_3D(sett.Variable));
+		else
+			hashBuffer(seed, data.getLPEChannel_3D(sett.Variable, sett.LPE));
+	}
+
+	for (const IM_ChannelSetting1D& sett : ch1d) {
+		if (sett.CustomID >= 0)
+			hashBuffer(seed, data.getCustomChannel_1D(sett.CustomID));
+		else if (sett.LPE < 0)
+			hashBuffer(seed, data.getInternalChannel_1D(sett.Variable));
+		else
+			hashBuffer(seed, data.getLPEChannel_1D(sett.Variable, sett.LPE));
+	}
+
+	for (const IM_ChannelSettingCounter& sett : chcounter) {
+		if (sett.CustomID >= 0)
+			hashBuffer(seed, data.getCustomChannel_Counter(sett.CustomID));
+		else if (sett.LPE < 0)
+			hashBuffer(seed, data.getInternalChannel_Counter(sett.Variable));
+		else
+			hashBuffer(seed, data.getLPEChannel_Counter(sett.Variable, sett.LPE));
+	}
+
+	return seed;
+}
+
+bool ImageWriter::save(const FrameContainer& data,
+					   ToneMapper& toneMapper, const std::filesystem::path& file,
+					   const std::vector<IM_ChannelSettingSpec>& chSpec,
+					   const std::vector<IM_ChannelSetting1D>& ch1d,
+					   const std::vector<IM_ChannelSettingCounter>& chcounter,
+					   const std::vector<IM_ChannelSetting3D>& ch3d,
+					   const IM_SaveOptions& options) const
 {
 	if (!mRenderer)
 		return false;
@@ -116,8 +194,6 @@ bool ImageWriter::save(FrameOutputDevice* outputDevice,
 	if (!out)
 		return false;
 
-	const FrameContainer& data = outputDevice->data();
-
 	// Write content
 	float* line = new float[channelCount * viewSize.Width];
 	if (!line) { // TODO: Add single token variant!
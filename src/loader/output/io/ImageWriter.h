@@ -52,6 +52,7 @@ struct IM_SaveOptions {
 	bool WriteMeta		 = false;
 };
 
+class FrameContainer;
 class FrameOutputDevice;
 class RenderContext;
 
@@ -74,6 +75,21 @@ public:
 			  const std::vector<IM_ChannelSetting3D>& ch3d,
 			  const IM_SaveOptions& options = IM_SaveOptions()) const;
 
+	bool save(const FrameContainer& data,
+			  ToneMapper& toneMapper, const std::filesystem::path& file,
+			  const std::vector<IM_ChannelSettingSpec>& spec,
+			  const std::vector<IM_ChannelSetting1D>& ch1d,
+			  const std::vector<IM_ChannelSettingCounter>& chcounter,
+			  const std::vector<IM_ChannelSetting3D>& ch3d,
+			  const IM_SaveOptions& options = IM_SaveOptions()) const;
+
+	/// Hash of the raw content of all buffers used by the given channels. Used to detect unchanged images
+	static uint64 contentHash(const FrameContainer& data,
+							  const std::vector<IM_ChannelSettingSpec>& spec,
+							  const std::vector<IM_ChannelSetting1D>& ch1d,
+							  const std::vector<IM_ChannelSettingCounter>& chcounter,
+							  const std::vector<IM_ChannelSetting3D>& ch3d);
+
 private:
 	float* mRGBData;
 	std::shared_ptr<RenderContext> mRenderer;
@@ -150,6 +150,8 @@ static struct {
 	{ "feedback", AOV_Feedback },
 	{ "f", AOV_Feedback },
 	{ "error", AOV_Feedback },
+	{ "pixel_sample_count", AOV_PixelSampleCount },
+	{ "pixel_samples", AOV_PixelSampleCount },
 	{ nullptr, AOV_COUNTER_COUNT },
 };
 
@@ -432,6 +434,13 @@ void OutputSpecification::parse(Environment*, const DL::DataGroup& entry)
 
 void OutputSpecification::save(RenderContext* renderer, FrameOutputDevice* outputDevice,
 							   ToneMapper& toneMapper, const OutputSaveOptions& options) const
+{
+	save(renderer, outputDevice->data(), toneMapper, options);
+}
+
+void OutputSpecification::save(RenderContext* renderer, const FrameContainer& data,
+							   ToneMapper& toneMapper, const OutputSaveOptions& options,
+							   std::vector<uint64>* fileHashes) const
 {
 	std::filesystem::path path = mWorkingDir;
 
@@ -448,9 +457,21 @@ void OutputSpecification::save(RenderContext* renderer, FrameOutputDevice* outpu
 	const auto outputDir = path / resultDir;
 	std::filesystem::create_directory(outputDir); // Doesn't matter if it works or not
 
-	for (const File& f : mFiles) {
+	const bool onlyChanged = options.OnlyChanged && fileHashes;
+	if (onlyChanged)
+		fileHashes->resize(mFiles.size(), 0);
+
+	for (size_t i = 0; i < mFiles.size(); ++i) {
+		const File& f = mFiles[i];
+		if (onlyChanged) {
+			const uint64 hash = ImageWriter::contentHash(data, f.SettingsSpectral, f.Settings1D, f.SettingsCounter, f.Settings3D);
+			if (hash == (*fileHashes)[i])
+				continue;
+			(*fileHashes)[i] = hash;
+		}
+
 		auto file = outputDir / (f.Name + options.NameSuffix + ".exr");
-		if (!mImageWriter.save(outputDevice, toneMapper, file.generic_wstring(),
+		if (!mImageWriter.save(data, toneMapper, file.generic_wstring(),
 							   f.SettingsSpectral, f.Settings1D, f.SettingsCounter, f.Settings3D,
 							   options.Image))
 			PR_LOG(L_ERROR) << "Couldn't save image file " << file << std::endl;
@@ -10,12 +10,14 @@ namespace PR {
 class ToneMapper;
 class Environment;
 class FileLock;
+class FrameContainer;
 class FrameOutputDevice;
 
 struct OutputSaveOptions {
 	std::string NameSuffix = "";
 	IM_SaveOptions Image   = IM_SaveOptions();
 	bool Force			   = false;
+	bool OnlyChanged	   = false; // Skip files whose content did not change since the last save with the same hash state
 };
 
 class PR_LIB_LOADER OutputSpecification {
@@ -36,6 +38,11 @@ public:
 	/// Save whole specification by using a FrameOutputDevice
 	void save(RenderContext* renderer, FrameOutputDevice* outputDevice,
 			  ToneMapper& toneMapper, const OutputSaveOptions& options) const;
+	/// Save whole specification by using a (staged) frame container
+	/// @param fileHashes Content hashes of the last save for each file. Only used and updated if options.OnlyChanged is set
+	void save(RenderContext* renderer, const FrameContainer& data,
+			  ToneMapper& toneMapper, const OutputSaveOptions& options,
+			  std::vector<uint64>* fileHashes = nullptr) const;
 
 private:
 	bool mInit;
@@ -0,0 +1,93 @@
+#include "SnapshotWriter.h"
+#include "output/FrameOutputDevice.h"
+
+namespace PR {
+SnapshotWriter::SnapshotWriter(const OutputSpecification* specification)
+	: mSpecification(specification)
+	, mWriting(-1)
+	, mPending(-1)
+	, mDroppedCount(0)
+	, mShouldStop(false)
+{
+	PR_ASSERT(mSpecification, "Invalid output specification");
+	mThread = std::thread([this]() { run(); });
+}
+
+SnapshotWriter::~SnapshotWriter()
+{
+	{
+		std::lock_guard<std::mutex> guard(mMutex);
+		mShouldStop = true;
+	}
+	mCondition.notify_all();
+	mThread.join();
+}
+
+void SnapshotWriter::save(RenderContext* renderer, FrameOutputDevice* outputDevice, const ToneMapper& toneMapper, const OutputSaveOptions& options)
+{
+	PR_ASSERT(renderer && outputDevice, "Invalid snapshot source");
+
+	// Only one caller at a time may fill a staging container
+	std::lock_guard<std::mutex> saveGuard(mSaveMutex);
+
+	// Use the staging container not being written. A pending snapshot in it is replaced
+	int target;
+	{
+		std::lock_guard<std::mutex> guard(mMutex);
+		target = mWriting == 0 ? 1 : 0;
+		if (mPending == target) {
+			mPending = -1;
+			++mDroppedCount;
+		}
+	}
+
+	// The background thread never touches the target until it is pending
+	Staging& staging = mStaging[target];
+	if (!staging.Data) {
+		const auto output = outputDevice->data().getInternalChannel_Spectral(AOV_Output);
+		staging.Data	  = std::make_unique<FrameContainer>(output->size(), output->channels());
+	}
+	outputDevice->snapshot(*staging.Data);
+	staging.Renderer = renderer;
+	staging.Options	 = options;
+	staging.Mapper.copyFrom(toneMapper);
+
+	{
+		std::lock_guard<std::mutex> guard(mMutex);
+		mPending = target;
+	}
+	mCondition.notify_all();
+}
+
+void SnapshotWriter::wait()
+{
+	std::unique_lock<std::mutex> lock(mMutex);
+	mCondition.wait(lock, [this]() { return mPending < 0 && mWriting < 0; });
+}
+
+void SnapshotWriter::run()
+{
+	for (;;) {
+		int current;
+		{
+			std::unique_lock<std::mutex> lock(mMutex);
+			mCondition.wait(lock, [this]() { return mShouldStop || mPending >= 0; });
+			if (mPending < 0) // Stopping without further work
+				return;
+
+			current	 = mPending;
+			mWriting = current;
+			mPending = -1;
+		}
+
+		Staging& staging = mStaging[current];
+		mSpecification->save(staging.Renderer, *staging.Data, staging.Mapper, staging.Options, &mFileHashes);
+
+		{
+			std::lock_guard<std::mutex> guard(mMutex);
+			mWriting = -1;
+		}
+		mCondition.notify_all();
+	}
+}
+} // namespace PR
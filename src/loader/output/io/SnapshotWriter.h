@@ -0,0 +1,59 @@
+#pragma once
+
+#include "OutputSpecification.h"
+#include "spectral/ToneMapper.h"
+
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+
+namespace PR {
+class FrameContainer;
+class FrameOutputDevice;
+class RenderContext;
+
+/// Saves snapshots of a frame output device asynchronously while rendering.
+/// The buffers are copied into one of two staging containers, which is the only work done by the caller.
+/// Tone mapping, encoding and writing is done by a background thread.
+/// At most one snapshot is written and one is pending at a time. A newer snapshot replaces a pending one.
+/// Multiple threads may call save(), but the calls are serialized
+class PR_LIB_LOADER SnapshotWriter {
+	PR_CLASS_NON_COPYABLE(SnapshotWriter);
+
+public:
+	explicit SnapshotWriter(const OutputSpecification* specification);
+	~SnapshotWriter();
+
+	void save(RenderContext* renderer, FrameOutputDevice* outputDevice, const ToneMapper& toneMapper, const OutputSaveOptions& options);
+
+	/// Wait until all snapshots are written
+	void wait();
+
+	/// Amount of snapshots replaced by a newer one before they were written
+	inline size_t droppedCount() const { return mDroppedCount; }
+
+private:
+	void run();
+
+	struct Staging {
+		std::unique_ptr<FrameContainer> Data;
+		RenderContext* Renderer = nullptr;
+		OutputSaveOptions Options;
+		ToneMapper Mapper;
+	};
+
+	const OutputSpecification* mSpecification;
+	std::vector<uint64> mFileHashes; // Only accessed by the background thread
+
+	Staging mStaging[2];
+	int mWriting; // Index of the staging container being written or -1
+	int mPending; // Index of the staging container waiting to be written or -1
+	size_t mDroppedCount;
+	bool mShouldStop;
+
+	std::mutex mMutex;
+	std::mutex mSaveMutex; // Serializes callers of save(), as the staging container is filled without holding mMutex
+	std::condition_variable mCondition;
+	std::thread mThread;
+};
+} // namespace PR
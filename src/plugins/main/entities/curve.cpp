@@ -1,327 +1,546 @@
-#include "curve/Curve.h"
 #include "Environment.h"
 #include "Logger.h"
 #include "Profiler.h"
 #include "SceneLoadContext.h"
-#include "emission/IEmission.h"
+#include "entity/GeometryDev.h"
+#include "entity/GeometryRepr.h"
 #include "entity/IEntity.h"
 #include "entity/IEntityPlugin.h"
-#include "geometry/CollisionData.h"
-#include "material/IMaterial.h"
-#include "math/Projection.h"
-#include "math/Transform.h"
+#include "geometry/GeometryPoint.h"
+#include "math/Distribution1D.h"
+#include "math/SplitSample.h"
+#include "math/Tangent.h"
+#include "serialization/FileSerializer.h"
 
 #include <filesystem>
 
-// TODO: Change to new geometry representation
-
 namespace PR {
-template <typename T>
-class CurveEntity : public IEntity {
-public:
-	ENTITY_CLASS
+/*
+	Binary curve file (little endian):
+	char[4]		Magic "PRCV"
+	uint32		Version (1)
+	uint32		Strand count
+	uint32		Vertex count
+	uint32		Vertex count of each strand [Strand count]
+	float[4]	Control points as x, y, z, radius [Vertex count]
+
+	A strand is a sequence of segments sharing their control points.
+	For the bezier basis each strand has to contain 3k+1 control points,
+	the bspline basis requires at least four and the linear basis at least two control points per strand.
+*/
+constexpr char CURVE_FILE_MAGIC[4]		= { 'P', 'R', 'C', 'V' };
+constexpr uint32 CURVE_FILE_VERSION		= 1;
+constexpr uint64 CURVE_FILE_HEADER_SIZE = sizeof(CURVE_FILE_MAGIC) + 3 * sizeof(uint32);
+
+enum class CurveBasis {
+	Linear,
+	Bezier,
+	BSpline
+};
 
-	CurveEntity(uint32 id, const std::string& name, const Transformf& transform,
-				const T& curve,
-				Vector2f width,
-				uint32 materialID, uint32 lightID)
-		: IEntity(id, lightID, name, transform)
-		, mMaterialID(materialID)
-		, mCurve(curve)
-		, mWidth(width)
-		, mApproxSurfaceArea(0.0f)
-	{
+static inline const char* requiredControlPoints(CurveBasis basis)
+{
+	switch (basis) {
+	case CurveBasis::Linear:
+		return "at least two";
+	case CurveBasis::BSpline:
+		return "at least four";
+	default:
+	case CurveBasis::Bezier:
+		return "3k+1";
 	}
-
-	virtual ~CurveEntity() {}
-
-	std::string type() const override
-	{
-		return "curve";
+}
+
+// Weights of the four (two for linear) control points of a segment and their derivatives
+static inline void curveBasisWeights(CurveBasis basis, float t, float* w, float* dw)
+{
+	const float s = 1 - t;
+	switch (basis) {
+	case CurveBasis::Linear:
+		w[0]  = s;
+		w[1]  = t;
+		w[2]  = 0;
+		w[3]  = 0;
+		dw[0] = -1;
+		dw[1] = 1;
+		dw[2] = 0;
+		dw[3] = 0;
+		break;
+	case CurveBasis::Bezier:
+		w[0]  = s * s * s;
+		w[1]  = 3 * s * s * t;
+		w[2]  = 3 * s * t * t;
+		w[3]  = t * t * t;
+		dw[0] = -3 * s * s;
+		dw[1] = 3 * s * s - 6 * s * t;
+		dw[2] = 6 * s * t - 3 * t * t;
+		dw[3] = 3 * t * t;
+		break;
+	case CurveBasis::BSpline:
+		w[0]  = s * s * s / 6;
+		w[1]  = (3 * t * t * t - 6 * t * t + 4) / 6;
+		w[2]  = (-3 * t * t * t + 3 * t * t + 3 * t + 1) / 6;
+		w[3]  = t * t * t / 6;
+		dw[0] = -s * s / 2;
+		dw[1] = (3 * t * t - 4 * t) / 2;
+		dw[2] = (-3 * t * t + 2 * t + 1) / 2;
+		dw[3] = t * t / 2;
+		break;
 	}
+}
 
-	float localSurfaceArea(uint32 /*id*/) const override
+// All curves of a single file, stored in one embree geometry
+class Curves {
+public:
+	Curves(CurveBasis basis, bool flat)
+		: mScene()
+		, mGeometry()
+		, mBasis(basis)
+		, mFlat(flat)
+		, mSurfaceArea(0.0f)
+		, mWasGenerated(false)
 	{
-		return mApproxSurfaceArea;
 	}
 
-	bool isCollidable() const override
+	~Curves()
 	{
-		return mMaterialID != PR_INVALID_ID && mCurve.isValid();
+		if (mWasGenerated) {
+			rtcReleaseGeometry(mGeometry);
+			rtcReleaseScene(mScene);
+		}
 	}
 
-	float collisionCost() const override
+	bool load(const std::filesystem::path& path, float radiusScale)
 	{
-		return 10;
-	}
+		PR_PROFILE_THIS;
 
-	BoundingBox localBoundingBox() const override
-	{
-		BoundingBox box;
-		for (size_t i = 0; i <= mCurve.degree(); ++i)
-			box.combine(mCurve.point(i));
+		FileSerializer serializer(path, true);
+		if (!serializer.isValid()) {
+			PR_LOG(L_ERROR) << "Could not open curve file " << path << std::endl;
+			return false;
+		}
 
-		box.expand(std::max(mWidth(0), mWidth(1)) * 0.5f);
-		return box;
-	}
+		// The stream does not report short reads, therefore check the file size up front
+		std::error_code ec;
+		const uint64 fileSize = std::filesystem::file_size(path, ec);
+		if (ec || fileSize < CURVE_FILE_HEADER_SIZE) {
+			PR_LOG(L_ERROR) << "Given file " << path << " is not a valid curve file" << std::endl;
+			return false;
+		}
 
-	void checkCollision(const RayPackage& in, CollisionOutput& out) const override
-	{
-		PR_PROFILE_THIS;
+		// Read header
+		char magic[4];
+		serializer.readRaw(reinterpret_cast<uint8*>(magic), sizeof(magic));
 
-		auto in_local = in.transformAffine(invTransform().matrix(), invTransform().linear());
+		uint32 version	   = 0;
+		uint32 strandCount = 0;
+		uint32 vertexCount = 0;
+		serializer.read(version);
+		serializer.read(strandCount);
+		serializer.read(vertexCount);
 
-		// TODO
+		if (!serializer.isValid() || !std::equal(magic, magic + 4, CURVE_FILE_MAGIC) || version != CURVE_FILE_VERSION) {
+			PR_LOG(L_ERROR) << "Given file " << path << " is not a valid curve file" << std::endl;
+			return false;
+		}
 
-		out.HitDistance = in_local.transformDistance(out.HitDistance,
-													 transform().linear());
-		out.FaceID		= simdpp::make_uint(0);
-		out.EntityID	= simdpp::make_uint(id());
-		out.MaterialID	= simdpp::make_uint(mMaterialID);
-	}
+		// Counts are widened before multiplying, as they are given by the file
+		const uint64 contentSize = sizeof(uint32) * static_cast<uint64>(strandCount) + 4 * sizeof(float) * static_cast<uint64>(vertexCount);
+		if (fileSize - CURVE_FILE_HEADER_SIZE < contentSize) {
+			PR_LOG(L_ERROR) << "Curve file " << path << " is truncated" << std::endl;
+			return false;
+		}
 
-	void checkCollision(const Ray& in, HitPoint& out) const override
-	{
-		PR_PROFILE_THIS;
+		// Read content
+		std::vector<uint32> strandSizes(strandCount);
+		serializer.readRaw(reinterpret_cast<uint8*>(strandSizes.data()), sizeof(uint32) * strandSizes.size());
 
-		auto in_local = in.transformAffine(invTransform().matrix(), invTransform().linear());
+		mVertices.resize(static_cast<size_t>(vertexCount) * 4);
+		serializer.readRaw(reinterpret_cast<uint8*>(mVertices.data()), sizeof(float) * mVertices.size());
 
-		Vector3f dx, dy;
-		Tangent::frame(in_local.Direction, dx, dy);
+		if (radiusScale != 1.0f) {
+			for (size_t i = 0; i < vertexCount; ++i)
+				mVertices[4 * i + 3] *= radiusScale;
+		}
 
-		// Project to 2d plane
-		Eigen::Matrix3f proj = PR::Transform::orthogonalInverse(PR::Transform::orthogonalMatrix(dy, dx, in_local.Direction));
+		// Setup segments for each strand
+		size_t start		  = 0;
+		size_t invalidStrands = 0;
+		mSegments.reserve(vertexCount);
+		for (uint32 size : strandSizes) {
+			if (start + size > vertexCount) {
+				PR_LOG(L_ERROR) << "Curve file " << path << " references more vertices than available" << std::endl;
+				return false;
+			}
+
+			switch (mBasis) {
+			case CurveBasis::Linear:
+				if (size < 2) {
+					++invalidStrands;
+					break;
+				}
+				for (uint32 i = 0; i + 1 < size; ++i)
+					mSegments.push_back(static_cast<uint32>(start + i));
+				break;
+			case CurveBasis::Bezier:
+				if (size < 4 || (size - 1) % 3 != 0) {
+					++invalidStrands;
+					break;
+				}
+				for (uint32 i = 0; i + 3 < size; i += 3)
+					mSegments.push_back(static_cast<uint32>(start + i));
+				break;
+			case CurveBasis::BSpline:
+				if (size < 4) {
+					++invalidStrands;
+					break;
+				}
+				for (uint32 i = 0; i + 3 < size; ++i)
+					mSegments.push_back(static_cast<uint32>(start + i));
+				break;
+			}
+
+			start += size;
+		}
+		mSegments.shrink_to_fit();
 
-		T projectedCurve = mCurve;
-		for (size_t i = 0; i <= projectedCurve.degree(); ++i)
-			projectedCurve.points()[i] = proj * (mCurve.point(i) - in_local.Origin);
+		if (invalidStrands > 0)
+			PR_LOG(L_WARNING) << "Ignoring " << invalidStrands << " strands of curve file " << path << " not having " << requiredControlPoints(mBasis) << " control points" << std::endl;
 
-		// Calculate max depth
-		float l0 = 0;
-		for (size_t i = 0; i < projectedCurve.degree() - 1; ++i) {
-			l0 = std::max(l0,
-						  std::max(std::max(std::abs(projectedCurve.point(i)(0) - 2 * projectedCurve.point(i + 1)(0) + projectedCurve.point(i + 2)(0)),
-											std::abs(projectedCurve.point(i)(1) - 2 * projectedCurve.point(i + 1)(1) + projectedCurve.point(i + 2)(1))),
-								   std::abs(projectedCurve.point(i)(2) - 2 * projectedCurve.point(i + 1)(2) + projectedCurve.point(i + 2)(2))));
+		setupCache();
+		return !mSegments.empty();
+	}
+
+	inline RTCScene generate(const RTCDevice& dev)
+	{
+		if (!mWasGenerated) {
+			setupOriginal(dev);
+			mWasGenerated = true;
 		}
 
-		float eps		= std::max(mWidth(0), mWidth(1)) / 20.f;
-		float fr0		= static_cast<float>(std::log(1.41421356237f * 12.0f * l0 / (8.0f * eps)) / std::log(4));
-		size_t maxDepth = static_cast<size_t>(std::max(0, std::min(10, (int)std::round(fr0))));
-
-		out.Successful = recursiveCheck(in_local, out, projectedCurve, 0, 1, maxDepth);
-		if (out.Successful) {
-			out.HitDistance = in_local.transformDistance(out.HitDistance,
-														 transform().linear());
-			out.FaceID		= 0;
-			out.EntityID	= id();
-			out.MaterialID	= mMaterialID;
+		return mScene;
+	}
+
+	inline size_t segmentCount() const { return mSegments.size(); }
+	inline bool isFlat() const { return mFlat; }
+	inline float surfaceArea() const { return mSurfaceArea; }
+	inline const BoundingBox& boundingBox() const { return mBoundingBox; }
+
+	/// Position and radius of the given segment at t
+	inline Vector4f evaluate(uint32 segment, float t, Vector4f& derivative) const
+	{
+		float w[4];
+		float dw[4];
+		curveBasisWeights(mBasis, t, w, dw);
+
+		const uint32 points = mBasis == CurveBasis::Linear ? 2 : 4;
+		Vector4f p			= Vector4f::Zero();
+		derivative			= Vector4f::Zero();
+		for (uint32 i = 0; i < points; ++i) {
+			const Vector4f cp = Eigen::Map<const Vector4f>(&mVertices[4 * (mSegments[segment] + i)]);
+			p += w[i] * cp;
+			derivative += dw[i] * cp;
 		}
+		return p;
 	}
 
-	Vector3f pickRandomParameterPoint(const Vector3f&, const Vector2f& rnd,
-									  uint32& /*faceID*/, float& pdf) const override
+	inline float segmentArea(uint32 segment) const
 	{
-		PR_PROFILE_THIS;
-		pdf = 1 / localSurfaceArea(0);
-		return Vector3f(rnd(0), rnd(1), 0);
+		// Approximate the length by a few linear pieces
+		constexpr uint32 STEPS = 4;
+
+		Vector4f d;
+		Vector4f prev = evaluate(segment, 0, d);
+		float area	  = 0;
+		for (uint32 i = 1; i <= STEPS; ++i) {
+			const Vector4f cur = evaluate(segment, i / float(STEPS), d);
+			const float radius = 0.5f * (prev(3) + cur(3));
+			area += (cur.head<3>() - prev.head<3>()).norm() * (mFlat ? 2 * radius : 2 * PR_PI * radius);
+			prev = cur;
+		}
+		return area;
 	}
 
-	void provideGeometryPoint(const Vector3f& view, uint32 /*faceID*/, const Vector3f& parameter,
-							  GeometryPoint& pt) const override
+	inline const Distribution1D* segmentSamplingDistribution() const { return mSegmentSamplingDistribution.get(); }
+	inline void buildSegmentSamplingDistribution()
 	{
-		PR_PROFILE_THIS;
+		mSegmentSamplingDistribution = std::make_unique<Distribution1D>(segmentCount());
+		mSegmentSamplingDistribution->generate([&](size_t s) { return segmentArea(static_cast<uint32>(s)); });
+	}
 
-		float u = parameter[0];
-		float v = parameter[1];
+private:
+	inline void setupCache()
+	{
+		mBoundingBox = BoundingBox();
+		for (size_t i = 0; i < mVertices.size() / 4; ++i) {
+			const Vector3f p   = Eigen::Map<const Vector3f>(&mVertices[4 * i]);
+			const float radius = mVertices[4 * i + 3];
+			mBoundingBox.combine(p - Vector3f::Constant(radius));
+			mBoundingBox.combine(p + Vector3f::Constant(radius));
+		}
 
-		float width = lerpWidth(u);
-		Vector3f ny = mCurve.evalDerivative(u).cross(invTransform().linear() * view).normalized();
-		pt.P		= mCurve.eval(u) + ny * (0.5f - v) * width;
+		mSurfaceArea = 0;
+		for (size_t i = 0; i < mSegments.size(); ++i)
+			mSurfaceArea += segmentArea(static_cast<uint32>(i));
+	}
 
-		// Global
-		pt.P = transform() * pt.P;
-		pt.N = -view;
-		Tangent::frame(pt.N, pt.Nx, pt.Ny);
+	inline RTCGeometryType geometryType() const
+	{
+		switch (mBasis) {
+		case CurveBasis::Linear:
+			return mFlat ? RTC_GEOMETRY_TYPE_FLAT_LINEAR_CURVE : RTC_GEOMETRY_TYPE_ROUND_LINEAR_CURVE;
+		case CurveBasis::BSpline:
+			return mFlat ? RTC_GEOMETRY_TYPE_FLAT_BSPLINE_CURVE : RTC_GEOMETRY_TYPE_ROUND_BSPLINE_CURVE;
+		default:
+		case CurveBasis::Bezier:
+			return mFlat ? RTC_GEOMETRY_TYPE_FLAT_BEZIER_CURVE : RTC_GEOMETRY_TYPE_ROUND_BEZIER_CURVE;
+		}
+	}
 
-		pt.N.normalize();
-		pt.Nx.normalize();
-		pt.Ny.normalize();
+	inline void setupOriginal(const RTCDevice& dev)
+	{
+		mGeometry = rtcNewGeometry(dev, geometryType());
 
-		pt.UVW = Vector3f(u, v, 0.0f);
+		// Share the buffers with embree, all segments of all strands end up in a single geometry
+		rtcSetSharedGeometryBuffer(mGeometry, RTC_BUFFER_TYPE_VERTEX, 0, RTC_FORMAT_FLOAT4, mVertices.data(), 0, sizeof(float) * 4, mVertices.size() / 4);
+		rtcSetSharedGeometryBuffer(mGeometry, RTC_BUFFER_TYPE_INDEX, 0, RTC_FORMAT_UINT, mSegments.data(), 0, sizeof(uint32), mSegments.size());
+		rtcCommitGeometry(mGeometry);
 
-		pt.EntityID	   = id();
-		pt.PrimitiveID = query.PrimitiveID;
-		pt.MaterialID  = mMaterialID;
-		pt.EmissionID  = emissionID();
-		pt.DisplaceID  = 0;
+		mScene = rtcNewScene(dev);
+
+		rtcAttachGeometry(mScene, mGeometry);
+
+		rtcSetSceneFlags(mScene, RTC_SCENE_FLAG_COMPACT | RTC_SCENE_FLAG_ROBUST);
+		rtcSetSceneBuildQuality(mScene, RTC_BUILD_QUALITY_HIGH);
+		rtcCommitScene(mScene);
 	}
 
-	void beforeSceneBuild() override
+	RTCScene mScene;
+	RTCGeometry mGeometry;
+
+	const CurveBasis mBasis;
+	const bool mFlat;
+
+	std::vector<float> mVertices;  // x, y, z, radius
+	std::vector<uint32> mSegments; // First control point of each segment
+
+	BoundingBox mBoundingBox;
+	float mSurfaceArea;
+	std::unique_ptr<Distribution1D> mSegmentSamplingDistribution;
+	bool mWasGenerated;
+};
+
+class CurveEntity : public IEntity {
+public:
+	ENTITY_CLASS
+
+	CurveEntity(const std::string& name, const Transformf& transform,
+				const std::shared_ptr<Curves>& curves,
+				uint32 matID, uint32 lightID)
+		: IEntity(lightID, name, transform)
+		, mCurves(curves)
+		, mMaterialID(matID)
 	{
-		PR_PROFILE_THIS;
+	}
 
-		IEntity::beforeSceneBuild();
+	virtual ~CurveEntity() {}
 
-		mApproxSurfaceArea = 0.0f;
-		constexpr size_t N = 50;
-		for (size_t i = 0; i < N; ++i) {
-			float a = i / (float)N;
-			float b = (i + 1) / (float)N;
+	std::string type() const override
+	{
+		return "curve";
+	}
 
-			Vector3f pA = mCurve.eval(a);
-			Vector3f pB = mCurve.eval(b);
+	virtual float localSurfaceArea(uint32 id) const override
+	{
+		if (id == PR_INVALID_ID || id == mMaterialID)
+			return mCurves->surfaceArea();
+		else
+			return 0;
+	}
 
-			float wA = lerpWidth(a);
-			float wB = lerpWidth(b);
+	bool isCollidable() const override
+	{
+		return mCurves->segmentCount() > 0;
+	}
 
-			float dist	= (pB - pA).norm();
-			float qArea = std::min(wA, wB) * dist;
-			float tArea = 0.5f * std::abs(wA - wB) * dist;
-			mApproxSurfaceArea += qArea + tArea;
-		}
+	float collisionCost() const override
+	{
+		return (float)mCurves->segmentCount();
 	}
 
-private:
-	inline float lerpWidth(float t) const
+	BoundingBox localBoundingBox() const override
 	{
-		return mWidth(0) * (1 - t) + mWidth(1) * t;
+		return mCurves->boundingBox();
 	}
 
-	bool recursiveCheck(const Ray& in, HitPoint& out,
-						const T& curve,
-						float uMin, float uMax, size_t depth) const
+	GeometryRepr constructGeometryRepresentation(const GeometryDev& dev) const override
 	{
-		PR_PROFILE_THIS;
+		RTCScene original = mCurves->generate(dev);
 
-		// Culling
-		BoundingBox box;
-		for (size_t i = 0; i < curve.degree() + 1; ++i)
-			box.combine(curve.point(i));
+		RTCGeometry geom = rtcNewGeometry(dev, RTC_GEOMETRY_TYPE_INSTANCE);
+		rtcSetGeometryInstancedScene(geom, original);
 
-		float width = std::max(lerpWidth(uMin), lerpWidth(uMax));
-		box.expand(width / 2);
+		const Transformf& M = transform();
+		rtcSetGeometryTransform(geom, 0, RTC_FORMAT_FLOAT4X4_COLUMN_MAJOR, M.data());
+		rtcCommitGeometry(geom);
 
-		box.intersects(Ray(Vector3f(0, 0, -1), Vector3f(0, 0, 1)), out);
-		if (out.HitDistance == PR_INF)
-			return false;
+		return GeometryRepr(geom);
+	}
+
+	EntitySamplePoint sampleParameterPoint(const Vector2f& rnd) const override
+	{
+		PR_PROFILE_THIS;
+
+		const Distribution1D* segmentDistribution = mCurves->segmentSamplingDistribution();
 
-		if (depth > 0) {
-			float mid = (uMin + uMax) / 2;
-			T firstHalf, secondHalf;
-			curve.subdivide(firstHalf, secondHalf);
-			return recursiveCheck(in, out, firstHalf, uMin, mid, depth - 1)
-				   || recursiveCheck(in, out, secondHalf, mid, uMax, depth - 1);
+		// Select segment proportional to its area if possible
+		uint32 segment;
+		float pdf_s;
+		Vector2f rnd2;
+		if (segmentDistribution) {
+			segment = (uint32)segmentDistribution->sampleDiscrete(rnd(0), pdf_s, &rnd2(0));
+			rnd2(1) = rnd(1);
 		} else {
-			// Curve segments
-			Vector3f s0 = curve.startPoint();
-			//Vector3f s1 = curve.point(1);
-			Vector3f e0 = curve.endPoint();
-			//Vector3f e1 = curve.point(curve.degree() - 1);
-
-			/*float edge0 = s0(0) * (s0(0) - s1(0)) - (s0(1) - s1(1)) * s0(1);
-			float edge1 = e0(0) * (e0(0) - e1(0)) - (e0(1) - e1(1)) * e0(1);
-			if (edge0 < 0 || edge1 < 0)
-				return false;*/
-
-			// Minimum distance
-			Vector3f dir = e0 - s0;
-			float denom	 = dir.block<2, 1>(0, 0).squaredNorm();
-			if (std::abs(denom) < PR_EPSILON)
-				return false;
+			const SplitSample2D split(rnd, 0, mCurves->segmentCount());
+			segment = split.integral1();
+			pdf_s	= 1.0f / mCurves->segmentCount();
+			rnd2	= Vector2f(split.uniform1(), split.uniform2());
+		}
 
-			float w = -dir.block<2, 1>(0, 0).dot(s0.block<2, 1>(0, 0)) / denom;
+		Vector4f dp;
+		const Vector4f p = mCurves->evaluate(segment, rnd2(0), dp);
 
-			// U coordinate
-			float u		   = std::max(uMin, std::min(uMax, uMin * (1 - w) + uMax * w));
-			float hitwidth = lerpWidth(u);
+		// t and phi are sampled uniformly, therefore the area pdf is given by the local area jacobian |dp/dt| * circumference
+		const float jacobian = dp.head<3>().norm() * (mCurves->isFlat() ? 2 * p(3) : 2 * PR_PI * p(3));
+		const float pdf_a	 = jacobian > PR_EPSILON ? pdf_s / (jacobian * volumeScalefactor()) : 0.0f;
 
-			// Intersection point
-			Vector3f p	= curve.eval(std::min(1.0f, std::max(0.0f, w)));
-			float dist2 = p.block<2, 1>(0, 0).squaredNorm();
-			if (dist2 > hitwidth * hitwidth * 0.25f)
-				return false;
+		Vector3f pos = p.head<3>();
+		if (!mCurves->isFlat()) {
+			Vector3f nx, ny;
+			Tangent::frame(dp.head<3>().normalized(), nx, ny);
 
-			if (p(2) < 0)
-				return false;
+			const float phi = 2 * PR_PI * rnd2(1);
+			pos += p(3) * (std::cos(phi) * nx + std::sin(phi) * ny);
+		}
 
-			// V coordinate
-			Vector3f dp = curve.evalDerivative(std::min(1.0f, std::max(0.0f, w)));
-			float dist	= std::sqrt(dist2);
-			float edge	= p(0) * dp(1) - dp(0) * p(1);
-			float v		= (edge > 0)
-						  ? 0.5f + dist / hitwidth
-						  : 0.5f - dist / hitwidth;
+		return EntitySamplePoint(transform() * pos, rnd2, segment, pdf_a);
+	}
 
-			out.Parameter[0] = u;
-			out.Parameter[1] = v;
-			out.HitDistance	 = p(2);
+	void provideGeometryPoint(const EntityGeometryQueryPoint& query,
+							  GeometryPoint& pt) const override
+	{
+		PR_PROFILE_THIS;
 
-			return true;
+		Vector4f dp;
+		const Vector4f p = mCurves->evaluate(query.PrimitiveID, query.UV(0), dp);
+		const Vector3f T = dp.head<3>().normalized();
+
+		// Flat curves always face the incoming ray, round curves are tubes around the center line
+		Vector3f N;
+		if (mCurves->isFlat())
+			N = -(invTransform().linear() * query.View);
+		else
+			N = invTransform() * query.Position - p.head<3>();
+		N -= N.dot(T) * T;
+
+		if (N.squaredNorm() > PR_EPSILON) {
+			pt.N = N;
+		} else { // Hit exactly on the center line
+			Vector3f unused;
+			Tangent::unnormalized_frame(T, pt.N, unused);
 		}
-	}
+		pt.Nx = T;
+		pt.Ny = pt.N.cross(pt.Nx);
+
+		// Global
+		pt.N  = normalMatrix() * pt.N;
+		pt.Nx = normalMatrix() * pt.Nx;
+		pt.Ny = normalMatrix() * pt.Ny;
+
+		pt.N.normalize();
+		pt.Nx.normalize();
+		pt.Ny.normalize();
 
-	uint32 mMaterialID;
-	T mCurve;
-	Vector2f mWidth;
+		pt.UV		   = query.UV;
+		pt.PrimitiveID = query.PrimitiveID;
+		pt.MaterialID  = mMaterialID;
+		pt.EmissionID  = emissionID();
+		pt.DisplaceID  = PR_INVALID_ID;
+	}
 
-	float mApproxSurfaceArea;
+private:
+	const std::shared_ptr<Curves> mCurves;
+	const uint32 mMaterialID;
 };
 
 class CurveEntityPlugin : public IEntityPlugin {
 public:
-	std::shared_ptr<IEntity> create(uint32 id, const std::string&, const SceneLoadContext& ctx) override
+	std::unordered_map<std::string, std::shared_ptr<Curves>> mLoadedCurves;
+
+	std::shared_ptr<IEntity> create(const std::string&, const SceneLoadContext& ctx) override
 	{
 		const ParameterGroup& params = ctx.parameters();
-		std::string name			 = params.getString("name", "__unnamed__");
-		uint32 degree				 = (uint32)std::max(1, (int)params.getInt("degree", 3));
 
-		std::vector<float> points = params.getNumberArray("points");
-		if (points.size() != (degree + 1) * 3) {
-			PR_LOG(L_ERROR) << "Curve " << name << " is invalid. Expected " << (degree + 1) * 3 << " entries in points" << std::endl;
-			return nullptr;
-		}
+		const std::string name	   = params.getString("name", "__unnamed__");
+		const std::string path	   = ctx.escapePath(params.getString("file", "")).generic_string();
+		const std::string basisStr = params.getString("basis", "bezier");
+		const bool flat			   = params.getBool("flat", false);
+		const float radiusScale	   = params.getNumber("radius_scale", 1.0f);
 
-		Vector2f width = params.getVector2f("width", Vector2f(1, 1));
-		
 		const uint32 matID = ctx.lookupMaterialID(params.getParameter("material"));
 		const uint32 emsID = ctx.lookupEmissionID(params.getParameter("emission"));
 
-#define _CURVE(D)                                                                                                        \
-	case D: {                                                                                                            \
-		FixedCurve3<D + 1> curve;                                                                                        \
-		for (size_t i = 0; i <= curve.degree(); ++i)                                                                     \
-			curve.points()[i] = Vector3f(points[3 * i], points[3 * i + 1], points[3 * i + 2]);                           \
-		return std::make_shared<CurveEntity<FixedCurve3<D + 1>>>(id, name, ctx.transform(), curve, width, matID, emsID); \
-	}
+		CurveBasis basis;
+		if (basisStr == "linear")
+			basis = CurveBasis::Linear;
+		else if (basisStr == "bspline")
+			basis = CurveBasis::BSpline;
+		else
+			basis = CurveBasis::Bezier;
 
-		switch (degree) {
-			_CURVE(2)
-			_CURVE(3)
-			_CURVE(4)
-			_CURVE(5)
-			_CURVE(6)
-			_CURVE(7)
-			_CURVE(8)
-			_CURVE(9)
-		default: {
-			Curve3::PointList list(degree + 1);
-			for (size_t i = 0; i < list.size(); ++i)
-				list[i] = Vector3f(points[3 * i], points[3 * i + 1], points[3 * i + 2]);
-
-			return std::make_shared<CurveEntity<Curve3>>(id, name, ctx.transform(),
-														 Curve3(list), width,
-														 matID, emsID);
-		}
+		// Share the curves between all entities using the same file and setup
+		const std::string key = path + "|" + basisStr + "|" + (flat ? "flat" : "round") + "|" + std::to_string(radiusScale);
+
+		std::shared_ptr<Curves> curves;
+		if (mLoadedCurves.count(key) > 0) {
+			curves = mLoadedCurves.at(key);
+		} else {
+			curves = std::make_shared<Curves>(basis, flat);
+			if (!curves->load(path, radiusScale)) {
+				PR_LOG(L_ERROR) << "Could not load curves for " << name << std::endl;
+				return nullptr;
+			}
+			mLoadedCurves[key] = curves;
 		}
+
+		// Emissive curves are sampled proportional to the area of their segments
+		if (emsID != PR_INVALID_ID && !curves->segmentSamplingDistribution())
+			curves->buildSegmentSamplingDistribution();
+
+		return std::make_shared<CurveEntity>(name, ctx.transform(), curves, matID, emsID);
 	}
 
 	const std::vector<std::string>& getNames() const override
 	{
-		static std::vector<std::string> names({ "curve", "bezier" });
+		static std::vector<std::string> names({ "curve", "curves", "hair" });
 		return names;
 	}
+
+	PluginSpecification specification(const std::string&) const override
+	{
+		return PluginSpecificationBuilder("Curve Entity", "A large set of curves like hair, fur or grass loaded from a binary file")
+			.Identifiers(getNames())
+			.Inputs()
+			.Filename("file", "Binary curve file")
+			.Option("basis", "Basis of the curve segments", "bezier", { "bezier", "bspline", "linear" })
+			.Bool("flat", "Use flat ribbons facing the ray instead of round tubes", false)
+			.Number("radius_scale", "Scale applied to the radius of all control points", 1.0f)
+			.MaterialReference("material", "Material")
+			.EmissionReference("emission", "Emission", true)
+			.Specification()
+			.get();
+	}
 };
 } // namespace PR
 
-PR_PLUGIN_INIT(PR::CurveEntityPlugin, _PR_PLUGIN_NAME, PR_PLUGIN_VERSION)
\ No newline at end of file
+PR_PLUGIN_INIT(PR::CurveEntityPlugin, _PR_PLUGIN_NAME, PR_PLUGIN_VERSION)
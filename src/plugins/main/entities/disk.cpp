@@ -56,6 +56,11 @@ public:
 		return mDisk.toBoundingBox();
 	}
 
+	NormalCone worldNormalCone() const override
+	{
+		return NormalCone((normalMatrix() * mDisk.normal()).normalized(), 0.0f);
+	}
+
 	GeometryRepr constructGeometryRepresentation(const GeometryDev& dev) const override
 	{
 		const Vector3f center = transform() * Vector3f(0, 0, 0);
@@ -8,6 +8,7 @@
 #include "entity/IEntity.h"
 #include "entity/IEntityPlugin.h"
 #include "geometry/GeometryPoint.h"
+#include "math/Distribution1D.h"
 #include "math/Projection.h"
 #include "math/SplitSample.h"
 #include "math/Tangent.h"
@@ -183,21 +184,34 @@ public:
 		return GeometryRepr(geom);
 	}
 
-	// TODO: Better sampling pdf for sampleParameterPointPDF
 	EntitySamplePoint sampleParameterPoint(const Vector2f& rnd) const override
 	{
 		PR_PROFILE_THIS;
-		const SplitSample2D split(rnd, 0, mMesh->base()->faceCount());
-		const uint32 faceID = split.integral1();
+
+		const Distribution1D* faceDistribution = mMesh->base()->faceSamplingDistribution();
+
+		// Select face proportional to its area if possible
+		uint32 faceID;
+		float pdf_f;
+		Vector2f rnd2;
+		if (faceDistribution) {
+			faceID	= (uint32)faceDistribution->sampleDiscrete(rnd(0), pdf_f, &rnd2(0));
+			rnd2(1) = rnd(1);
+		} else {
+			const SplitSample2D split(rnd, 0, mMesh->base()->faceCount());
+			faceID = split.integral1();
+			pdf_f  = 1.0f / mMesh->base()->faceCount();
+			rnd2   = Vector2f(split.uniform1(), split.uniform2());
+		}
 
 		const Face face	  = mMesh->base()->getFace(faceID);
-		const float pdf_a = 1.0f / (mMesh->base()->faceCount() * face.surfaceArea() * volumeScalefactor());
+		const float pdf_a = pdf_f / (face.surfaceArea() * volumeScalefactor());
 
 		Vector2f uv;
 		if (!face.IsQuad)
-			uv = Triangle::sample(Vector2f(split.uniform1(), split.uniform2()));
+			uv = Triangle::sample(rnd2);
 		else
-			uv = Vector2f(split.uniform1(), split.uniform2());
+			uv = rnd2;
 
 		return EntitySamplePoint(transform() * face.interpolateVertices(uv), uv, faceID, pdf_a);
 	}
@@ -249,6 +263,11 @@ public:
 		pt.DisplaceID  = PR_INVALID_ID;
 	}
 
+	uint32 localMaterialSlot(uint32 primitiveID) const override
+	{
+		return mMesh->base()->materialSlot(primitiveID);
+	}
+
 private:
 	const std::vector<uint32> mMaterials;
 	const std::shared_ptr<Mesh> mMesh;
@@ -283,6 +302,10 @@ public:
 				mOriginalMesh[mesh.get()] = mesh_p;
 			}
 
+			// Emissive meshes are sampled proportional to the area of their faces
+			if (emsID != PR_INVALID_ID && !mesh->faceSamplingDistribution())
+				mesh->buildFaceSamplingDistribution();
+
 			if (customNormal && mesh->features() & MeshFeature::Normal) {
 				if (mesh->features() & MeshFeature::Texture)
 					return std::make_shared<MeshEntity<true, true>>(name, ctx.transform(),
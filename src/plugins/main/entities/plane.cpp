@@ -68,6 +68,11 @@ public:
 		return mPlane.toBoundingBox();
 	}
 
+	NormalCone worldNormalCone() const override
+	{
+		return NormalCone(mEz, 0.0f);
+	}
+
 	GeometryRepr constructGeometryRepresentation(const GeometryDev& dev) const override
 	{
 		auto geom	= rtcNewGeometry(dev, RTC_GEOMETRY_TYPE_QUAD);
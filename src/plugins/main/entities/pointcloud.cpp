@@ -0,0 +1,740 @@
+#include "Environment.h"
+#include "Logger.h"
+#include "Profiler.h"
+#include "SceneLoadContext.h"
+#include "entity/GeometryDev.h"
+#include "entity/GeometryRepr.h"
+#include "entity/IEntity.h"
+#include "entity/IEntityPlugin.h"
+#include "geometry/GeometryPoint.h"
+#include "math/Distribution1D.h"
+#include "math/Sampling.h"
+#include "math/Spherical.h"
+#include "math/SplitSample.h"
+#include "math/Tangent.h"
+#include "serialization/FileSerializer.h"
+
+#include <algorithm>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <sstream>
+
+namespace PR {
+/*
+	Binary point cloud file (little endian):
+	char[4]		Magic "PRPC"
+	uint32		Version (1)
+	uint32		Point count
+	uint32		Flags (0x1: Normals given, 0x2: Material slots given)
+	float[4]	Points as x, y, z, radius [Point count]
+	float[3]	Normals, only if flag is set [Point count]
+	uint32		Material slots, only if flag is set [Point count]
+
+	Alternatively a ply file with a vertex element containing the properties x, y, z
+	and optionally radius (or pscale), nx, ny, nz and material (or material_index) can be used.
+*/
+constexpr char POINTCLOUD_FILE_MAGIC[4]		 = { 'P', 'R', 'P', 'C' };
+constexpr uint32 POINTCLOUD_FILE_VERSION	 = 1;
+constexpr uint32 POINTCLOUD_FLAG_NORMALS	 = 0x1;
+constexpr uint32 POINTCLOUD_FLAG_MATERIALS	 = 0x2;
+constexpr uint64 POINTCLOUD_FILE_HEADER_SIZE = sizeof(POINTCLOUD_FILE_MAGIC) + 3 * sizeof(uint32);
+
+enum class PointType {
+	Sphere,
+	Disc
+};
+
+/// Minimal reader for the vertex element of ascii and binary ply files
+class PlyPointReader {
+public:
+	bool read(const std::filesystem::path& path, float defaultRadius,
+			  std::vector<float>& points, std::vector<float>& normals, std::vector<uint32>& slots)
+	{
+		std::ifstream stream(path, std::ios::in | std::ios::binary);
+		if (!stream) {
+			PR_LOG(L_ERROR) << "Could not open ply file " << path << std::endl;
+			return false;
+		}
+
+		if (!readHeader(stream, path))
+			return false;
+
+		const int xElem = propertyIndex({ "x" });
+		const int yElem = propertyIndex({ "y" });
+		const int zElem = propertyIndex({ "z" });
+		const int rElem = propertyIndex({ "radius", "pscale" });
+		const int nx	= propertyIndex({ "nx" });
+		const int ny	= propertyIndex({ "ny" });
+		const int nz	= propertyIndex({ "nz" });
+		const int mElem = propertyIndex({ "material", "material_index" });
+
+		if (xElem < 0 || yElem < 0 || zElem < 0) {
+			PR_LOG(L_ERROR) << "Ply file " << path << " does not contain vertex positions" << std::endl;
+			return false;
+		}
+
+		// The vertex count is given by the file, therefore check it against the remaining data before allocating
+		std::error_code ec;
+		const uint64 fileSize = std::filesystem::file_size(path, ec);
+		const auto headerSize = stream.tellg();
+		if (ec || headerSize < 0 || fileSize < static_cast<uint64>(headerSize)) {
+			PR_LOG(L_ERROR) << "Could not determine size of ply file " << path << std::endl;
+			return false;
+		}
+
+		// Ascii values need at least a digit and a separator each, except the very last one
+		const bool isAscii		   = mFormat == Format::Ascii;
+		const uint64 remaining	   = fileSize - static_cast<uint64>(headerSize) + (isAscii ? 1 : 0);
+		const uint64 minVertexSize = isAscii ? 2 * mProperties.size() : mStride;
+		if (minVertexSize == 0 || mVertexCount > remaining / minVertexSize) {
+			PR_LOG(L_ERROR) << "Ply file " << path << " is truncated or has an invalid vertex count" << std::endl;
+			return false;
+		}
+
+		const bool hasNormals = nx >= 0 && ny >= 0 && nz >= 0;
+		points.resize(mVertexCount * 4);
+		if (hasNormals)
+			normals.resize(mVertexCount * 3);
+		if (mElem >= 0)
+			slots.resize(mVertexCount);
+
+		std::vector<double> values(mProperties.size());
+		std::vector<char> record(mStride);
+		for (size_t i = 0; i < mVertexCount; ++i) {
+			if (!readVertex(stream, record, values)) {
+				PR_LOG(L_ERROR) << "Ply file " << path << " has not enough vertices" << std::endl;
+				return false;
+			}
+
+			points[4 * i + 0] = static_cast<float>(values[xElem]);
+			points[4 * i + 1] = static_cast<float>(values[yElem]);
+			points[4 * i + 2] = static_cast<float>(values[zElem]);
+			points[4 * i + 3] = rElem >= 0 ? static_cast<float>(values[rElem]) : defaultRadius;
+
+			// Normals are normalized and validated by the point cloud itself
+			if (hasNormals) {
+				normals[3 * i + 0] = static_cast<float>(values[nx]);
+				normals[3 * i + 1] = static_cast<float>(values[ny]);
+				normals[3 * i + 2] = static_cast<float>(values[nz]);
+			}
+
+			if (mElem >= 0)
+				slots[i] = static_cast<uint32>(values[mElem]);
+		}
+
+		return true;
+	}
+
+private:
+	enum class Format {
+		Ascii,
+		BinaryLittleEndian,
+		BinaryBigEndian
+	};
+
+	enum class PropertyType {
+		Unknown,
+		Int8,
+		UInt8,
+		Int16,
+		UInt16,
+		Int32,
+		UInt32,
+		Float32,
+		Float64
+	};
+
+	struct Property {
+		std::string Name;
+		PropertyType Type;
+		size_t Size;
+		size_t Offset;
+	};
+
+	static inline PropertyType parseType(const std::string& type)
+	{
+		if (type == "char" || type == "int8")
+			return PropertyType::Int8;
+		else if (type == "uchar" || type == "uint8")
+			return PropertyType::UInt8;
+		else if (type == "short" || type == "int16")
+			return PropertyType::Int16;
+		else if (type == "ushort" || type == "uint16")
+			return PropertyType::UInt16;
+		else if (type == "int" || type == "int32")
+			return PropertyType::Int32;
+		else if (type == "uint" || type == "uint32")
+			return PropertyType::UInt32;
+		else if (type == "float" || type == "float32")
+			return PropertyType::Float32;
+		else if (type == "double" || type == "float64")
+			return PropertyType::Float64;
+		else
+			return PropertyType::Unknown;
+	}
+
+	static inline size_t typeSize(PropertyType type)
+	{
+		switch (type) {
+		case PropertyType::Int8:
+		case PropertyType::UInt8:
+			return 1;
+		case PropertyType::Int16:
+		case PropertyType::UInt16:
+			return 2;
+		case PropertyType::Int32:
+		case PropertyType::UInt32:
+		case PropertyType::Float32:
+			return 4;
+		case PropertyType::Float64:
+			return 8;
+		default:
+			return 0;
+		}
+	}
+
+	bool readHeader(std::ifstream& stream, const std::filesystem::path& path)
+	{
+		std::string line;
+		if (!std::getline(stream, line) || line.rfind("ply", 0) != 0) {
+			PR_LOG(L_ERROR) << "Given file " << path << " is not a ply file" << std::endl;
+			return false;
+		}
+
+		bool inVertexElement = false;
+		bool vertexSeen		 = false;
+		while (std::getline(stream, line)) {
+			std::stringstream sstream(line);
+
+			std::string action;
+			sstream >> action;
+			if (action == "format") {
+				std::string method;
+				sstream >> method;
+				if (method == "ascii")
+					mFormat = Format::Ascii;
+				else if (method == "binary_big_endian")
+					mFormat = Format::BinaryBigEndian;
+				else
+					mFormat = Format::BinaryLittleEndian;
+			} else if (action == "element") {
+				std::string type;
+				sstream >> type;
+				if (type == "vertex") {
+					sstream >> mVertexCount;
+					inVertexElement = true;
+					vertexSeen		= true;
+				} else {
+					if (!vertexSeen) {
+						PR_LOG(L_ERROR) << "Ply file " << path << " has to start with the vertex element" << std::endl;
+						return false;
+					}
+					inVertexElement = false;
+				}
+			} else if (action == "property" && inVertexElement) {
+				std::string type;
+				Property prop;
+				sstream >> type >> prop.Name;
+				prop.Type	= parseType(type);
+				prop.Size	= typeSize(prop.Type);
+				prop.Offset = mStride;
+				if (prop.Size == 0) {
+					PR_LOG(L_ERROR) << "Ply file " << path << " has unsupported vertex property type '" << type << "'" << std::endl;
+					return false;
+				}
+
+				mStride += prop.Size;
+				mProperties.push_back(prop);
+			} else if (action == "end_header") {
+				return vertexSeen;
+			}
+		}
+
+		return false;
+	}
+
+	inline int propertyIndex(const std::initializer_list<const char*>& names) const
+	{
+		for (const char* name : names) {
+			for (size_t i = 0; i < mProperties.size(); ++i) {
+				if (mProperties[i].Name == name)
+					return static_cast<int>(i);
+			}
+		}
+		return -1;
+	}
+
+	template <typename T>
+	inline double decode(const char* data) const
+	{
+		T val;
+		if (mFormat == Format::BinaryBigEndian) {
+			char swapped[sizeof(T)];
+			std::reverse_copy(data, data + sizeof(T), swapped);
+			std::memcpy(&val, swapped, sizeof(T));
+		} else {
+			std::memcpy(&val, data, sizeof(T));
+		}
+		return static_cast<double>(val);
+	}
+
+	inline double decode(const Property& prop, const char* data) const
+	{
+		switch (prop.Type) {
+		case PropertyType::Int8:
+			return decode<int8>(data);
+		case PropertyType::UInt8:
+			return decode<uint8>(data);
+		case PropertyType::Int16:
+			return decode<int16>(data);
+		case PropertyType::UInt16:
+			return decode<uint16>(data);
+		case PropertyType::Int32:
+			return decode<int32>(data);
+		case PropertyType::UInt32:
+			return decode<uint32>(data);
+		case PropertyType::Float32:
+			return decode<float>(data);
+		default:
+		case PropertyType::Float64:
+			return decode<double>(data);
+		}
+	}
+
+	inline bool readVertex(std::ifstream& stream, std::vector<char>& record, std::vector<double>& values) const
+	{
+		if (mFormat == Format::Ascii) {
+			for (double& v : values)
+				stream >> v;
+		} else {
+			stream.read(record.data(), record.size());
+			for (size_t i = 0; i < mProperties.size(); ++i)
+				values[i] = decode(mProperties[i], &record[mProperties[i].Offset]);
+		}
+		return static_cast<bool>(stream);
+	}
+
+	Format mFormat		= Format::Ascii;
+	size_t mVertexCount = 0;
+	size_t mStride		= 0;
+	std::vector<Property> mProperties;
+};
+
+// All points of a single file, stored in one embree geometry
+class PointCloud {
+public:
+	explicit PointCloud(PointType type)
+		: mScene()
+		, mGeometry()
+		, mType(type)
+		, mSurfaceArea(0.0f)
+		, mWasGenerated(false)
+	{
+	}
+
+	~PointCloud()
+	{
+		if (mWasGenerated) {
+			rtcReleaseGeometry(mGeometry);
+			rtcReleaseScene(mScene);
+		}
+	}
+
+	bool load(const std::filesystem::path& path, float defaultRadius, float radiusScale)
+	{
+		PR_PROFILE_THIS;
+
+		const bool success = path.extension() == ".ply"
+								 ? PlyPointReader().read(path, defaultRadius, mPoints, mNormals, mMaterialSlots)
+								 : loadBinary(path);
+		if (!success)
+			return false;
+
+		if (radiusScale != 1.0f) {
+			for (size_t i = 0; i < pointCount(); ++i)
+				mPoints[4 * i + 3] *= radiusScale;
+		}
+
+		// Discs can not be oriented by degenerated normals, fall back to discs facing the ray instead
+		if (hasNormals() && !normalizeNormals()) {
+			PR_LOG(L_WARNING) << "Point cloud " << path << " contains zero or invalid normals. Ignoring all normals" << std::endl;
+			mNormals.clear();
+			mNormals.shrink_to_fit();
+		}
+
+		setupCache();
+		return pointCount() > 0;
+	}
+
+	inline RTCScene generate(const RTCDevice& dev)
+	{
+		if (!mWasGenerated) {
+			setupOriginal(dev);
+			mWasGenerated = true;
+		}
+
+		return mScene;
+	}
+
+	inline size_t pointCount() const { return mPoints.size() / 4; }
+	inline PointType type() const { return mType; }
+	inline bool hasNormals() const { return !mNormals.empty(); }
+	inline bool hasMaterialSlots() const { return !mMaterialSlots.empty(); }
+	inline float surfaceArea() const { return mSurfaceArea; }
+	inline const BoundingBox& boundingBox() const { return mBoundingBox; }
+
+	/// Center and radius
+	inline Vector4f point(size_t i) const { return Eigen::Map<const Vector4f>(&mPoints[4 * i]); }
+	inline Vector3f normal(size_t i) const { return Eigen::Map<const Vector3f>(&mNormals[3 * i]); }
+	inline uint32 materialSlot(size_t i) const { return hasMaterialSlots() ? mMaterialSlots[i] : 0; }
+
+	inline float pointArea(size_t i) const
+	{
+		const float radius = mPoints[4 * i + 3];
+		return mType == PointType::Sphere ? 4 * PR_PI * radius * radius : PR_PI * radius * radius;
+	}
+
+	inline const Distribution1D* pointSamplingDistribution() const { return mPointSamplingDistribution.get(); }
+	inline void buildPointSamplingDistribution()
+	{
+		mPointSamplingDistribution = std::make_unique<Distribution1D>(pointCount());
+		mPointSamplingDistribution->generate([&](size_t i) { return pointArea(i); });
+	}
+
+private:
+	inline bool normalizeNormals()
+	{
+		for (size_t i = 0; i < pointCount(); ++i) {
+			Eigen::Map<Vector3f> N(&mNormals[3 * i]);
+			const float norm = N.norm();
+			if (!std::isfinite(norm) || norm <= PR_EPSILON)
+				return false;
+			N /= norm;
+		}
+		return true;
+	}
+
+	bool loadBinary(const std::filesystem::path& path)
+	{
+		FileSerializer serializer(path, true);
+		if (!serializer.isValid()) {
+			PR_LOG(L_ERROR) << "Could not open point cloud file " << path << std::endl;
+			return false;
+		}
+
+		// The stream does not report short reads, therefore check the file size up front
+		std::error_code ec;
+		const uint64 fileSize = std::filesystem::file_size(path, ec);
+		if (ec || fileSize < POINTCLOUD_FILE_HEADER_SIZE) {
+			PR_LOG(L_ERROR) << "Given file " << path << " is not a valid point cloud file" << std::endl;
+			return false;
+		}
+
+		// Read header
+		char magic[4];
+		serializer.readRaw(reinterpret_cast<uint8*>(magic), sizeof(magic));
+
+		uint32 version = 0;
+		uint32 count   = 0;
+		uint32 flags   = 0;
+		serializer.read(version);
+		serializer.read(count);
+		serializer.read(flags);
+
+		if (!serializer.isValid() || !std::equal(magic, magic + 4, POINTCLOUD_FILE_MAGIC) || version != POINTCLOUD_FILE_VERSION) {
+			PR_LOG(L_ERROR) << "Given file " << path << " is not a valid point cloud file" << std::endl;
+			return false;
+		}
+
+		// The count is widened before multiplying, as it is given by the file
+		uint64 pointSize = 4 * sizeof(float);
+		if (flags & POINTCLOUD_FLAG_NORMALS)
+			pointSize += 3 * sizeof(float);
+		if (flags & POINTCLOUD_FLAG_MATERIALS)
+			pointSize += sizeof(uint32);
+		if (fileSize - POINTCLOUD_FILE_HEADER_SIZE < pointSize * static_cast<uint64>(count)) {
+			PR_LOG(L_ERROR) << "Point cloud file " << path << " is truncated" << std::endl;
+			return false;
+		}
+
+		// Read content
+		mPoints.resize(static_cast<size_t>(count) * 4);
+		serializer.readRaw(reinterpret_cast<uint8*>(mPoints.data()), sizeof(float) * mPoints.size());
+
+		if (flags & POINTCLOUD_FLAG_NORMALS) {
+			mNormals.resize(static_cast<size_t>(count) * 3);
+			serializer.readRaw(reinterpret_cast<uint8*>(mNormals.data()), sizeof(float) * mNormals.size());
+		}
+
+		if (flags & POINTCLOUD_FLAG_MATERIALS) {
+			mMaterialSlots.resize(count);
+			serializer.readRaw(reinterpret_cast<uint8*>(mMaterialSlots.data()), sizeof(uint32) * mMaterialSlots.size());
+		}
+
+		return true;
+	}
+
+	inline void setupCache()
+	{
+		mBoundingBox = BoundingBox();
+		mSurfaceArea = 0;
+		for (size_t i = 0; i < pointCount(); ++i) {
+			const Vector4f p = point(i);
+			mBoundingBox.combine(p.head<3>() - Vector3f::Constant(p(3)));
+			mBoundingBox.combine(p.head<3>() + Vector3f::Constant(p(3)));
+			mSurfaceArea += pointArea(i);
+		}
+	}
+
+	inline void setupOriginal(const RTCDevice& dev)
+	{
+		RTCGeometryType type;
+		if (mType == PointType::Sphere)
+			type = RTC_GEOMETRY_TYPE_SPHERE_POINT;
+		else
+			type = hasNormals() ? RTC_GEOMETRY_TYPE_ORIENTED_DISC_POINT : RTC_GEOMETRY_TYPE_DISC_POINT;
+
+		mGeometry = rtcNewGeometry(dev, type);
+
+		// Share the buffers with embree, all points end up in a single geometry
+		rtcSetSharedGeometryBuffer(mGeometry, RTC_BUFFER_TYPE_VERTEX, 0, RTC_FORMAT_FLOAT4, mPoints.data(), 0, sizeof(float) * 4, pointCount());
+		if (type == RTC_GEOMETRY_TYPE_ORIENTED_DISC_POINT)
+			rtcSetSharedGeometryBuffer(mGeometry, RTC_BUFFER_TYPE_NORMAL, 0, RTC_FORMAT_FLOAT3, mNormals.data(), 0, sizeof(float) * 3, pointCount());
+		rtcCommitGeometry(mGeometry);
+
+		mScene = rtcNewScene(dev);
+
+		rtcAttachGeometry(mScene, mGeometry);
+
+		rtcSetSceneFlags(mScene, RTC_SCENE_FLAG_COMPACT | RTC_SCENE_FLAG_ROBUST);
+		rtcSetSceneBuildQuality(mScene, RTC_BUILD_QUALITY_HIGH);
+		rtcCommitScene(mScene);
+	}
+
+	RTCScene mScene;
+	RTCGeometry mGeometry;
+
+	const PointType mType;
+
+	std::vector<float> mPoints;	 // x, y, z, radius
+	std::vector<float> mNormals; // Only used for oriented discs
+	std::vector<uint32> mMaterialSlots;
+
+	BoundingBox mBoundingBox;
+	float mSurfaceArea;
+	std::unique_ptr<Distribution1D> mPointSamplingDistribution;
+	bool mWasGenerated;
+};
+
+class PointCloudEntity : public IEntity {
+public:
+	ENTITY_CLASS
+
+	PointCloudEntity(const std::string& name, const Transformf& transform,
+					 const std::shared_ptr<PointCloud>& cloud,
+					 const std::vector<uint32>& materials,
+					 uint32 lightID)
+		: IEntity(lightID, name, transform)
+		, mCloud(cloud)
+		, mMaterials(materials)
+	{
+	}
+
+	virtual ~PointCloudEntity() {}
+
+	std::string type() const override
+	{
+		return "pointcloud";
+	}
+
+	virtual float localSurfaceArea(uint32 id) const override
+	{
+		if (id == PR_INVALID_ID)
+			return mCloud->surfaceArea();
+
+		// All points share the first material if no slots are given
+		if (!mCloud->hasMaterialSlots())
+			return id == materialID(0) ? mCloud->surfaceArea() : 0;
+
+		float area = 0;
+		for (size_t i = 0; i < mCloud->pointCount(); ++i) {
+			if (materialID(mCloud->materialSlot(i)) == id)
+				area += mCloud->pointArea(i);
+		}
+		return area;
+	}
+
+	bool isCollidable() const override
+	{
+		return mCloud->pointCount() > 0;
+	}
+
+	float collisionCost() const override
+	{
+		return (float)mCloud->pointCount();
+	}
+
+	BoundingBox localBoundingBox() const override
+	{
+		return mCloud->boundingBox();
+	}
+
+	GeometryRepr constructGeometryRepresentation(const GeometryDev& dev) const override
+	{
+		RTCScene original = mCloud->generate(dev);
+
+		RTCGeometry geom = rtcNewGeometry(dev, RTC_GEOMETRY_TYPE_INSTANCE);
+		rtcSetGeometryInstancedScene(geom, original);
+
+		const Transformf& M = transform();
+		rtcSetGeometryTransform(geom, 0, RTC_FORMAT_FLOAT4X4_COLUMN_MAJOR, M.data());
+		rtcCommitGeometry(geom);
+
+		return GeometryRepr(geom);
+	}
+
+	EntitySamplePoint sampleParameterPoint(const Vector2f& rnd) const override
+	{
+		PR_PROFILE_THIS;
+
+		const Distribution1D* pointDistribution = mCloud->pointSamplingDistribution();
+
+		// Select point proportional to its area if possible
+		uint32 index;
+		float pdf_p;
+		Vector2f rnd2;
+		if (pointDistribution) {
+			index	= (uint32)pointDistribution->sampleDiscrete(rnd(0), pdf_p, &rnd2(0));
+			rnd2(1) = rnd(1);
+		} else {
+			const SplitSample2D split(rnd, 0, mCloud->pointCount());
+			index = split.integral1();
+			pdf_p = 1.0f / mCloud->pointCount();
+			rnd2  = Vector2f(split.uniform1(), split.uniform2());
+		}
+
+		const Vector4f p  = mCloud->point(index);
+		const float pdf_a = pdf_p / (mCloud->pointArea(index) * volumeScalefactor());
+
+		Vector3f pos;
+		if (mCloud->type() == PointType::Sphere) {
+			pos = p.head<3>() + p(3) * Sampling::sphere(rnd2(0), rnd2(1));
+		} else {
+			// Discs without normal face the ray, therefore any orientation is a valid approximation
+			const Vector3f N = mCloud->hasNormals() ? mCloud->normal(index) : Vector3f(Vector3f::UnitZ());
+			Vector3f Nx, Ny;
+			Tangent::frame(N, Nx, Ny);
+
+			const float r	= p(3) * std::sqrt(rnd2(0));
+			const float phi = 2 * PR_PI * rnd2(1);
+			pos				= p.head<3>() + r * (std::cos(phi) * Nx + std::sin(phi) * Ny);
+		}
+
+		return EntitySamplePoint(transform() * pos, rnd2, index, pdf_a);
+	}
+
+	void provideGeometryPoint(const EntityGeometryQueryPoint& query,
+							  GeometryPoint& pt) const override
+	{
+		PR_PROFILE_THIS;
+
+		const Vector4f p = mCloud->point(query.PrimitiveID);
+
+		Vector2f uv = query.UV;
+		if (mCloud->type() == PointType::Sphere) {
+			pt.N = (invTransform() * query.Position - p.head<3>()).normalized();
+			uv	 = Spherical::uv_from_normal(pt.N);
+		} else if (mCloud->hasNormals()) {
+			pt.N = mCloud->normal(query.PrimitiveID);
+		} else {
+			pt.N = -(invTransform().linear() * query.View).normalized();
+		}
+
+		// Global
+		pt.N = (normalMatrix() * pt.N).normalized();
+		Tangent::frame(pt.N, pt.Nx, pt.Ny);
+
+		pt.UV		   = uv;
+		pt.PrimitiveID = query.PrimitiveID;
+		pt.MaterialID  = materialID(mCloud->materialSlot(query.PrimitiveID));
+		pt.EmissionID  = emissionID();
+		pt.DisplaceID  = PR_INVALID_ID;
+	}
+
+	uint32 localMaterialSlot(uint32 primitiveID) const override
+	{
+		return mCloud->materialSlot(primitiveID);
+	}
+
+private:
+	inline uint32 materialID(uint32 slot) const { return slot < mMaterials.size() ? mMaterials[slot] : PR_INVALID_ID; }
+
+	const std::shared_ptr<PointCloud> mCloud;
+	const std::vector<uint32> mMaterials;
+};
+
+class PointCloudEntityPlugin : public IEntityPlugin {
+public:
+	std::unordered_map<std::string, std::shared_ptr<PointCloud>> mLoadedClouds;
+
+	std::shared_ptr<IEntity> create(const std::string&, const SceneLoadContext& ctx) override
+	{
+		const ParameterGroup& params = ctx.parameters();
+
+		const std::string name	  = params.getString("name", "__unnamed__");
+		const std::string path	  = ctx.escapePath(params.getString("file", "")).generic_string();
+		const std::string typeStr = params.getString("point_type", "sphere");
+		const float radius		  = params.getNumber("radius", 1.0f);
+		const float radiusScale	  = params.getNumber("radius_scale", 1.0f);
+		const PointType type	  = typeStr == "disc" || typeStr == "disk" ? PointType::Disc : PointType::Sphere;
+
+		const std::vector<uint32> materials = ctx.lookupMaterialIDArray(params.getParameter("materials"));
+		const uint32 emsID					= ctx.lookupEmissionID(params.getParameter("emission"));
+
+		// Share the points between all entities using the same file and setup
+		const std::string key = path + "|" + (type == PointType::Sphere ? "sphere" : "disc") + "|" + std::to_string(radius) + "|" + std::to_string(radiusScale);
+
+		std::shared_ptr<PointCloud> cloud;
+		if (mLoadedClouds.count(key) > 0) {
+			cloud = mLoadedClouds.at(key);
+		} else {
+			cloud = std::make_shared<PointCloud>(type);
+			if (!cloud->load(path, radius, radiusScale)) {
+				PR_LOG(L_ERROR) << "Could not load points for " << name << std::endl;
+				return nullptr;
+			}
+			mLoadedClouds[key] = cloud;
+		}
+
+		// Emissive point clouds are sampled proportional to the area of their points
+		if (emsID != PR_INVALID_ID && !cloud->pointSamplingDistribution())
+			cloud->buildPointSamplingDistribution();
+
+		return std::make_shared<PointCloudEntity>(name, ctx.transform(), cloud, materials, emsID);
+	}
+
+	const std::vector<std::string>& getNames() const override
+	{
+		static std::vector<std::string> names({ "pointcloud", "point_cloud", "particles" });
+		return names;
+	}
+
+	PluginSpecification specification(const std::string&) const override
+	{
+		return PluginSpecificationBuilder("Point Cloud Entity", "A large set of spheres or discs like particles loaded from a binary or ply file")
+			.Identifiers(getNames())
+			.Inputs()
+			.Filename("file", "Binary point cloud or ply file")
+			.Option("point_type", "Shape of each point", "sphere", { "sphere", "disc" })
+			.Number("radius", "Radius of points if not given by the file", 1.0f)
+			.Number("radius_scale", "Scale applied to the radius of all points", 1.0f)
+			.MaterialReferenceV({ "material", "materials" }, "Material, indexed by the material slot of each point")
+			.EmissionReference("emission", "Emission", true)
+			.Specification()
+			.get();
+	}
+};
+} // namespace PR
+
+PR_PLUGIN_INIT(PR::PointCloudEntityPlugin, _PR_PLUGIN_NAME, PR_PLUGIN_VERSION)
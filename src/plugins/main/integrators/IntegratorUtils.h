@@ -17,9 +17,20 @@ public:
 	{
 		PR_PROFILE_THIS;
 		const LightPath cb = LightPath::createCB();
-		session.tile()->statistics().add(RenderStatisticEntry::CameraDepthCount, sg.size());
-		session.tile()->statistics().add(RenderStatisticEntry::BackgroundHitCount, sg.size());
+		session.tile()->localStatistics().add(RenderStatisticEntry::CameraDepthCount, sg.size());
+		session.tile()->localStatistics().add(RenderStatisticEntry::BackgroundHitCount, sg.size());
 
+		for (size_t i = 0; i < sg.size(); ++i) {
+			Ray ray;
+			sg.extractRay(i, ray);
+			handleBackgroundRay(session, ray, cb);
+		}
+	}
+
+	/// Splat contribution of all infinite lights for a single primary ray which did not hit anything.
+	/// Statistics are not updated
+	static inline void handleBackgroundRay(RenderTileSession& session, const Ray& ray, const LightPath& cb)
+	{
 		bool illuminated		= false;
 		const auto lightSampler = session.context()->lightSampler();
 
@@ -28,34 +39,25 @@ public:
 				continue;
 
 			illuminated = true;
-			for (size_t i = 0; i < sg.size(); ++i) {
-				Ray ray;
-				sg.extractRay(i, ray);
-
-				InfiniteLightEvalInput lin;
-				lin.WavelengthNM   = ray.WavelengthNM;
-				lin.Direction	   = ray.Direction;
-				lin.IterationDepth = ray.IterationDepth;
-				InfiniteLightEvalOutput lout;
-				light->asInfiniteLight()->eval(lin, lout, session);
-
-				session.pushSpectralFragment(SpectralBlob::Ones(), SpectralBlob::Ones(), lout.Radiance, ray, cb);
-			}
-		}
 
-		if (!illuminated) { // If no inf. lights are available make sure at least zero is splatted
-			for (size_t i = 0; i < sg.size(); ++i) {
-				Ray ray;
-				sg.extractRay(i, ray);
-				session.pushSpectralFragment(SpectralBlob::Ones(), SpectralBlob::Ones(), SpectralBlob::Zero(), ray, cb);
-			}
+			InfiniteLightEvalInput lin;
+			lin.WavelengthNM   = ray.WavelengthNM;
+			lin.Direction	   = ray.Direction;
+			lin.IterationDepth = ray.IterationDepth;
+			InfiniteLightEvalOutput lout;
+			light->asInfiniteLight()->eval(lin, lout, session);
+
+			session.pushSpectralFragment(SpectralBlob::Ones(), SpectralBlob::Ones(), lout.Radiance, ray, cb);
 		}
+
+		if (!illuminated) // If no inf. lights are available make sure at least zero is splatted
+			session.pushSpectralFragment(SpectralBlob::Ones(), SpectralBlob::Ones(), SpectralBlob::Zero(), ray, cb);
 	}
 
 	template <typename Func>
 	static inline bool handleBackground(RenderTileSession& session, const Ray& ray, const Func& func)
 	{
-		session.tile()->statistics().add(RenderStatisticEntry::BackgroundHitCount);
+		session.tile()->localStatistics().add(RenderStatisticEntry::BackgroundHitCount);
 
 		bool illuminated		= false;
 		const auto lightSampler = session.context()->lightSampler();
@@ -30,14 +30,15 @@ public:
 	{
 		const LightPath stdPath = LightPath::createCDL(1);
 
-		session.tile()->statistics().add(RenderStatisticEntry::EntityHitCount, grp.size());
-		session.tile()->statistics().add(RenderStatisticEntry::CameraDepthCount, grp.size());
+		session.tile()->localStatistics().add(RenderStatisticEntry::EntityHitCount, grp.size());
+		session.tile()->localStatistics().add(RenderStatisticEntry::CameraDepthCount, grp.size());
 		for (size_t i = 0; i < grp.size(); ++i) {
 			IntersectionPoint spt;
 			grp.computeShadingPoint(i, spt);
 			Random& random = session.random(spt.Ray.PixelIndex);
 
-			size_t occlusions = 0;
+			// Each unoccluded direction contributes its share. The shadow tests are done in batches
+			const SpectralBlob weight = SpectralBlob(1.0f / mSampleCount);
 			for (size_t i = 0; i < mSampleCount; ++i) {
 				const Vector2f rnd	= random.get2D();
 				const Vector3f dir	= Sampling::hemi(rnd(0), rnd(1));
@@ -45,15 +46,10 @@ public:
 																dir);
 
 				const Ray n = spt.Ray.next(spt.P, ndir, spt.Surface.N, UsedRayType, PR_EPSILON, spt.Ray.MaxT);
-
-				if (session.traceShadowRay(n))
-					++occlusions;
+				session.pushDeferredSpectralFragment(SpectralBlob::Ones(), SpectralBlob::Ones(), weight, n, stdPath);
 			}
 
-			const SpectralBlob weight = SpectralBlob(1.0f - occlusions / (float)mSampleCount);
-
 			session.pushSPFragment(spt, stdPath);
-			session.pushSpectralFragment(SpectralBlob::Ones(), SpectralBlob::Ones(), weight, spt.Ray, stdPath);
 		}
 	}
 
@@ -66,10 +62,11 @@ public:
 			while (session.pipeline()->hasShadingGroup()) {
 				auto sg = session.pipeline()->popShadingGroup(session);
 				if (sg.isBackground())
-					session.tile()->statistics().add(RenderStatisticEntry::BackgroundHitCount, sg.size());
+					session.tile()->localStatistics().add(RenderStatisticEntry::BackgroundHitCount, sg.size());
 				else
 					handleShadingGroup(session, sg);
 			}
+			session.resolveShadowRays();
 		}
 	}
 
@@ -78,6 +78,7 @@ public:
 				else
 					handleShadingGroup(session, sg);
 			}
+			session.resolveShadowRays();
 		}
 	}
 
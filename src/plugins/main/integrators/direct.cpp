@@ -12,17 +12,19 @@
 #include "material/IMaterial.h"
 #include "math/ImportanceSampling.h"
 #include "output/Feedback.h"
+#include "output/OutputSystem.h"
 #include "path/LightPath.h"
+#include "ray/PathStateContainer.h"
 #include "renderer/RenderContext.h"
 #include "renderer/RenderTile.h"
 #include "renderer/RenderTileSession.h"
 #include "renderer/StreamPipeline.h"
 #include "sampler/SampleArray.h"
 #include "trace/IntersectionPoint.h"
+#include "vcm/Defaults.h"
 #include "vcm/MIS.h"
 #include "vcm/RussianRoulette.h"
 #include "vcm/Utils.h"
-#include "vcm/Walker.h"
 
 namespace PR {
 
@@ -31,6 +33,16 @@ inline static auto safeDiv(const SpectralBlob& a, const SpectralBlob& b)
 	return (b.cwiseAbs() <= PR_EPSILON).select(SpectralBlob::Zero(), a / b);
 }
 
+// Dimensions requested from the sampler per bounce, relative to the start of the bounce
+constexpr uint32 BOUNCE_SAMPLE_DIMS	 = 5;
+constexpr uint32 MATERIAL_SAMPLE_DIM = 0; // 2D
+constexpr uint32 LIGHT_SAMPLE_DIM	 = 2; // 3D
+
+inline static uint32 bounceDimension(const IntersectionPoint& ip, uint32 offset)
+{
+	return PATH_SAMPLE_DIM + ip.Ray.IterationDepth * BOUNCE_SAMPLE_DIMS + offset;
+}
+
 struct DiParameters {
 	size_t MaxCameraRayDepthHard = 64;
 	size_t MaxCameraRayDepthSoft = 4;
@@ -40,6 +52,7 @@ struct DiParameters {
 
 /// Standard path tracing
 /// Suports NEE, Inf Lights
+/// Bounces are traced in wavefront fashion through the stream pipeline
 /// TODO: Mediums/Volume
 template <bool HasInfLights, VCM::MISMode MISMode, bool EmissiveScatter>
 class IntDirectInstance : public IIntegratorInstance {
@@ -56,15 +69,18 @@ private:
 		Vector3f LastNormal		   = Vector3f::Zero();
 	};
 
+	struct PathState {
+		TraversalContext Context;
+		LightPath Path;
+	};
+
 public:
 	explicit IntDirectInstance(const DiParameters& parameters, const std::shared_ptr<LightSampler>& lightSampler)
 		: mParameters(parameters)
 		, mLightSampler(lightSampler)
 		, mCameraRR(parameters.MaxCameraRayDepthSoft)
-		, mCameraWalker(mParameters.MaxCameraRayDepthHard)
-		, mCameraPath(mParameters.MaxCameraRayDepthHard + 2)
+		, mBackgroundPath(LightPath::createCB())
 	{
-		mCameraPath.addToken(LightPathToken::Camera());
 	}
 
 	virtual ~IntDirectInstance() = default;
@@ -72,7 +88,7 @@ public:
 	// Every camera vertex
 	std::optional<Ray> handleCameraVertex(RenderTileSession& session, const IntersectionPoint& ip,
 										  IEntity* entity, IMaterial* material,
-										  TraversalContext& current)
+										  TraversalContext& current, LightPath& path)
 	{
 		PR_ASSERT(entity, "Expected valid entity");
 
@@ -80,15 +96,15 @@ public:
 
 		const uint32 pathLength = ip.Ray.IterationDepth + 1;
 
-		session.tile()->statistics().add(RenderStatisticEntry::EntityHitCount);
-		session.tile()->statistics().add(RenderStatisticEntry::CameraDepthCount);
+		session.tile()->localStatistics().add(RenderStatisticEntry::EntityHitCount);
+		session.tile()->localStatistics().add(RenderStatisticEntry::CameraDepthCount);
 
 		if (pathLength == 1)
-			session.pushSPFragment(ip, mCameraPath);
+			session.pushSPFragment(ip, path);
 
 		const bool hasEmission = entity->hasEmission();
 		if (mParameters.DoDirect && hasEmission) {
-			handleDirectHit(session, ip, entity, current);
+			handleDirectHit(session, ip, entity, current, path);
 			if constexpr (!EmissiveScatter)
 				return {};
 		}
@@ -98,43 +114,41 @@ public:
 			return {};
 
 		if (mParameters.DoNEE && !material->hasOnlyDeltaDistribution() && !hasEmission)
-			handleNEE(session, ip, material, current);
+			handleNEE(session, ip, material, current, path);
 
 		current.LastWasEmissive = hasEmission;
-		return handleScattering(session, ip, material, current);
+		return handleScattering(session, ip, material, current, path);
 	}
 
-	// First camera vertex
-	void traceCameraPath(RenderTileSession& session, const IntersectionPoint& initial_hit,
-						 const RayGroup& rayGroup, IEntity* entity, IMaterial* material)
+	// Start a new path for a camera ray
+	uint32 startPath(const RenderTileSession& session, const Ray& ray)
 	{
-		PR_PROFILE_THIS;
+		const uint32 pathID = mPathStates.acquire();
+		PathState& state	= mPathStates.state(pathID);
+
+		state.Context				= TraversalContext();
+		state.Context.WavelengthPDF = session.getRayGroup(ray).WavelengthPDF;
+		//state.Context.Throughput /= state.Context.WavelengthPDF[0];
+
+		// Let the path advance the LPE automata while bouncing, instead of matching it at every contribution
+		const auto* lpeGroups = &session.context()->output()->lpeGroups();
+		state.Path.reset();
+		if (!state.Path.isTrackingExpressionStates(lpeGroups))
+			state.Path.trackExpressionStates(lpeGroups);
+		state.Path.addToken(LightPathToken::Camera());
+		return pathID;
+	}
 
-		// Initial camera vertex
-		TraversalContext current;
-		current.WavelengthPDF = rayGroup.WavelengthPDF;
-		//current.Throughput /= current.WavelengthPDF[0];
-
-		mCameraWalker.traverse(
-			session, initial_hit, entity, material,
-			[&](const IntersectionPoint& ip, IEntity* entity2, IMaterial* material2) -> std::optional<Ray> {
-				return handleCameraVertex(session, ip,
-										  entity2, material2, current);
-			},
-			[&](const Ray& ray) {
-				mCameraPath.addToken(LightPathToken::Background());
-				if constexpr (HasInfLights) {
-					if (mParameters.DoDirect)
-						handleInfLights(session, current, ray);
-					else
-						handleZero(session, current, ray);
-				} else {
-					handleZero(session, current, ray);
-				}
-				mCameraPath.popToken();
-			});
-
-		mCameraPath.popTokenUntil(1);
+	// Enqueue the next bounce or terminate the path
+	void continuePath(RenderTileSession& session, uint32 pathID, const std::optional<Ray>& next)
+	{
+		if (next.has_value() && next.value().IterationDepth < mParameters.MaxCameraRayDepthHard) {
+			Ray ray	   = next.value();
+			ray.PathID = pathID;
+			session.pipeline()->enqueueBounceRay(ray);
+		} else {
+			mPathStates.release(pathID);
+		}
 	}
 
 	void handleShadingGroup(RenderTileSession& session, const ShadingGroup& sg)
@@ -144,31 +158,67 @@ public:
 		for (size_t i = 0; i < sg.size(); ++i) {
 			IntersectionPoint spt;
 			sg.computeShadingPoint(i, spt);
-			RayGroup rayGroup;
-			sg.extractRayGroup(i, rayGroup);
-			traceCameraPath(session, spt, rayGroup, sg.entity(), session.getMaterial(spt.Surface.Geometry.MaterialID));
+
+			const uint32 pathID = spt.Ray.PathID == PR_INVALID_ID ? startPath(session, spt.Ray) : spt.Ray.PathID;
+			PathState& state	= mPathStates.state(pathID);
+
+			const auto next = handleCameraVertex(session, spt, sg.entity(), session.getMaterial(spt.Surface.Geometry.MaterialID),
+												 state.Context, state.Path);
+			continuePath(session, pathID, next);
+		}
+	}
+
+	void handleBackgroundGroup(RenderTileSession& session, const ShadingGroup& sg)
+	{
+		PR_PROFILE_THIS;
+
+		for (size_t i = 0; i < sg.size(); ++i) {
+			Ray ray;
+			sg.extractRay(i, ray);
+
+			// Primary camera rays have no path state yet
+			if (ray.PathID == PR_INVALID_ID) {
+				session.tile()->localStatistics().add(RenderStatisticEntry::CameraDepthCount);
+				session.tile()->localStatistics().add(RenderStatisticEntry::BackgroundHitCount);
+				IntegratorUtils::handleBackgroundRay(session, ray, mBackgroundPath);
+				continue;
+			}
+
+			PathState& state = mPathStates.state(ray.PathID);
+			state.Path.addToken(LightPathToken::Background());
+			if constexpr (HasInfLights) {
+				if (mParameters.DoDirect)
+					handleInfLights(session, state.Context, state.Path, ray);
+				else
+					handleZero(session, state.Context, state.Path, ray);
+			} else {
+				handleZero(session, state.Context, state.Path, ray);
+			}
+			mPathStates.release(ray.PathID);
 		}
 	}
 
 	void onTile(RenderTileSession& session) override
 	{
 		PR_PROFILE_THIS;
+		mPathStates.reset();
 		while (!session.pipeline()->isFinished()) {
 			session.pipeline()->runPipeline();
 			while (session.pipeline()->hasShadingGroup()) {
 				auto sg = session.pipeline()->popShadingGroup(session);
 				if (sg.isBackground())
-					IntegratorUtils::handleBackgroundGroup(session, sg);
+					handleBackgroundGroup(session, sg);
 				else
 					handleShadingGroup(session, sg);
 			}
+			session.resolveShadowRays();
 		}
 	}
 
 private:
 	/// Handle scattering (aka, next ray direction)
 	std::optional<Ray> handleScattering(RenderTileSession& session, const IntersectionPoint& ip,
-										IMaterial* material, TraversalContext& current)
+										IMaterial* material, TraversalContext& current, LightPath& path)
 	{
 		auto& rnd = session.random(ip.Ray.PixelIndex);
 
@@ -188,13 +238,14 @@ private:
 
 		// Sample Material
 		MaterialSampleInput sin(rnd);
+		sin.Sample		   = session.pathSample2D(ip.Ray.PixelIndex, bounceDimension(ip, MATERIAL_SAMPLE_DIM));
 		sin.Context		   = MaterialSampleContext::fromIP(ip);
 		sin.ShadingContext = ShadingContext::fromIP(session.threadID(), ip);
 
 		MaterialSampleOutput sout;
 		material->sample(sin, sout, session);
 
-		mCameraPath.addToken(sout.Type);
+		path.addToken(sout.Type);
 
 		const Vector3f L		   = sout.globalL(ip);
 		current.LastWasDelta	   = sout.isDelta();
@@ -230,17 +281,23 @@ private:
 	}
 
 	/// Handle simple Next Event Estimation (aka, connect point with light)
-	void handleNEE(RenderTileSession& session, const IntersectionPoint& cameraIP, const IMaterial* cameraMaterial, TraversalContext& current)
+	void handleNEE(RenderTileSession& session, const IntersectionPoint& cameraIP, const IMaterial* cameraMaterial,
+				   TraversalContext& current, LightPath& path)
 	{
 		const EntitySamplingInfo sampleInfo = { cameraIP.P, cameraIP.Surface.N };
 
 		// Sample light
+		const float lightSelection = session.pathSample1D(cameraIP.Ray.PixelIndex, bounceDimension(cameraIP, LIGHT_SAMPLE_DIM));
+		const Vector2f lightPoint  = session.pathSample2D(cameraIP.Ray.PixelIndex, bounceDimension(cameraIP, LIGHT_SAMPLE_DIM + 1));
+
 		LightSampleInput lsin(session.random(cameraIP.Ray.PixelIndex));
 		lsin.WavelengthNM	  = cameraIP.Ray.WavelengthNM;
 		lsin.Point			  = &cameraIP;
 		lsin.SamplingInfo	  = &sampleInfo;
 		lsin.SamplePosition	  = true;
 		lsin.SampleWavelength = cameraMaterial->hasFluorescence();
+		lsin.UseHierarchy	  = true;
+		lsin.Sample			  = Vector3f(lightSelection, lightPoint(0), lightPoint(1));
 		LightSampleOutput lsout;
 		const auto lsample = mLightSampler->sample(lsin, lsout, session);
 		const Light* light = lsample.first;
@@ -329,31 +386,35 @@ private:
 		const float distance = light->isInfinite() ? PR_INF : std::sqrt(sqrD);
 		Ray shadow			 = cameraIP.nextRay(L, RayFlag::Shadow, SHADOW_RAY_MIN, distance);
 		shadow.WavelengthNM	 = min.Context.FluorescentWavelengthNM;
-		const bool isVisible = worthACheck && !session.traceShadowRay(shadow, distance);
 
 		// Calculate contribution (cosine term already applied inside material)
-		const SpectralBlob contrib = isVisible ? (connectionW / lightPdfS2[0]).eval() : SpectralBlob::Zero();
+		const SpectralBlob contrib = worthACheck ? (connectionW / lightPdfS2[0]).eval() : SpectralBlob::Zero();
 
 		// Construct LPE path
-		mCameraPath.addToken(mout.Type);
+		path.addToken(mout.Type);
 
 		if (light->isInfinite()) {
-			session.tile()->statistics().add(RenderStatisticEntry::BackgroundHitCount);
-			mCameraPath.addToken(LightPathToken::Background());
+			session.tile()->localStatistics().add(RenderStatisticEntry::BackgroundHitCount);
+			path.addToken(LightPathToken::Background());
 		} else {
-			session.tile()->statistics().add(RenderStatisticEntry::EntityHitCount);
-			mCameraPath.addToken(LightPathToken::Emissive());
+			session.tile()->localStatistics().add(RenderStatisticEntry::EntityHitCount);
+			path.addToken(LightPathToken::Emissive());
 		}
 
-		session.pushSpectralFragment(mis, current.Throughput, contrib,
-									 shadow, mCameraPath);
+		// The visibility is resolved later in batches
+		if (worthACheck)
+			session.pushDeferredSpectralFragment(mis, current.Throughput, contrib,
+												 shadow, path, distance);
+		else
+			session.pushSpectralFragment(mis, current.Throughput, contrib,
+										 shadow, path);
 
-		mCameraPath.popToken(2);
+		path.popToken(2);
 	}
 
 	/// Handle case where camera ray directly hits emissive object
 	void handleDirectHit(RenderTileSession& session, const IntersectionPoint& cameraIP,
-						 const IEntity* cameraEntity, TraversalContext& current)
+						 const IEntity* cameraEntity, TraversalContext& current, LightPath& path)
 	{
 		const EntitySamplingInfo sampleInfo = { current.LastPosition, current.LastNormal };
 
@@ -384,14 +445,14 @@ private:
 
 		// If the given contribution can not be determined by NEE as well, do not calculate MIS
 		if (!mParameters.DoNEE || hitFromBehind || current.LastWasDelta) {
-			mCameraPath.addToken(LightPathToken::Emissive());
-			session.pushSpectralFragment(heroFactor / (heroFactor.sum() * current.WavelengthPDF), current.Throughput, radiance, cameraIP.Ray, mCameraPath);
-			mCameraPath.popToken();
+			path.addToken(LightPathToken::Emissive());
+			session.pushSpectralFragment(heroFactor / (heroFactor.sum() * current.WavelengthPDF), current.Throughput, radiance, cameraIP.Ray, path);
+			path.popToken();
 			return;
 		}
 
 		// Evaluate PDF
-		const float selProb = mLightSampler->pdfEntitySelection(cameraEntity);
+		const float selProb = mLightSampler->pdfEntitySelection(cameraEntity, &sampleInfo);
 		auto posPDF			= mLightSampler->pdfPosition(cameraEntity, cameraIP.P, &sampleInfo);
 		if (posPDF.IsArea)
 			posPDF.Value = IS::toSolidAngle(posPDF.Value, cameraIP.Depth2, std::abs(cosC));
@@ -406,15 +467,15 @@ private:
 		//PR_ASSERT((mis <= PR_SPECTRAL_BLOB_SIZE).all(), "MIS must be between 0 and PR_SPECTRAL_BLOB_SIZE");
 
 		// Splat
-		mCameraPath.addToken(LightPathToken::Emissive());
-		session.pushSpectralFragment(mis, current.Throughput, radiance, cameraIP.Ray, mCameraPath);
-		mCameraPath.popToken();
+		path.addToken(LightPathToken::Emissive());
+		session.pushSpectralFragment(mis, current.Throughput, radiance, cameraIP.Ray, path);
+		path.popToken();
 	}
 
 	/// Handle case where camera ray hits nothing (inf light contribution)
-	void handleInfLights(const RenderTileSession& session, TraversalContext& current, const Ray& ray) const
+	void handleInfLights(const RenderTileSession& session, TraversalContext& current, const LightPath& path, const Ray& ray) const
 	{
-		session.tile()->statistics().add(RenderStatisticEntry::BackgroundHitCount);
+		session.tile()->localStatistics().add(RenderStatisticEntry::BackgroundHitCount);
 		const SpectralBlob heroFactor = (ray.Flags & RayFlag::Monochrome) ? SpectralBlobUtils::HeroOnly() : SpectralBlob::Ones();
 
 		// Evaluate radiance
@@ -441,7 +502,7 @@ private:
 
 		// If the given contribution can not be determined by NEE as well, do not calculate MIS
 		if (!mParameters.DoNEE || current.LastWasDelta) {
-			session.pushSpectralFragment(heroFactor / (heroFactor.sum() * current.WavelengthPDF), current.Throughput, radiance, ray, mCameraPath);
+			session.pushSpectralFragment(heroFactor / (heroFactor.sum() * current.WavelengthPDF), current.Throughput, radiance, ray, path);
 			return;
 		}
 
@@ -452,24 +513,24 @@ private:
 		PR_ASSERT((mis <= PR_SPECTRAL_BLOB_SIZE).all(), "MIS must be between 0 and PR_SPECTRAL_BLOB_SIZE");
 
 		// Splat
-		session.pushSpectralFragment(mis, current.Throughput, radiance, ray, mCameraPath);
+		session.pushSpectralFragment(mis, current.Throughput, radiance, ray, path);
 	}
 
 	/// Handle case where camera ray hits nothing and there is no inf-lights
-	inline void handleZero(const RenderTileSession& session, TraversalContext& current, const Ray& ray) const
+	inline void handleZero(const RenderTileSession& session, TraversalContext& current, const LightPath& path, const Ray& ray) const
 	{
-		session.tile()->statistics().add(RenderStatisticEntry::BackgroundHitCount);
+		session.tile()->localStatistics().add(RenderStatisticEntry::BackgroundHitCount);
 		const SpectralBlob heroFactor = (ray.Flags & RayFlag::Monochrome) ? SpectralBlobUtils::HeroOnly() : SpectralBlob::Ones();
-		session.pushSpectralFragment(heroFactor / (heroFactor.sum() * current.WavelengthPDF), current.Throughput, SpectralBlob::Zero(), ray, mCameraPath);
+		session.pushSpectralFragment(heroFactor / (heroFactor.sum() * current.WavelengthPDF), current.Throughput, SpectralBlob::Zero(), ray, path);
 	}
 
 private:
 	const DiParameters mParameters;
 	const std::shared_ptr<LightSampler> mLightSampler;
 	const RussianRoulette mCameraRR;
-	const Walker mCameraWalker;
+	const LightPath mBackgroundPath;
 
-	LightPath mCameraPath;
+	PathStateContainer<PathState> mPathStates;
 };
 
 template <VCM::MISMode MISMode, bool EmissiveScatter>
@@ -190,8 +190,8 @@ public:
 		mCameraPathWalker.traverseBSDF(
 			session.random(spt.Ray.PixelIndex), session, SpectralBlob::Ones(), spt, entity, material,
 			[&](const SpectralBlob& weight, const IntersectionPoint& ip, IEntity* entity_hit, IMaterial* material_hit) {
-				session.tile()->statistics().add(RenderStatisticEntry::EntityHitCount);
-				session.tile()->statistics().add(RenderStatisticEntry::CameraDepthCount);
+				session.tile()->localStatistics().add(RenderStatisticEntry::EntityHitCount);
+				session.tile()->localStatistics().add(RenderStatisticEntry::CameraDepthCount);
 
 				// If we hit a light evaluate it and stop
 				if (entity_hit->hasEmission()
@@ -237,7 +237,7 @@ public:
 				});
 
 				if (!illuminated) {
-					session.tile()->statistics().add(RenderStatisticEntry::BackgroundHitCount);
+					session.tile()->localStatistics().add(RenderStatisticEntry::BackgroundHitCount);
 					session.pushSpectralFragment(SpectralBlob::Ones(), weight, SpectralBlob::Zero(), ray, path);
 				}
 
@@ -303,8 +303,8 @@ public:
 			mLightPathWalker.traverseBSDFSimple(
 				rnd, session, radiance, ray,
 				[&](const SpectralBlob& weight, const IntersectionPoint& ip, IEntity* entity, IMaterial* material) {
-					session.tile()->statistics().add(RenderStatisticEntry::EntityHitCount);
-					session.tile()->statistics().add(RenderStatisticEntry::LightDepthCount);
+					session.tile()->localStatistics().add(RenderStatisticEntry::EntityHitCount);
+					session.tile()->localStatistics().add(RenderStatisticEntry::LightDepthCount);
 
 					if (entity->hasEmission()) // Stop at lights and do not save photons
 						return false;
@@ -438,10 +438,12 @@ private:
 		assignTiles(renderer, lights);
 		LightMap().swap(lights); // Delete
 
-		// Make sure the photon map is always cleared before photon pass
+		// Make sure the photon map is always cleared before photon pass and sorted before the accumulation pass
 		renderer->addIterationCallback([this](const RenderIteration& iter) {
 			if (iter.Pass == 0)
 				beforePhotonPass(iter.Iteration);
+			else
+				mContext->Map.build();
 		});
 		// TODO: What if the integrator context gets destroyed?
 	}
@@ -74,6 +74,7 @@ public:
 				else
 					handleShadingGroup(session, sg);
 			}
+			session.resolveShadowRays();
 		}
 	}
 
@@ -109,7 +109,7 @@ public:
 	{
 		LightPath stdPath = LightPath::createCDL(1);
 		Random random(42);
-		session.tile()->statistics().add(RenderStatisticEntry::EntityHitCount, grp.size());
+		session.tile()->localStatistics().add(RenderStatisticEntry::EntityHitCount, grp.size());
 		for (size_t i = 0; i < grp.size(); ++i) {
 			IntersectionPoint spt;
 			grp.computeShadingPoint(i, spt);
@@ -240,9 +240,9 @@ public:
 			session.pipeline()->runPipeline();
 			while (session.pipeline()->hasShadingGroup()) {
 				auto sg = session.pipeline()->popShadingGroup(session);
-				session.tile()->statistics().add(RenderStatisticEntry::CameraDepthCount, sg.size());
+				session.tile()->localStatistics().add(RenderStatisticEntry::CameraDepthCount, sg.size());
 				if (sg.isBackground())
-					session.tile()->statistics().add(RenderStatisticEntry::BackgroundHitCount, sg.size());
+					session.tile()->localStatistics().add(RenderStatisticEntry::BackgroundHitCount, sg.size());
 				else
 					handleShadingGroup(session, sg);
 			}
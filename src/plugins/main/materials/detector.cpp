@@ -65,7 +65,7 @@ public:
 	{
 		PR_PROFILE_THIS;
 
-		out.L = Sampling::cos_hemi(in.RND.getFloat(), in.RND.getFloat());
+		out.L = Sampling::cos_hemi(in.sample2D());
 		out.L = in.Context.V.makeSameHemisphere(out.L);
 
 		if constexpr (HasTransmission) {
@@ -84,7 +84,7 @@ public:
 			}
 		}
 
-		out.L = Sampling::cos_hemi(in.RND.getFloat(), in.RND.getFloat());
+		out.L = Sampling::cos_hemi(in.sample2D());
 
 		out.IntegralWeight = mAlbedo->eval(in.ShadingContext);
 
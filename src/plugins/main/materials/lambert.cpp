@@ -62,7 +62,7 @@ public:
 			}
 		}
 
-		out.L = Sampling::cos_hemi(in.RND.getFloat(), in.RND.getFloat());
+		out.L = Sampling::cos_hemi(in.sample2D());
 
 		out.IntegralWeight = mAlbedo->eval(in.ShadingContext);
 		out.PDF_S  = Sampling::cos_hemi_pdf(out.L(2));
@@ -71,7 +71,7 @@ public:
 	{
 		PR_PROFILE_THIS;
 
-		out.L = Sampling::cos_hemi(in.RND.getFloat(), in.RND.getFloat());
+		out.L = Sampling::cos_hemi(in.sample2D());
 
 		float NdotL		   = std::max(0.0f, out.L(2));
 		out.IntegralWeight = calc(out.L, NdotL, in.Context, in.ShadingContext);
@@ -85,7 +85,7 @@ public:
 		PR_PROFILE_THIS;
 
 		const auto closure = MicrofacetReflection(roughness(in.ShadingContext));
-		out.L			   = closure.sample(in.RND.get2D(), in.Context.V);
+		out.L			   = closure.sample(in.sample2D(), in.Context.V);
 
 		// Set flags
 		out.Flags = mNodeContribFlags;
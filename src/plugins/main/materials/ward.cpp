@@ -101,7 +101,7 @@ public:
 
 	void sampleDiffusePath(const MaterialSampleInput& in, const ShadingContext& sctx, MaterialSampleOutput& out) const
 	{
-		out.L			   = Sampling::cos_hemi(in.RND.getFloat(), in.RND.getFloat());
+		out.L			   = Sampling::cos_hemi(in.sample2D());
 		out.PDF_S		   = Sampling::cos_hemi_pdf(out.L(2));
 		out.IntegralWeight = mAlbedo->eval(sctx);
 		out.Type		   = MaterialScatteringType::DiffuseReflection;
@@ -47,6 +47,9 @@ public:
 
 	virtual ~HaltonSampler() = default;
 
+	using ISampler::generate1D;
+	using ISampler::generate2D;
+
 	float generate1D(Random&, uint32 index) override
 	{
 		if (index < maxSamples())
@@ -94,6 +97,9 @@ public:
 
 	virtual ~HammersleySampler() = default;
 
+	using ISampler::generate1D;
+	using ISampler::generate2D;
+
 	float generate1D(Random&, uint32 index) override
 	{
 		if (index < maxSamples())
@@ -103,6 +103,9 @@ public:
 	{
 	}
 
+	using ISampler::generate1D;
+	using ISampler::generate2D;
+
 	float generate1D(Random& rnd, uint32 index) override
 	{
 #ifndef PR_MJS_USE_RANDOM
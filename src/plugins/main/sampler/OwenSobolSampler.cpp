@@ -0,0 +1,154 @@
+#include "SceneLoadContext.h"
+#include "math/Hash.h"
+#include "sampler/ISampler.h"
+#include "sampler/ISamplerFactory.h"
+#include "sampler/ISamplerPlugin.h"
+
+namespace PR {
+constexpr uint32 DEF_SAMPLE_COUNT = 128;
+
+static inline uint32 reverseBits(uint32 v)
+{
+	v = ((v >> 1) & 0x55555555) | ((v & 0x55555555) << 1);
+	v = ((v >> 2) & 0x33333333) | ((v & 0x33333333) << 2);
+	v = ((v >> 4) & 0x0F0F0F0F) | ((v & 0x0F0F0F0F) << 4);
+	v = ((v >> 8) & 0x00FF00FF) | ((v & 0x00FF00FF) << 8);
+	return (v >> 16) | (v << 16);
+}
+
+// Hash based permutation where each bit only depends on itself and lower bits
+static inline uint32 laineKarrasPermutation(uint32 v, uint32 seed)
+{
+	v += seed;
+	v ^= v * 0x6c50b47c;
+	v ^= v * 0xb82f1e52;
+	v ^= v * 0xc7afe638;
+	v ^= v * 0x8d22f6e6;
+	return v;
+}
+
+// Owen scrambling, as each bit only depends on itself and the more significant bits
+static inline uint32 nestedUniformScramble(uint32 v, uint32 seed)
+{
+	return reverseBits(laineKarrasPermutation(reverseBits(v), seed));
+}
+
+// First dimension of the sobol sequence (van der Corput)
+static inline uint32 sobol0(uint32 index)
+{
+	return reverseBits(index);
+}
+
+// Second dimension of the sobol sequence. The generator matrix is the pascal matrix
+static inline uint32 sobol1(uint32 index)
+{
+	uint32 r = 0;
+	for (uint32 v = 1u << 31; index; index >>= 1, v ^= v >> 1) {
+		if (index & 1)
+			r ^= v;
+	}
+	return r;
+}
+
+/*
+	Padded Owen scrambled sobol sequence generated on the fly for arbitrary dimensions.
+	Each (pair of) dimension(s) uses the first two sobol dimensions with an own shuffled index and scramble.
+	Based on:
+	Burley, B. (2020). Practical Hash-based Owen Scrambling. Journal of Computer Graphics Techniques, 9(4), 1-20.
+*/
+class OwenSobolSampler : public ISampler {
+public:
+	OwenSobolSampler(Random& random, uint32 samples)
+		: ISampler(samples)
+		, mSeed(random.get64())
+	{
+	}
+
+	virtual ~OwenSobolSampler() = default;
+
+	bool supportsDimensions() const override { return true; }
+
+	float generate1D(Random& rnd, uint32 index) override
+	{
+		return generate1D(rnd, index, 0);
+	}
+
+	Vector2f generate2D(Random& rnd, uint32 index) override
+	{
+		return generate2D(rnd, index, 0);
+	}
+
+	float generate1D(Random&, uint32 index, uint32 dimension) override
+	{
+		const uint32 seed  = dimensionSeed(dimension);
+		const uint32 shuff = nestedUniformScramble(index, seed);
+
+		return Random::uint32ToFloat(nestedUniformScramble(sobol0(shuff), static_cast<uint32>(hash_mix(seed))));
+	}
+
+	Vector2f generate2D(Random&, uint32 index, uint32 dimension) override
+	{
+		const uint32 seed  = dimensionSeed(dimension);
+		const uint32 shuff = nestedUniformScramble(index, seed);
+		const uint64 dseed = hash_mix(seed);
+
+		return Vector2f(Random::uint32ToFloat(nestedUniformScramble(sobol0(shuff), static_cast<uint32>(dseed))),
+						Random::uint32ToFloat(nestedUniformScramble(sobol1(shuff), static_cast<uint32>(dseed >> 32))));
+	}
+
+private:
+	inline uint32 dimensionSeed(uint32 dimension) const
+	{
+		return static_cast<uint32>(hash_mix(mSeed ^ hash_mix(sequenceSeed() ^ hash_mix(dimension))));
+	}
+
+	const uint64 mSeed;
+};
+
+class OwenSobolSamplerFactory : public ISamplerFactory {
+public:
+	explicit OwenSobolSamplerFactory(const ParameterGroup& params)
+		: mParams(params)
+	{
+	}
+
+	uint32 requestedSampleCount() const override
+	{
+		return mParams.getUInt("sample_count", DEF_SAMPLE_COUNT);
+	}
+
+	std::shared_ptr<ISampler> createInstance(uint32 sample_count, Random& rnd) const override
+	{
+		return std::make_shared<OwenSobolSampler>(rnd, sample_count);
+	}
+
+private:
+	ParameterGroup mParams;
+};
+
+class OwenSobolSamplerPlugin : public ISamplerPlugin {
+public:
+	std::shared_ptr<ISamplerFactory> create(const std::string&, const SceneLoadContext& ctx) override
+	{
+		return std::make_shared<OwenSobolSamplerFactory>(ctx.parameters());
+	}
+
+	const std::vector<std::string>& getNames() const override
+	{
+		const static std::vector<std::string> names({ "owen_sobol", "padded_sobol" });
+		return names;
+	}
+
+	PluginSpecification specification(const std::string&) const override
+	{
+		return PluginSpecificationBuilder("Owen Sobol Sampler", "A progressive quasi-random sampler generating owen scrambled sobol points for arbitrary dimensions on the fly")
+			.Identifiers(getNames())
+			.Inputs()
+			.UInt("sample_count", "Sample count requested", DEF_SAMPLE_COUNT)
+			.Specification()
+			.get();
+	}
+};
+} // namespace PR
+
+PR_PLUGIN_INIT(PR::OwenSobolSamplerPlugin, _PR_PLUGIN_NAME, PR_PLUGIN_VERSION)
@@ -17,6 +17,9 @@ public:
 
 	virtual ~RandomSampler() = default;
 
+	using ISampler::generate1D;
+	using ISampler::generate2D;
+
 	inline float generate1D(Random& rnd, uint32) override { return rnd.getFloat(); }
 	inline Vector2f generate2D(Random& rnd, uint32) override { return rnd.get2D(); }
 };
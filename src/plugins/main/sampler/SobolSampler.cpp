@@ -56,6 +56,9 @@ public:
 
 	virtual ~SobolSampler() = default;
 
+	using ISampler::generate1D;
+	using ISampler::generate2D;
+
 	float generate1D(Random& rnd, uint32 index) override
 	{
 		if (mSamples1D.size() <= index)
@@ -20,6 +20,9 @@ public:
 
 	virtual ~StratifiedSampler() = default;
 
+	using ISampler::generate1D;
+	using ISampler::generate2D;
+
 	float generate1D(Random& rnd, uint32 index) override
 	{
 		auto ret = Projection::stratified(rnd.getFloat(), index, mGroups);
@@ -18,6 +18,9 @@ public:
 
 	virtual ~UniformSampler() = default;
 
+	using ISampler::generate1D;
+	using ISampler::generate2D;
+
 	float generate1D(Random&, uint32) override
 	{
 		return 0.5f;
@@ -78,6 +78,7 @@ void setup_output(py::module& m)
 
 	py::enum_<AOVCounter>(m, "AOVCounter")
 		.value("FEEDBACK", AOV_Feedback)
-		.value("SAMPLES", AOV_SampleCount);
+		.value("SAMPLES", AOV_SampleCount)
+		.value("PIXEL_SAMPLES", AOV_PixelSampleCount);
 }
 } // namespace PRPY
\ No newline at end of file
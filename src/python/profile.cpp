@@ -9,14 +9,15 @@ void setup_profiler(py::module& m)
 {
 	auto sm = m.def_submodule("Profiler");
 	sm.def("start",
-		   [](int samples) {
+		   [](int samples, int networkPort) {
 #ifdef PR_WITH_PROFILER
-			   Profiler::start(samples);
+			   Profiler::start(samples, networkPort);
 #else
 			   (void)samples;
+			   (void)networkPort;
 #endif
 		   },
-		   py::arg("samplesPerSecond") = 10);
+		   py::arg("samplesPerSecond") = 10, py::arg("networkPort") = -1);
 
 	sm.def("stop",
 		   []() {
@@ -31,6 +32,15 @@ void setup_profiler(py::module& m)
 			   Profiler::dumpToFile(filename);
 #else
 			   (void)filename;
+#endif
+		   });
+
+	sm.def("dumpToChromeTrace",
+		   [](const std::wstring& filename) {
+#ifdef PR_WITH_PROFILER
+			   Profiler::dumpToChromeTrace(filename);
+#else
+			   (void)filename;
 #endif
 		   });
 }
@@ -16,14 +16,33 @@ public:
 	{
 		PYBIND11_OVERLOAD_PURE(Vector2f, ISampler, generate2D, rnd, index);
 	}
+
+	inline float generate1D(Random& rnd, uint32 index, uint32 dimension) override
+	{
+		PYBIND11_OVERLOAD(float, ISampler, generate1D, rnd, index, dimension);
+	}
+
+	inline Vector2f generate2D(Random& rnd, uint32 index, uint32 dimension) override
+	{
+		PYBIND11_OVERLOAD(Vector2f, ISampler, generate2D, rnd, index, dimension);
+	}
+
+	inline bool supportsDimensions() const override
+	{
+		PYBIND11_OVERLOAD(bool, ISampler, supportsDimensions);
+	}
 };
 
 PR_NO_SANITIZE_ADDRESS
 void setup_sampler(py::module& m)
 {
 	py::class_<ISampler, SamplerWrap>(m, "ISampler")
-		.def("generate1D", &ISampler::generate1D)
-		.def("generate2D", &ISampler::generate2D);
+		.def("generate1D", py::overload_cast<Random&, uint32>(&ISampler::generate1D))
+		.def("generate1D", py::overload_cast<Random&, uint32, uint32>(&ISampler::generate1D))
+		.def("generate2D", py::overload_cast<Random&, uint32>(&ISampler::generate2D))
+		.def("generate2D", py::overload_cast<Random&, uint32, uint32>(&ISampler::generate2D))
+		.def("supportsDimensions", &ISampler::supportsDimensions)
+		.def_property("sequenceSeed", &ISampler::sequenceSeed, &ISampler::setSequenceSeed);
 
 	py::class_<Random>(m, "Random")
 		.def(py::init<uint64>())
@@ -18,10 +18,19 @@ void setup_settings(py::module& m)
 		.def_readwrite("cropMaxY", &RenderSettings::cropMaxY)
 		.def_readwrite("cropMinY", &RenderSettings::cropMinY)
 		.def_readwrite("tileMode", &RenderSettings::tileMode)
+		.def_readwrite("asyncIterations", &RenderSettings::asyncIterations)
+		.def_readwrite("adaptiveSampling", &RenderSettings::adaptiveSampling)
+		.def_readwrite("adaptiveErrorThreshold", &RenderSettings::adaptiveErrorThreshold)
+		.def_readwrite("adaptiveMinSampleCount", &RenderSettings::adaptiveMinSampleCount)
 		.def_readwrite("maxParallelRays", &RenderSettings::maxParallelRays)
+		.def_readwrite("pixelRandomMode", &RenderSettings::pixelRandomMode)
 		.def_readwrite("progressive", &RenderSettings::progressive)
 		.def_readwrite("seed", &RenderSettings::seed)
 		.def_readwrite("sortHits", &RenderSettings::sortHits)
+		.def_property(
+			"hitSortKeys", [](const RenderSettings& s) { return (uint32)s.hitSortKeys; },
+			[](RenderSettings& s, uint32 keys) { s.hitSortKeys = keys; })
+		.def_readwrite("reorderRays", &RenderSettings::reorderRays)
 		.def_readwrite("spectralHero", &RenderSettings::spectralHero)
 		.def_readwrite("spectralMono", &RenderSettings::spectralMono)
 		.def_readwrite("spectralStart", &RenderSettings::spectralStart)
@@ -37,5 +46,14 @@ void setup_settings(py::module& m)
 		.value("CENTER", TimeMappingMode::Center)
 		.value("LEFT", TimeMappingMode::Left)
 		.value("RIGHT", TimeMappingMode::Right);
+
+	py::enum_<HitSortKey>(m, "HitSortKey", py::arithmetic())
+		.value("MATERIAL", HitSortKey::Material)
+		.value("DIRECTION", HitSortKey::Direction)
+		.value("PRIMITIVE", HitSortKey::Primitive);
+
+	py::enum_<PixelRandomMode>(m, "PixelRandomMode")
+		.value("MAP", PixelRandomMode::Map)
+		.value("HASH", PixelRandomMode::Hash);
 }
 } // namespace PRPY
\ No newline at end of file
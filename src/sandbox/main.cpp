@@ -112,6 +112,9 @@ int main(int argc, char** argv)
 		const sf::path profJSONFile = "pr_profile.json";
 		if (!Profiler::dumpToJSON(profJSONFile.generic_wstring()))
 			PR_LOG(L_ERROR) << "Could not write profile data to " << profJSONFile << std::endl;
+		const sf::path traceFile = "pr_profile_trace.json";
+		if (!Profiler::dumpToChromeTrace(traceFile.generic_wstring()))
+			PR_LOG(L_ERROR) << "Could not write profile timeline to " << traceFile << std::endl;
 	}
 
 	return 0;
@@ -24,6 +24,29 @@ PR_TEST("snorm16")
 	PR_CHECK_NEARLY_EQ(r, f);
 }
 
+PR_TEST("half")
+{
+	const float values[] = { 0.0f, 1.0f, -2.5f, 0.125f, 65504.0f, 6.1035156e-05f };
+	for (float f : values)
+		PR_CHECK_NEARLY_EQ(from_half(to_half(f)), f);
+
+	PR_CHECK_NEARLY_EQ_EPS(from_half(to_half(0.1f)), 0.1f, 1e-4f);
+}
+
+PR_TEST("half subnormal")
+{
+	const float f = 5.9604645e-08f; // Smallest subnormal half
+	PR_CHECK_EQ(to_half(f), 0x0001);
+	PR_CHECK_EQ(from_half(to_half(f)), f);
+}
+
+PR_TEST("half special")
+{
+	PR_CHECK_EQ(to_half(1e6f), 0x7C00);
+	PR_CHECK_EQ(to_half(-std::numeric_limits<float>::infinity()), 0xFC00);
+	PR_CHECK_TRUE(std::isnan(from_half(to_half(std::numeric_limits<float>::quiet_NaN()))));
+}
+
 PR_TEST("oct 1")
 {
 	Vector3f d(1, 0, 0);
@@ -0,0 +1,77 @@
+#include "renderer/ConvergenceMap.h"
+#include "Test.h"
+
+using namespace PR;
+
+PR_BEGIN_TESTCASE(ConvergenceMap)
+PR_TEST("Relative Error")
+{
+	PR_CHECK_NEARLY_EQ(ConvergenceMap::relativeError(1, 0, 16), 0);
+	PR_CHECK_LESS(ConvergenceMap::relativeError(1, 1, 64), ConvergenceMap::relativeError(1, 1, 16));
+	PR_CHECK_LESS(ConvergenceMap::relativeError(2, 1, 16), ConvergenceMap::relativeError(1, 1, 16));
+}
+PR_TEST("Minimum Samples")
+{
+	ConvergenceMap map(Size2i(16, 16), 0.1f, 4);
+	for (Size1i y = 0; y < 16; ++y)
+		for (Size1i x = 0; x < 16; ++x)
+			map.setError(Point2i(x, y), 0.0f);
+	map.update(2);
+
+	PR_CHECK_EQ(map.convergedBlockCount(), 0);
+	PR_CHECK_FALSE(map.isConverged(Point2i(0, 0)));
+}
+PR_TEST("Freeze Blocks")
+{
+	ConvergenceMap map(Size2i(16, 16), 0.1f, 1);
+	for (Size1i y = 0; y < 16; ++y)
+		for (Size1i x = 0; x < 16; ++x)
+			map.setError(Point2i(x, y), x < 8 ? 0.01f : 0.5f);
+	map.update(4);
+
+	PR_CHECK_EQ(map.blockCount(), 4);
+	PR_CHECK_EQ(map.convergedBlockCount(), 2);
+	PR_CHECK_TRUE(map.isConverged(Point2i(3, 12)));
+	PR_CHECK_FALSE(map.isConverged(Point2i(12, 3)));
+	PR_CHECK_EQ(map.sampleCount(Point2i(3, 12), 10), 4);
+	PR_CHECK_EQ(map.sampleCount(Point2i(12, 3), 10), 10);
+}
+PR_TEST("Filter Apron")
+{
+	ConvergenceMap map(Size2i(16, 16), 0.1f, 1);
+	map.requestApron(2);
+	for (Size1i y = 0; y < 16; ++y)
+		for (Size1i x = 0; x < 16; ++x)
+			map.setError(Point2i(x, y), x < 8 ? 0.01f : 0.5f);
+	map.update(4);
+
+	PR_CHECK_TRUE(map.isConverged(Point2i(6, 3)));
+	PR_CHECK_TRUE(map.needsSamples(Point2i(6, 3)));
+	PR_CHECK_FALSE(map.needsSamples(Point2i(5, 3)));
+	PR_CHECK_TRUE(map.needsSamples(Point2i(12, 3)));
+}
+PR_TEST("No Estimate")
+{
+	ConvergenceMap map(Size2i(16, 16), 0.1f, 1);
+	map.setError(Point2i(0, 0), 0.0f);
+	map.update(4);
+
+	PR_CHECK_EQ(map.convergedBlockCount(), 1);
+	PR_CHECK_FALSE(map.isConverged(Point2i(8, 8)));
+}
+PR_TEST("Reset")
+{
+	ConvergenceMap map(Size2i(16, 16), 0.1f, 1);
+	map.setError(Point2i(0, 0), 0.0f);
+	map.update(4);
+	map.reset();
+
+	PR_CHECK_EQ(map.convergedBlockCount(), 0);
+	PR_CHECK_FALSE(map.isConverged(Point2i(0, 0)));
+}
+PR_END_TESTCASE()
+
+// MAIN
+PRT_BEGIN_MAIN
+PRT_TESTCASE(ConvergenceMap);
+PRT_END_MAIN
@@ -1,5 +1,7 @@
 #include "path/LightPath.h"
 #include "path/LightPathExpression.h"
+#include "path/LightPathExpressionSet.h"
+#include "path/LightPathManager.h"
 #include "path/LightPathView.h"
 
 #include "Test.h"
@@ -232,6 +234,120 @@ PR_TEST("Packed")
 
 	delete[] buffer;
 }
+PR_TEST("Set [CD*L|CSE|C(DS)+D?E]")
+{
+	LightPathExpressionSet set;
+	set.add(LightPathExpression("CD*L"));
+	set.add(LightPathExpression("RD*L")); // Invalid
+	set.add(LightPathExpression("CSE"));
+	const size_t lastID = set.add(LightPathExpression("C(DS)+D?E"));
+	PR_CHECK_EQ(lastID, 3);
+	PR_CHECK_EQ(set.size(), 4);
+
+	LightPath path; // CDE
+	path.addToken(LightPathToken::Camera());
+	path.addToken(LightPathToken(ScatteringType::Reflection, ScatteringEvent::Diffuse));
+	path.addToken(LightPathToken(ScatteringType::Emissive, ScatteringEvent::Diffuse));
+	PR_CHECK_EQ(set.match(path), 0x1ULL);
+
+	LightPath path2; // CSE
+	path2.addToken(LightPathToken::Camera());
+	path2.addToken(LightPathToken(ScatteringType::Reflection, ScatteringEvent::Specular));
+	path2.addToken(LightPathToken(ScatteringType::Emissive, ScatteringEvent::Diffuse));
+	PR_CHECK_EQ(set.match(path2), 0x4ULL);
+
+	LightPath path3; // CDSE
+	path3.addToken(LightPathToken::Camera());
+	path3.addToken(LightPathToken(ScatteringType::Reflection, ScatteringEvent::Diffuse));
+	path3.addToken(LightPathToken(ScatteringType::Refraction, ScatteringEvent::Specular));
+	path3.addToken(LightPathToken(ScatteringType::Emissive, ScatteringEvent::Diffuse));
+	PR_CHECK_EQ(set.match(path3), 0x8ULL);
+}
+
+PR_TEST("Set Product [CD*L|CSE|C(DS)+D?E]")
+{
+	LightPathExpressionSet set;
+	set.add(LightPathExpression("CD*L"));
+	set.add(LightPathExpression("RD*L")); // Invalid
+	set.add(LightPathExpression("CSE"));
+	set.add(LightPathExpression("C(DS)+D?E"));
+	const bool built = set.build();
+	PR_CHECK_TRUE(built);
+	PR_CHECK_TRUE(set.isBuilt());
+
+	LightPath path; // CDSE
+	path.addToken(LightPathToken::Camera());
+	path.addToken(LightPathToken(ScatteringType::Reflection, ScatteringEvent::Diffuse));
+	path.addToken(LightPathToken(ScatteringType::Refraction, ScatteringEvent::Specular));
+	path.addToken(LightPathToken(ScatteringType::Emissive, ScatteringEvent::Diffuse));
+	PR_CHECK_EQ(set.match(path), 0x8ULL);
+
+	// Stepwise
+	uint32 state = set.startingState();
+	for (size_t i = 0; i < path.currentSize(); ++i)
+		state = set.nextState(state, path.token(i));
+	PR_CHECK_EQ(set.stateMask(state), 0x8ULL);
+}
+
+PR_TEST("Tracked Path")
+{
+	std::vector<LightPathExpressionSet> sets(2);
+	sets[0].add(LightPathExpression("CD*L"));
+	sets[0].add(LightPathExpression("CSE"));
+	sets[1].add(LightPathExpression("CD+E"));
+	sets[0].build();
+	sets[1].build();
+
+	LightPath path;
+	path.trackExpressionStates(&sets);
+	path.addToken(LightPathToken::Camera());
+	path.addToken(LightPathToken(ScatteringType::Reflection, ScatteringEvent::Diffuse));
+	path.addToken(LightPathToken(ScatteringType::Emissive, ScatteringEvent::Diffuse));
+	PR_CHECK_EQ(sets[0].stateMask(path.expressionState(0)), 0x1ULL);
+	PR_CHECK_EQ(sets[1].stateMask(path.expressionState(1)), 0x1ULL);
+
+	// Popping restores the previous states
+	path.popToken(2);
+	path.addToken(LightPathToken(ScatteringType::Reflection, ScatteringEvent::Specular));
+	path.addToken(LightPathToken(ScatteringType::Emissive, ScatteringEvent::Diffuse));
+	PR_CHECK_EQ(sets[0].stateMask(path.expressionState(0)), 0x2ULL);
+	PR_CHECK_EQ(sets[1].stateMask(path.expressionState(1)), 0x0ULL);
+}
+
+PR_TEST("Labels [C<RD\"red\">E|C<RD\"blue\">E|CDE]")
+{
+	const uint16 red   = (uint16)LightPathManager::getLabelIndex("red");
+	const uint16 blue  = (uint16)LightPathManager::getLabelIndex("Blue");
+	const uint16 green = (uint16)LightPathManager::getLabelIndex("green");
+	PR_CHECK_NOT_EQ(red, 0);
+	PR_CHECK_NOT_EQ(red, blue);
+
+	LightPathExpressionSet set;
+	set.add(LightPathExpression("C<RD\"red\">E"));
+	set.add(LightPathExpression("C<RD\"blue\">E"));
+	set.add(LightPathExpression("CDE"));
+
+	const auto pathWith = [](uint16 label) {
+		LightPath path;
+		path.addToken(LightPathToken::Camera());
+		path.addToken(LightPathToken(ScatteringType::Reflection, ScatteringEvent::Diffuse, label));
+		path.addToken(LightPathToken(ScatteringType::Emissive, ScatteringEvent::Diffuse));
+		return path;
+	};
+
+	// Unlabeled patterns also accept labeled tokens
+	PR_CHECK_EQ(set.match(pathWith(red)), 0x5ULL);
+	PR_CHECK_EQ(set.match(pathWith(blue)), 0x6ULL);
+	PR_CHECK_EQ(set.match(pathWith(green)), 0x4ULL);
+	PR_CHECK_EQ(set.match(pathWith(0)), 0x4ULL);
+
+	// Product automaton has to agree
+	PR_CHECK_TRUE(set.build());
+	PR_CHECK_EQ(set.match(pathWith(red)), 0x5ULL);
+	PR_CHECK_EQ(set.match(pathWith(blue)), 0x6ULL);
+	PR_CHECK_EQ(set.match(pathWith(green)), 0x4ULL);
+	PR_CHECK_EQ(set.match(pathWith(0)), 0x4ULL);
+}
 
 PR_END_TESTCASE()
 
@@ -0,0 +1,103 @@
+#include "archives/CachedSubGraphLoader.h"
+#include "mesh/MeshBase.h"
+
+#include "Test.h"
+
+#include <fstream>
+
+using namespace PR;
+
+static std::filesystem::path setupDirectory()
+{
+	const std::filesystem::path dir = std::filesystem::temp_directory_path() / "pr_test_meshcache";
+	std::filesystem::remove_all(dir);
+	std::filesystem::create_directories(dir);
+
+	std::ofstream source(dir / "source.obj");
+	source << "v 0 0 0\nv 1 0 0\nv 0 1 0\nf 1 2 3\n";
+	return dir;
+}
+
+static std::shared_ptr<MeshBase> createTriangle()
+{
+	auto mesh = std::make_shared<MeshBase>();
+	mesh->setVertexComponent(MeshComponent::Vertex, std::vector<float>{ 0, 0, 0, 1, 0, 0, 0, 1, 0 });
+	mesh->setVertexComponentIndices(MeshComponent::Vertex, std::vector<uint32>{ 0, 1, 2 });
+	mesh->assumeTriangular(1);
+	return mesh;
+}
+
+PR_BEGIN_TESTCASE(MeshCache)
+PR_TEST("Write and Read")
+{
+	const auto dir = setupDirectory();
+
+	CachedSubGraphLoader::MeshList meshes;
+	meshes.emplace_back("triangle", createTriangle());
+	PR_CHECK_TRUE(CachedSubGraphLoader::writeCache(dir / "cache.prmc", dir / "source.obj", "key", meshes));
+
+	CachedSubGraphLoader::MeshList cached;
+	PR_CHECK_TRUE(CachedSubGraphLoader::readCache(dir / "cache.prmc", dir / "source.obj", "key", cached));
+	PR_CHECK_EQ(cached.size(), 1);
+	if (cached.size() == 1) {
+		PR_CHECK_EQ(cached[0].first, "triangle");
+		PR_CHECK_TRUE(cached[0].second->isValid());
+		PR_CHECK_EQ(cached[0].second->triangleCount(), 1);
+		PR_CHECK_EQ(cached[0].second->nodeCount(), 3);
+		PR_CHECK_TRUE(cached[0].second->vertexComponent(MeshComponent::Vertex) == meshes[0].second->vertexComponent(MeshComponent::Vertex));
+	}
+}
+PR_TEST("Changed Key")
+{
+	const auto dir = setupDirectory();
+
+	CachedSubGraphLoader::MeshList meshes;
+	meshes.emplace_back("triangle", createTriangle());
+	PR_CHECK_TRUE(CachedSubGraphLoader::writeCache(dir / "cache.prmc", dir / "source.obj", "key", meshes));
+
+	CachedSubGraphLoader::MeshList cached;
+	PR_CHECK_FALSE(CachedSubGraphLoader::readCache(dir / "cache.prmc", dir / "source.obj", "other", cached));
+}
+PR_TEST("Truncated")
+{
+	const auto dir = setupDirectory();
+
+	CachedSubGraphLoader::MeshList meshes;
+	meshes.emplace_back("triangle", createTriangle());
+	PR_CHECK_TRUE(CachedSubGraphLoader::writeCache(dir / "cache.prmc", dir / "source.obj", "key", meshes));
+
+	// Cut inside of the mesh data and inside of the header
+	const uintmax_t size = std::filesystem::file_size(dir / "cache.prmc");
+	for (uintmax_t cut : { size - 8, uintmax_t(10) }) {
+		std::filesystem::resize_file(dir / "cache.prmc", cut);
+
+		CachedSubGraphLoader::MeshList cached;
+		PR_CHECK_FALSE(CachedSubGraphLoader::readCache(dir / "cache.prmc", dir / "source.obj", "key", cached));
+		PR_CHECK_TRUE(cached.empty());
+	}
+}
+PR_TEST("Corrupted Length")
+{
+	const auto dir = setupDirectory();
+
+	CachedSubGraphLoader::MeshList meshes;
+	meshes.emplace_back("triangle", createTriangle());
+	PR_CHECK_TRUE(CachedSubGraphLoader::writeCache(dir / "cache.prmc", dir / "source.obj", "key", meshes));
+
+	// Replace the length prefix of the last vector with garbage
+	{
+		std::fstream file(dir / "cache.prmc", std::ios::in | std::ios::out | std::ios::binary);
+		file.seekp(-8, std::ios::end);
+		const uint64 garbage = 0xFFFFFFFFFFFFULL;
+		file.write(reinterpret_cast<const char*>(&garbage), sizeof(garbage));
+	}
+
+	CachedSubGraphLoader::MeshList cached;
+	PR_CHECK_FALSE(CachedSubGraphLoader::readCache(dir / "cache.prmc", dir / "source.obj", "key", cached));
+}
+PR_END_TESTCASE()
+
+// MAIN
+PRT_BEGIN_MAIN
+PRT_TESTCASE(MeshCache);
+PRT_END_MAIN
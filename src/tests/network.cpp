@@ -1,5 +1,7 @@
 #include "Test.h"
+#include "network/Protocol.h"
 #include "network/Socket.h"
+#include "serialization/MemorySerializer.h"
 
 #include <thread>
 
@@ -66,6 +68,50 @@ PR_TEST("Client-Server")
 	PR_CHECK_TRUE(ServerGood);
 	PR_CHECK_TRUE(ClientGood);
 }
+PR_TEST("Image Update Tile")
+{
+	constexpr uint32 W = 8;
+	constexpr uint32 H = 4;
+	std::vector<float> image(W * H * 3);
+	for (size_t i = 0; i < image.size(); ++i)
+		image[i] = i * 0.25f;
+
+	const ProtocolImageEncoding encodings[] = { ProtocolImageEncoding::Float32, ProtocolImageEncoding::Float16, ProtocolImageEncoding::Quantized16 };
+	for (auto encoding : encodings) {
+		std::vector<uint8> buffer(4096);
+		ProtocolImageUpdate update{ W, H, encoding, 42, 1 };
+		ProtocolImageTile tile{ 2, 1, 4, 2 };
+
+		MemorySerializer out(buffer.data(), buffer.size(), false);
+		PR_CHECK_TRUE(Protocol::writeImageUpdateHeader(out, update));
+		PR_CHECK_TRUE(Protocol::writeImageTile(out, update, tile, image.data(), image.size()));
+
+		ProtocolImageUpdate inUpdate;
+		std::vector<float> mirror(W * H * 3, -1.0f);
+		MemorySerializer in(buffer.data(), buffer.size(), true);
+		PR_CHECK_TRUE(Protocol::readImageUpdateHeader(in, inUpdate));
+		PR_CHECK_EQ(inUpdate.Stamp, 42);
+		PR_CHECK_TRUE(Protocol::readImageTile(in, inUpdate, mirror.data(), mirror.size()));
+
+		// Only the tile is touched
+		PR_CHECK_EQ(mirror[0], -1.0f);
+		for (uint32 y = 0; y < tile.Height; ++y)
+			for (uint32 x = 0; x < tile.Width * 3; ++x) {
+				const size_t i = (tile.Y + y) * W * 3 + tile.X * 3 + x;
+				PR_CHECK_NEARLY_EQ_EPS(mirror[i], image[i], 0.05f);
+			}
+	}
+}
+PR_TEST("Image Update Tile Outside")
+{
+	std::vector<float> image(4 * 4 * 3);
+	std::vector<uint8> buffer(4096);
+	ProtocolImageUpdate update{ 4, 4, ProtocolImageEncoding::Float32, 1, 1 };
+	ProtocolImageTile tile{ 2, 2, 4, 2 };
+
+	MemorySerializer out(buffer.data(), buffer.size(), false);
+	PR_CHECK_FALSE(Protocol::writeImageTile(out, update, tile, image.data(), image.size()));
+}
 PR_END_TESTCASE()
 
 // MAIN
@@ -45,6 +45,7 @@ PR_TEST("Search")
 		pht.Position[2] = random.getFloat();
 		map.store(pht);
 	}
+	map.build();
 
 	Photon::PhotonSphere sphere;
 	sphere.Center	 = Vector3f(0, 0, 0);
@@ -60,6 +61,59 @@ PR_TEST("Search")
 	map.estimateSphere(sphere, emptyAccum, found);
 	PR_CHECK_EQ(found, 0ULL);
 }
+PR_TEST("Search Small Table")
+{
+	constexpr size_t POINTS = 1000;
+
+	// Tiny table to enforce hash collisions between cells
+	SortedHashGrid<Vector3f> grid(BoundingBox(2, 2, 2), 0.1f, 4);
+
+	std::vector<Vector3f> points;
+	Random random(42);
+	for (size_t k = 0; k < POINTS; ++k) {
+		points.emplace_back(random.getFloat() * 2 - 1, random.getFloat() * 2 - 1, random.getFloat() * 2 - 1);
+		grid.store(points.back());
+	}
+	grid.build();
+
+	PR_CHECK_EQ(grid.storedElements(), POINTS);
+
+	for (int k = 0; k < 10; ++k) {
+		const Vector3f center(random.getFloat() * 2 - 1, random.getFloat() * 2 - 1, random.getFloat() * 2 - 1);
+
+		for (float radius : { 0.05f, 0.3f }) {
+			const float radius2 = radius * radius;
+
+			size_t expected = 0;
+			for (const auto& p : points)
+				expected += (p - center).squaredNorm() <= radius2 ? 1 : 0;
+
+			size_t found = 0;
+			const auto func = [&](const Vector3f& p) { found += (p - center).squaredNorm() <= radius2 ? 1 : 0; };
+			if (radius < grid.gridDelta())
+				grid.search<true>(center, radius2, func);
+			else
+				grid.search<false>(center, radius2, func);
+
+			PR_CHECK_EQ(found, expected);
+		}
+	}
+}
+PR_TEST("Rebuild After Reset")
+{
+	SortedHashGrid<Vector3f> grid(BoundingBox(2, 2, 2), 0.1f);
+
+	for (int round = 0; round < 2; ++round) {
+		grid.reset();
+		grid.store(Vector3f(0.5f, 0.5f, 0.5f));
+		grid.store(Vector3f(-0.5f, 0.5f, 0.5f));
+		grid.build();
+
+		size_t found = 0;
+		grid.search<true>(Vector3f(0.5f, 0.5f, 0.5f), 0.01f, [&](const Vector3f&) { ++found; });
+		PR_CHECK_EQ(found, 1);
+	}
+}
 PR_END_TESTCASE()
 
 // MAIN
@@ -57,6 +57,32 @@ PR_TEST("Unsorted")
 
 	PR_CHECK_TRUE(sorted);
 }
+
+PR_TEST("Unsorted 64bit")
+{
+	constexpr size_t SIZE = 1000;
+	std::vector<uint64> data(SIZE);
+	for (size_t i = 0; i < SIZE; ++i) {
+		data[i] = (uint64(rand()) << 32) | uint64(rand());
+	}
+
+	radixSort(
+		data.data(),
+		[&](size_t a, size_t b) {
+			std::swap(data[a], data[b]);
+		},
+		0, SIZE - 1, uint64(1) << 63);
+
+	bool sorted = true;
+	for (size_t i = 0; i < SIZE - 1; ++i) {
+		if (data[i] > data[i + 1]) {
+			sorted = false;
+			break;
+		}
+	}
+
+	PR_CHECK_TRUE(sorted);
+}
 PR_END_TESTCASE()
 
 // MAIN
@@ -18,6 +18,10 @@ struct Connection {
 	BufferedNetworkSerializer Out;
 	std::vector<float> ImageBuffer;
 
+	// Local copy of the remote image, only updated by changed tiles
+	std::vector<float> MirrorBuffer;
+	uint64 MirrorStamp = 0;
+
 	~Connection() { disconnect(); }
 	inline void connect(const std::string& ip, uint16 port)
 	{
@@ -34,6 +38,8 @@ struct Connection {
 			} else {
 				In.setSocket(Socket, true);
 				Out.setSocket(Socket, false);
+				MirrorBuffer.clear();
+				MirrorStamp = 0;
 			}
 		}
 	}
@@ -327,6 +333,69 @@ void handle_save(const Arguments& args)
 	notifyDisonnection();
 }
 
+void handle_sync(const Arguments& args)
+{
+	if (!ensureConnection())
+		return;
+
+	ProtocolImageUpdateRequest request;
+	request.Stamp	 = sConnection.MirrorStamp;
+	request.Encoding = ProtocolImageEncoding::Float32;
+	if (args.size() > 1) {
+		if (args[1] == "half")
+			request.Encoding = ProtocolImageEncoding::Float16;
+		else if (args[1] == "quantized")
+			request.Encoding = ProtocolImageEncoding::Quantized16;
+		else if (args[1] != "float") {
+			std::cout << "Usage: [float|half|quantized] [Filename]" << std::endl;
+			return;
+		}
+	}
+
+	Protocol::writeHeader(sConnection.Out, ProtocolType::ImageUpdateRequest);
+	Protocol::writeImageUpdateRequest(sConnection.Out, request);
+	sConnection.Out.flush();
+
+	ProtocolType type;
+	if (!Protocol::readHeader(sConnection.In, type)) {
+		std::cout << "Could not get protocol header" << std::endl;
+	} else if (type == ProtocolType::ImageUpdateResponse) {
+		ProtocolImageUpdate update;
+		if (!Protocol::readImageUpdateHeader(sConnection.In, update)) {
+			std::cout << "Could not get image update header" << std::endl;
+		} else {
+			// Tiles never changed are zero
+			size_t requestedSize = (size_t)update.Width * update.Height * 3;
+			if (sConnection.MirrorBuffer.size() != requestedSize)
+				sConnection.MirrorBuffer.assign(requestedSize, 0.0f);
+
+			bool good = true;
+			for (uint32 i = 0; i < update.TileCount && good; ++i)
+				good = Protocol::readImageTile(sConnection.In, update, sConnection.MirrorBuffer.data(), sConnection.MirrorBuffer.size());
+
+			if (!good) {
+				// Stream is out of sync, start from scratch
+				std::cout << "Could not get image tile" << std::endl;
+				sConnection.disconnect();
+			} else {
+				sConnection.MirrorStamp = update.Stamp;
+				std::cout << "Updated " << update.TileCount << " tiles" << std::endl;
+
+				std::string filename = "image.exr";
+				if (args.size() > 2)
+					filename = args[2];
+
+				if (write_output(filename, sConnection.MirrorBuffer, update.Width, update.Height))
+					std::cout << "Save image to file " << filename << std::endl;
+				else
+					std::cout << "Could not save image to file " << filename << std::endl;
+			}
+		}
+	} else
+		std::cout << "Got unexpected response " << (uint8)type << std::endl;
+	notifyDisonnection();
+}
+
 void handle_quit(const Arguments&)
 {
 	sQuit = true;
@@ -347,6 +416,7 @@ struct {
 	{ "stop", "Request current session to stop", handle_stop },
 	{ "status", "Request status information about current session", handle_status },
 	{ "save", "Request image from current session and save it to disk", handle_save },
+	{ "sync", "Request only changed tiles from current session and save the updated image to disk", handle_sync },
 	{ "quit", "Exit program", handle_quit },
 	{ "exit", "Exit program", handle_quit },
 	{ nullptr, nullptr, nullptr }
@@ -1,7 +1,7 @@
 #pragma once
 
 #include "PathVertex.h"
-#include "container/HashGrid.h"
+#include "container/SortedHashGrid.h"
 
 namespace PR {
 namespace VCM {
@@ -26,7 +26,7 @@ struct QuerySphere // Setup for the estimation query
 };
 
 // Spatial Hashmap
-class PathVertexMap : public HashGrid<size_t, vcm_position_getter> {
+class PathVertexMap : public SortedHashGrid<size_t, vcm_position_getter> {
 	PR_CLASS_NON_COPYABLE(PathVertexMap);
 
 public:
@@ -2,7 +2,7 @@
 namespace PR {
 namespace VCM {
 PathVertexMap::PathVertexMap(const BoundingBox& bbox, float gridDelta, const std::vector<PathVertex>& vertices)
-	: HashGrid(bbox, gridDelta, vcm_position_getter<size_t>{ vertices })
+	: SortedHashGrid(bbox, gridDelta, vcm_position_getter<size_t>{ vertices })
 	, mVertices(vertices)
 {
 }
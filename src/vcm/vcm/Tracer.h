@@ -16,6 +16,8 @@
 #include "Logger.h"
 
 #include <numeric>
+#include <tbb/parallel_for.h>
+#include <tbb/parallel_sort.h>
 
 namespace PR {
 namespace VCM {
@@ -225,9 +227,19 @@ public:
 			mLightMap = std::make_unique<PathVertexMap>(bbox, sceneGatherRadius, mLightVertices);
 		mMutex.unlock();
 
+		// Gather all stored vertices of each light path in batches
 		const size_t amount = mLightPathCounter;
-		for (size_t i = 0; i < amount; ++i) // This can be parallelized
-			mLightMap->storeUnsafe(i);
+		tbb::parallel_for(tbb::blocked_range<size_t>(0, amount),
+						  [&](const tbb::blocked_range<size_t>& r) {
+							  std::vector<size_t> ids;
+							  ids.reserve(r.size() * mLightPathSlice);
+							  for (size_t path = r.begin(); path != r.end(); ++path) {
+								  for (size_t k = 0; k < mLightPathSize[path]; ++k)
+									  ids.push_back(path * mLightPathSlice + k);
+							  }
+							  mLightMap->storeUnsafe(ids.begin(), ids.end());
+						  });
+		mLightMap->build();
 	}
 
 	inline void setupWavelengthSelector()
@@ -237,12 +249,12 @@ public:
 		std::iota(mLightPathWavelengthSortMap.begin(), end, 0);
 
 		// Sort based on the hero wavelength
-		std::sort(mLightPathWavelengthSortMap.begin(), end,
-				  [this](size_t a, size_t b) {
-					  const PathVertex* v1 = lightVertex(a, 0);
-					  const PathVertex* v2 = lightVertex(b, 0);
-					  return v1->IP.Ray.WavelengthNM[0] < v2->IP.Ray.WavelengthNM[0];
-				  });
+		tbb::parallel_sort(mLightPathWavelengthSortMap.begin(), end,
+						   [this](size_t a, size_t b) {
+							   const PathVertex* v1 = lightVertex(a, 0);
+							   const PathVertex* v2 = lightVertex(b, 0);
+							   return v1->IP.Ray.WavelengthNM[0] < v2->IP.Ray.WavelengthNM[0];
+						   });
 	}
 
 	inline uint32 pickClosestLightPath(float wvl) const
@@ -373,8 +385,8 @@ private:
 	{
 		PR_ASSERT(entity, "Expected valid entity");
 
-		tctx.Session.tile()->statistics().add(RenderStatisticEntry::EntityHitCount);
-		tctx.Session.tile()->statistics().add(RenderStatisticEntry::LightDepthCount);
+		tctx.Session.tile()->localStatistics().add(RenderStatisticEntry::EntityHitCount);
+		tctx.Session.tile()->localStatistics().add(RenderStatisticEntry::LightDepthCount);
 
 		const uint32 pathLength = ip.Ray.IterationDepth + 1;
 
@@ -424,8 +436,8 @@ private:
 	{
 		PR_ASSERT(entity, "Expected valid entity");
 
-		tctx.Session.tile()->statistics().add(RenderStatisticEntry::EntityHitCount);
-		tctx.Session.tile()->statistics().add(RenderStatisticEntry::CameraDepthCount);
+		tctx.Session.tile()->localStatistics().add(RenderStatisticEntry::EntityHitCount);
+		tctx.Session.tile()->localStatistics().add(RenderStatisticEntry::CameraDepthCount);
 
 		// Update the MIS quantities before computing the vertex.
 		current.MIS_VCM *= mis_term<Mode>(ip.Depth2);
@@ -587,11 +599,10 @@ private:
 		const float distance = light->isInfinite() ? PR_INF : std::sqrt(sqrD);
 		const Ray shadow	 = cameraIP.nextRay(L, RayFlag::Shadow, SHADOW_RAY_MIN, distance);
 
-		const bool isVisible	  = front2front && !tctx.Session.traceShadowRay(shadow, distance);
 		const SpectralBlob lightW = lsout.Radiance;
 
 		// Calculate contribution
-		const SpectralBlob contrib = isVisible ? (lightW * cameraW / (lsample.second * directPdfS)).eval() : SpectralBlob::Zero();
+		const SpectralBlob contrib = front2front ? (lightW * cameraW / (lsample.second * directPdfS)).eval() : SpectralBlob::Zero();
 
 		// Construct LPE path
 		tctx.ThreadContext.TmpPath.reset();
@@ -601,16 +612,20 @@ private:
 		tctx.ThreadContext.TmpPath.addToken(cameraScatteringType);
 
 		if (light->isInfinite()) {
-			tctx.Session.tile()->statistics().add(RenderStatisticEntry::BackgroundHitCount);
+			tctx.Session.tile()->localStatistics().add(RenderStatisticEntry::BackgroundHitCount);
 			tctx.ThreadContext.TmpPath.addToken(LightPathToken::Background());
 		} else {
-			tctx.Session.tile()->statistics().add(RenderStatisticEntry::EntityHitCount);
+			tctx.Session.tile()->localStatistics().add(RenderStatisticEntry::EntityHitCount);
 			tctx.ThreadContext.TmpPath.addToken(LightPathToken::Emissive());
 		}
 
-		// Splat
-		tctx.Session.pushSpectralFragment(SpectralBlob(mis), current.Throughput, contrib,
-										  cameraIP.Ray, tctx.ThreadContext.TmpPath);
+		// Splat (visibility is resolved later in batches)
+		if (front2front)
+			tctx.Session.pushDeferredSpectralFragment(SpectralBlob(mis), current.Throughput, contrib,
+													  shadow, tctx.ThreadContext.TmpPath, distance);
+		else
+			tctx.Session.pushSpectralFragment(SpectralBlob(mis), current.Throughput, contrib,
+											  cameraIP.Ray, tctx.ThreadContext.TmpPath);
 	}
 
 	void handleConnection(IterationContext& tctx,
@@ -694,11 +709,8 @@ private:
 		// Construct ray
 		const Ray shadow = cameraIP.nextRay(cD, RayFlag::Shadow, SHADOW_RAY_MIN, dist);
 
-		// Extract visible and geometry term
-		const bool isVisible = worthACheck && !tctx.Session.traceShadowRay(shadow, dist);
-
 		// Extract terms
-		const SpectralBlob contrib = isVisible ? (connectionW * Geometry).eval() : SpectralBlob::Zero();
+		const SpectralBlob contrib = worthACheck ? (connectionW * Geometry).eval() : SpectralBlob::Zero();
 
 		// Construct LPE path
 		tctx.ThreadContext.TmpPath.reset();
@@ -710,8 +722,11 @@ private:
 		for (size_t s2 = 0; s2 < lightPathLength; ++s2)
 			tctx.ThreadContext.TmpPath.addToken(tctx.ThreadContext.LightPath.token(lightPathLength - 1 - s2));
 
-		// Splat
-		tctx.Session.pushSpectralFragment(SpectralBlob(mis), current.Throughput, contrib, cameraIP.Ray, tctx.ThreadContext.TmpPath);
+		// Splat (visibility is resolved later in batches)
+		if (worthACheck)
+			tctx.Session.pushDeferredSpectralFragment(SpectralBlob(mis), current.Throughput, contrib, shadow, tctx.ThreadContext.TmpPath, dist);
+		else
+			tctx.Session.pushSpectralFragment(SpectralBlob(mis), current.Throughput, contrib, cameraIP.Ray, tctx.ThreadContext.TmpPath);
 	}
 
 	void handleMerging(IterationContext& tctx, const IntersectionPoint& cameraIP, const IMaterial* cameraMaterial, CameraTraversalContext& current) const
@@ -833,7 +848,7 @@ private:
 	void handleInfLights(const IterationContext& tctx, CameraTraversalContext& current, const Ray& ray) const
 	{
 		const uint32 cameraPathLength = ray.IterationDepth + 1;
-		tctx.Session.tile()->statistics().add(RenderStatisticEntry::BackgroundHitCount);
+		tctx.Session.tile()->localStatistics().add(RenderStatisticEntry::BackgroundHitCount);
 
 		// Evaluate radiance
 		float misDenom		  = 0;
@@ -2,7 +2,7 @@
 
 #include "Options.h"
 #include "PathVertexMap.h"
-#include "container/HashGrid.h"
+#include "container/SortedHashGrid.h"
 #include "path/LightPath.h"
 
 namespace PR {